@@ -1,5 +1,7 @@
 #include "Atmosphere.h"
+#include <algorithm>
 #include <cmath>
+#include <FastMath.h>
 
 Atmosphere::Atmosphere(double seaLevelPressure, double seaLevelTemp, double lapseRate, double molarMassAir)
     : seaLevelPressure(seaLevelPressure),
@@ -9,39 +11,99 @@ Atmosphere::Atmosphere(double seaLevelPressure, double seaLevelTemp, double laps
 
 double Atmosphere::GetTemperature(double altitudeMeters) const
 {
-    return seaLevelTemp - lapseRate * altitudeMeters;
+    return GetTemperatureAs<double>(altitudeMeters);
 }
 
 double Atmosphere::GetPressure(double altitudeMeters) const
+{
+    return GetPressureAs<double>(altitudeMeters);
+}
+
+double Atmosphere::GetDensity(double altitudeMeters) const
+{
+    return GetDensityAs<double>(altitudeMeters);
+}
+
+template <typename Real>
+Real Atmosphere::GetTemperatureAs(Real altitudeMeters) const
+{
+    // Lapse rate applies up to the tropopause, isothermal above (matches the
+    // exponential pressure branch and keeps density finite past T = 0)
+    return Real(seaLevelTemp) - Real(lapseRate) * std::min(altitudeMeters, Real(tropopauseAltitude));
+}
+
+template <typename Real>
+Real Atmosphere::GetPressureAs(Real altitudeMeters) const
 {
     // Constants
-    constexpr double g = 9.80665;     // m/s²
-    constexpr double R = gasConstant; // J/mol·K
+    constexpr Real g = Real(9.80665);     // m/s²
+    constexpr Real R = Real(gasConstant); // J/mol·K
 
-    if (altitudeMeters <= 11000.0)
+    if (altitudeMeters <= Real(tropopauseAltitude))
     {
         // Troposphere model with lapse rate
-        double T = GetTemperature(altitudeMeters);
-        double exponent = (g * molarMassAir) / (R * lapseRate);
-        return seaLevelPressure * std::pow(T / seaLevelTemp, exponent);
+        Real T = GetTemperatureAs<Real>(altitudeMeters);
+        Real exponent = (g * Real(molarMassAir)) / (R * Real(lapseRate));
+        return Real(seaLevelPressure) * FastMath::Pow(T / Real(seaLevelTemp), exponent);
     }
     else
     {
         // Exponential falloff above 11 km
-        constexpr double scaleHeight = 7000.0; // Approximate for Earth
-        return seaLevelPressure * std::exp(-altitudeMeters / scaleHeight);
+        constexpr Real scaleHeight = Real(7000.0); // Approximate for Earth
+        return Real(seaLevelPressure) * FastMath::Exp(-altitudeMeters / scaleHeight);
     }
 }
 
-double Atmosphere::GetDensity(double altitudeMeters) const
+template <typename Real>
+Real Atmosphere::GetDensityAs(Real altitudeMeters) const
 {
-    double pressure = GetPressure(altitudeMeters);
-    double temperature = GetTemperature(altitudeMeters);
-    if (temperature <= 0.0)
-        return 0.0;
-    return (pressure * molarMassAir) / (gasConstant * temperature);
+    Real pressure = GetPressureAs<Real>(altitudeMeters);
+    Real temperature = GetTemperatureAs<Real>(altitudeMeters);
+    if (temperature <= Real(0))
+        return Real(0);
+    return (pressure * Real(molarMassAir)) / (Real(gasConstant) * temperature);
 }
 
+template <typename Real>
+void Atmosphere::GetDensitiesAs(const Real *altitudesMeters, Real *densities, size_t count) const
+{
+    if (!FastMath::IsFast())
+    {
+        for (size_t i = 0; i < count; ++i)
+            densities[i] = GetDensityAs<Real>(altitudesMeters[i]);
+        return;
+    }
+
+    // Same model as GetPressureAs and GetDensityAs, hoisted and branch-free
+    constexpr Real g = Real(9.80665);
+    constexpr Real R = Real(gasConstant);
+    constexpr Real scaleHeight = Real(7000.0);
+    const Real exponent = (g * Real(molarMassAir)) / (R * Real(lapseRate));
+    const Real p0 = Real(seaLevelPressure);
+    const Real t0 = Real(seaLevelTemp);
+    const Real molarMass = Real(molarMassAir);
+
+#pragma omp simd
+    for (size_t i = 0; i < count; ++i)
+    {
+        Real h = altitudesMeters[i];
+        Real T = t0 - Real(lapseRate) * std::min(h, Real(tropopauseAltitude));
+        Real troposphere = p0 * FastMath::FastPow(T / t0, exponent);
+        Real upper = p0 * FastMath::FastExp(-h / scaleHeight);
+        Real pressure = h <= Real(tropopauseAltitude) ? troposphere : upper;
+        densities[i] = T > Real(0) ? (pressure * molarMass) / (R * T) : Real(0);
+    }
+}
+
+template float Atmosphere::GetTemperatureAs<float>(float) const;
+template double Atmosphere::GetTemperatureAs<double>(double) const;
+template float Atmosphere::GetPressureAs<float>(float) const;
+template double Atmosphere::GetPressureAs<double>(double) const;
+template float Atmosphere::GetDensityAs<float>(float) const;
+template double Atmosphere::GetDensityAs<double>(double) const;
+template void Atmosphere::GetDensitiesAs<float>(const float *, float *, size_t) const;
+template void Atmosphere::GetDensitiesAs<double>(const double *, double *, size_t) const;
+
 double Atmosphere::ComputeDragForce(double altitudeMeters,
                                     double velocity,
                                     double dragCoefficient,
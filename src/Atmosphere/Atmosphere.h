@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 
 class Atmosphere
 {
@@ -10,6 +11,20 @@ public:
     double GetTemperature(double altitudeMeters) const;
     double GetDensity(double altitudeMeters) const;
 
+    // Same model evaluated in Real (float or double) arithmetic
+    template <typename Real>
+    Real GetPressureAs(Real altitudeMeters) const;
+    template <typename Real>
+    Real GetTemperatureAs(Real altitudeMeters) const;
+    template <typename Real>
+    Real GetDensityAs(Real altitudeMeters) const;
+
+    // Densities for a batch of altitudes (densities may alias altitudes). In
+    // fast math mode both pressure branches are evaluated and selected per
+    // sample so the loop is branch-free and vectorizes.
+    template <typename Real>
+    void GetDensitiesAs(const Real *altitudesMeters, Real *densities, size_t count) const;
+
     double ComputeDragForce(double altitudeMeters,
                             double velocity,
                             double dragCoefficient,
@@ -22,5 +37,6 @@ private:
     double molarMassAir;     // in kg/mol
 
     // Constants
-    static constexpr double gasConstant = 8.3144598; // J/(mol·K)
+    static constexpr double gasConstant = 8.3144598;       // J/(mol·K)
+    static constexpr double tropopauseAltitude = 11000.0; // m
 };
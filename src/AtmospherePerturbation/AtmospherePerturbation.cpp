@@ -0,0 +1,194 @@
+#include "AtmospherePerturbation.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    // Grid cell index and blend weight for one axis, clamped to the edges
+    void Locate(double value, double start, double step, uint32_t count, uint32_t &index, double &weight)
+    {
+        if (count <= 1)
+        {
+            index = 0;
+            weight = 0.0;
+            return;
+        }
+
+        double position = (value - start) / step;
+        // NaN coordinates land on the first cell rather than in a cast
+        position = position >= 0.0 ? std::min(position, double(count - 1)) : 0.0;
+        index = std::min(static_cast<uint32_t>(position), count - 2);
+        weight = position - index;
+    }
+
+    bool ValidAxis(double start, double step)
+    {
+        return std::isfinite(start) && std::isfinite(step) && step > 0.0;
+    }
+}
+
+size_t PerturbationGridHeader::ValueCount() const
+{
+    // Zero when the grid's byte size, header included, doesn't fit in size_t
+    const size_t limit = (std::numeric_limits<size_t>::max() - sizeof(PerturbationGridHeader)) / sizeof(float);
+    const uint32_t factors[] = {profileCount, timeCount, latitudeCount, longitudeCount, altitudeCount,
+                                uint32_t(AtmospherePerturbation::channelCount)};
+    size_t count = 1;
+    for (uint32_t factor : factors)
+    {
+        if (factor == 0)
+            return 0;
+        if (count > limit / factor)
+            return 0;
+        count *= factor;
+    }
+    return count;
+}
+
+bool PerturbationGridHeader::HasValidAxes() const
+{
+    return ValidAxis(altitudeStart, altitudeStep) && ValidAxis(latitudeStart, latitudeStep) &&
+           ValidAxis(longitudeStart, longitudeStep) && ValidAxis(timeStart, timeStep);
+}
+
+AtmospherePerturbation::~AtmospherePerturbation()
+{
+    Close();
+}
+
+bool AtmospherePerturbation::Open(const std::string &path)
+{
+    Close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || size_t(info.st_size) < sizeof(PerturbationGridHeader))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void *map = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps the file alive
+    if (map == MAP_FAILED)
+        return false;
+
+    PerturbationGridHeader fileHeader;
+    std::memcpy(&fileHeader, map, sizeof(fileHeader));
+
+    size_t expected = sizeof(fileHeader) + fileHeader.ValueCount() * sizeof(float);
+    if (std::memcmp(fileHeader.magic, PerturbationGridHeader().magic, sizeof(fileHeader.magic)) != 0 ||
+        fileHeader.ValueCount() == 0 || size_t(info.st_size) < expected || !fileHeader.HasValidAxes())
+    {
+        munmap(map, info.st_size);
+        return false;
+    }
+
+    // Trajectories hop between profiles and time slices; don't read ahead
+    madvise(map, info.st_size, MADV_RANDOM);
+
+    header = fileHeader;
+    mapping = map;
+    mappingSize = info.st_size;
+    values = reinterpret_cast<const float *>(static_cast<const char *>(map) + sizeof(fileHeader));
+    return true;
+}
+
+void AtmospherePerturbation::Close()
+{
+    if (mapping)
+        munmap(mapping, mappingSize);
+    mapping = nullptr;
+    mappingSize = 0;
+    values = nullptr;
+    header = PerturbationGridHeader();
+}
+
+bool AtmospherePerturbation::IsOpen() const
+{
+    return values != nullptr;
+}
+
+PerturbationSample AtmospherePerturbation::Sample(int profile,
+                                                  double altitudeMeters,
+                                                  double latitudeDeg,
+                                                  double longitudeDeg,
+                                                  double timeSeconds) const
+{
+    PerturbationSample sample;
+    if (!values || profile < 0 || uint32_t(profile) >= header.profileCount)
+        return sample;
+
+    uint32_t it, ila, ilo, ia;
+    double wt, wla, wlo, wa;
+    Locate(timeSeconds, header.timeStart, header.timeStep, header.timeCount, it, wt);
+    Locate(latitudeDeg, header.latitudeStart, header.latitudeStep, header.latitudeCount, ila, wla);
+    Locate(longitudeDeg, header.longitudeStart, header.longitudeStep, header.longitudeCount, ilo, wlo);
+    Locate(altitudeMeters, header.altitudeStart, header.altitudeStep, header.altitudeCount, ia, wa);
+
+    const size_t altStride = channelCount;
+    const size_t lonStride = altStride * header.altitudeCount;
+    const size_t latStride = lonStride * header.longitudeCount;
+    const size_t timeStride = latStride * header.latitudeCount;
+    const size_t profileStride = timeStride * header.timeCount;
+    const size_t base = profile * profileStride + it * timeStride + ila * latStride + ilo * lonStride + ia * altStride;
+
+    // Axes with a single point have no upper neighbour
+    const size_t tStep = header.timeCount > 1 ? timeStride : 0;
+    const size_t laStep = header.latitudeCount > 1 ? latStride : 0;
+    const size_t loStep = header.longitudeCount > 1 ? lonStride : 0;
+    const size_t aStep = header.altitudeCount > 1 ? altStride : 0;
+
+    double channels[channelCount] = {0.0, 0.0, 0.0};
+    for (int corner = 0; corner < 16; ++corner)
+    {
+        bool t1 = corner & 8, la1 = corner & 4, lo1 = corner & 2, a1 = corner & 1;
+        double weight = (t1 ? wt : 1.0 - wt) * (la1 ? wla : 1.0 - wla) *
+                        (lo1 ? wlo : 1.0 - wlo) * (a1 ? wa : 1.0 - wa);
+        if (weight == 0.0)
+            continue;
+
+        const float *cell = values + base + (t1 ? tStep : 0) + (la1 ? laStep : 0) +
+                            (lo1 ? loStep : 0) + (a1 ? aStep : 0);
+        for (int c = 0; c < channelCount; ++c)
+            channels[c] += weight * cell[c];
+    }
+
+    sample.windEast = channels[0];
+    sample.windNorth = channels[1];
+    sample.densityFactor = channels[2];
+    return sample;
+}
+
+int AtmospherePerturbation::GetProfileCount() const
+{
+    return static_cast<int>(header.profileCount);
+}
+
+const PerturbationGridHeader &AtmospherePerturbation::GetHeader() const
+{
+    return header;
+}
+
+bool AtmospherePerturbation::WriteFile(const std::string &path,
+                                       const PerturbationGridHeader &header,
+                                       const std::vector<float> &values)
+{
+    if (header.ValueCount() == 0 || values.size() != header.ValueCount() || !header.HasValidAxes())
+        return false;
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(float));
+    return bool(file);
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// On-disk layout: this header followed by float values ordered
+// [profile][time][latitude][longitude][altitude][channel], channels being
+// east wind (m/s), north wind (m/s) and density scale factor. Altitude is
+// innermost so a descending vessel walks contiguous memory.
+struct PerturbationGridHeader
+{
+    char magic[8] = {'P', 'S', 'I', 'M', 'P', 'R', 'T', '1'};
+    uint32_t profileCount = 0;
+    uint32_t altitudeCount = 0;
+    uint32_t latitudeCount = 0;
+    uint32_t longitudeCount = 0;
+    uint32_t timeCount = 0;
+    uint32_t reserved = 0;
+    double altitudeStart = 0.0, altitudeStep = 1.0;   // m
+    double latitudeStart = 0.0, latitudeStep = 1.0;   // deg
+    double longitudeStart = 0.0, longitudeStep = 1.0; // deg
+    double timeStart = 0.0, timeStep = 1.0;           // s
+
+    size_t ValueCount() const; // 0 for an empty grid or one too large to address
+    bool HasValidAxes() const; // finite starts and finite, positive steps
+};
+
+struct PerturbationSample
+{
+    double windEast = 0.0;      // m/s
+    double windNorth = 0.0;     // m/s
+    double densityFactor = 1.0; // multiplies the model density
+};
+
+// Gridded wind/density perturbations memory-mapped from a binary file.
+// Nothing is read up front; the OS faults in only the pages a trajectory
+// actually touches, so multi-GB datasets cost address space, not RAM.
+class AtmospherePerturbation
+{
+public:
+    static constexpr int channelCount = 3;
+
+    AtmospherePerturbation() = default;
+    ~AtmospherePerturbation();
+    AtmospherePerturbation(const AtmospherePerturbation &) = delete;
+    AtmospherePerturbation &operator=(const AtmospherePerturbation &) = delete;
+
+    bool Open(const std::string &path);
+    void Close();
+    bool IsOpen() const;
+
+    // Quadrilinear interpolation; coordinates outside the grid clamp to its edge
+    PerturbationSample Sample(int profile,
+                              double altitudeMeters,
+                              double latitudeDeg,
+                              double longitudeDeg,
+                              double timeSeconds) const;
+
+    int GetProfileCount() const;
+    const PerturbationGridHeader &GetHeader() const;
+
+    // Write a dataset (e.g. from an offline generator); values sized header.ValueCount()
+    static bool WriteFile(const std::string &path,
+                          const PerturbationGridHeader &header,
+                          const std::vector<float> &values);
+
+private:
+    PerturbationGridHeader header;
+    void *mapping = nullptr;
+    size_t mappingSize = 0;
+    const float *values = nullptr;
+};
@@ -0,0 +1,84 @@
+/*
+ * capi_check.c - plain C consumer of physicssim.h, built by `make capi-check`.
+ *
+ * Compiles the header as C99 with warnings as errors and links against the
+ * static library, so anything C++-only leaking into the API breaks the build.
+ */
+#include <math.h>
+#include <stdio.h>
+
+#include "physicssim.h"
+
+static int failures = 0;
+
+static void Expect(int condition, const char *what)
+{
+    printf("%s %s\n", condition ? "ok  " : "FAIL", what);
+    if (!condition)
+        ++failures;
+}
+
+int main(void)
+{
+    ps_atmosphere_params earthAtmo = {101325.0, 288.15, 0.0065, 0.0289644};
+    ps_body *earth = ps_body_create(5.972e24, 6.371e6, &earthAtmo);
+    ps_reentry_scenario scenarios[2];
+    ps_run_summary summaries[2];
+    ps_status status;
+
+    Expect(ps_api_version() == PS_API_VERSION, "api version matches header");
+    Expect(earth != NULL, "body created");
+    if (!earth)
+        return 1;
+
+    ps_reentry_scenario_defaults(&scenarios[0]);
+    scenarios[1] = scenarios[0];
+    scenarios[1].altitude *= 0.5;
+
+    status = ps_run_reentry_batch(earth, scenarios, 2, summaries, NULL, 2);
+    Expect(status == PS_OK, "batch of two reentries runs");
+    Expect(summaries[0].outcome != PS_OUTCOME_IN_FLIGHT && summaries[0].steps > 0, "first reentry finished");
+    Expect(summaries[1].outcome != PS_OUTCOME_IN_FLIGHT && summaries[1].steps > 0, "second reentry finished");
+
+    scenarios[1].max_time = INFINITY;
+    status = ps_run_reentry_batch(earth, scenarios, 2, summaries, NULL, 2);
+    Expect(status == PS_ERROR_INVALID_ARGUMENT, "infinite max_time rejected");
+
+    scenarios[1].max_time = scenarios[0].max_time;
+    scenarios[1].delta_time = NAN;
+    status = ps_run_reentry_batch(earth, scenarios, 2, summaries, NULL, 2);
+    Expect(status == PS_ERROR_INVALID_ARGUMENT, "NaN delta_time rejected");
+
+    {
+        ps_vessel_params params = {100000.0, -7500.0, 5000.0, 0.0, 1.25, 5.0, 0.0, 0.0, 0.0};
+        ps_vessel_params bad = params;
+        ps_vessel *vessel;
+        ps_heat_shield *shield;
+
+        bad.fuel_mass = NAN;
+        Expect(ps_vessel_create(earth, &bad) == NULL, "NaN fuel_mass rejected");
+        bad = params;
+        bad.cross_section_area = -1.0;
+        Expect(ps_vessel_create(earth, &bad) == NULL, "negative cross_section_area rejected");
+        bad = params;
+        bad.drag_coefficient = NAN;
+        Expect(ps_vessel_create(earth, &bad) == NULL, "NaN drag_coefficient rejected");
+
+        vessel = ps_vessel_create(earth, &params);
+        Expect(vessel != NULL, "vessel created");
+        if (vessel)
+        {
+            Expect(ps_vessel_set_throttle(vessel, NAN) == PS_ERROR_INVALID_ARGUMENT, "NaN throttle rejected");
+            Expect(ps_vessel_set_throttle(vessel, 0.5) == PS_OK, "finite throttle accepted");
+
+            shield = ps_heat_shield_create(250.0, 5.0, 2e6, 3000.0);
+            Expect(ps_vessel_attach_heat_shield(vessel, shield) == PS_OK, "heat shield attached");
+            Expect(ps_vessel_attach_heat_shield(vessel, NULL) == PS_OK, "heat shield detached");
+            ps_heat_shield_destroy(shield);
+            ps_vessel_destroy(vessel);
+        }
+    }
+
+    ps_body_destroy(earth);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,435 @@
+#include "physicssim.h"
+#include <Atmosphere.h>
+#include <ComponentPool.h>
+#include <HeatShield.h>
+#include <OrbitalBody.h>
+#include <Parachute.h>
+#include <Scenario.h>
+#include <Vessel.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+struct ps_body
+{
+    std::unique_ptr<Atmosphere> atmosphere;
+    OrbitalBody body;
+};
+
+struct ps_vessel
+{
+    Vessel vessel;
+    ComponentArena components{1, 1};
+    HeatShieldHandle shield;
+    ParachuteHandle parachute;
+};
+
+struct ps_heat_shield
+{
+    HeatShield shield;
+};
+
+struct ps_parachute
+{
+    Parachute parachute;
+};
+
+namespace
+{
+    // Column pointers are shared, not copied: rows land in the caller's arrays
+    TelemetryColumns ToColumns(const ps_telemetry_columns &c)
+    {
+        TelemetryColumns columns;
+        columns.time = c.time;
+        columns.altitude = c.altitude;
+        columns.velocity = c.velocity;
+        columns.airDensity = c.air_density;
+        columns.heatRate = c.heat_rate;
+        columns.surfaceTemperature = c.surface_temperature;
+        columns.shieldMass = c.shield_mass;
+        columns.capacity = c.capacity;
+        columns.interval = c.interval;
+        return columns;
+    }
+
+    ps_outcome ToOutcome(ScenarioOutcome outcome)
+    {
+        switch (outcome)
+        {
+        case ScenarioOutcome::LandedSafely:
+            return PS_OUTCOME_LANDED_SAFELY;
+        case ScenarioOutcome::Crashed:
+            return PS_OUTCOME_CRASHED;
+        case ScenarioOutcome::BurnedUp:
+            return PS_OUTCOME_BURNED_UP;
+        case ScenarioOutcome::InFlight:
+            break;
+        }
+        return PS_OUTCOME_IN_FLIGHT;
+    }
+
+    void ToSummary(const ScenarioResult &result, ps_run_summary &summary)
+    {
+        summary.outcome = ToOutcome(result.outcome);
+        summary.reserved = 0;
+        summary.flight_time = result.flightTime;
+        summary.impact_speed = result.impactSpeed;
+        summary.max_altitude = result.maxAltitude;
+        summary.peak_heat_rate = result.peakHeatRate;
+        summary.peak_deceleration = result.peakDeceleration;
+        summary.shield_remaining = result.shieldRemainingKg;
+        summary.steps = result.steps;
+    }
+
+    ReentryScenario ToScenario(const ps_reentry_scenario &s)
+    {
+        ReentryScenario scenario;
+        scenario.altitude = s.altitude;
+        scenario.velocity = s.velocity;
+        scenario.dryMassKg = s.dry_mass;
+        scenario.dragCoefficient = s.drag_coefficient;
+        scenario.crossSectionArea = s.cross_section_area;
+        scenario.shieldMassKg = s.shield_mass;
+        scenario.shieldArea = s.shield_area;
+        scenario.ablationEnergy = s.ablation_energy;
+        scenario.chuteArea = s.chute_area;
+        scenario.chuteDragCoefficient = s.chute_drag_coefficient;
+        scenario.chuteDeployAltitude = s.chute_deploy_altitude;
+        scenario.chuteMaxMassKg = s.chute_max_mass;
+        scenario.deltaTime = s.delta_time;
+        scenario.maxTime = s.max_time;
+        return scenario;
+    }
+
+    ps_status RunStatus(const ps_telemetry_columns *telemetry)
+    {
+        return (telemetry && telemetry->dropped > 0) ? PS_TELEMETRY_TRUNCATED : PS_OK;
+    }
+
+    // Rejects NaN and infinities as well as non-positive steps
+    bool ValidTimes(double deltaTime, double maxTime)
+    {
+        return std::isfinite(deltaTime) && deltaTime > 0.0 && std::isfinite(maxTime) && maxTime >= 0.0;
+    }
+
+    // Same for the vessel's mass and aerodynamics; NaN fails every comparison
+    bool ValidVesselParams(const ps_vessel_params &p)
+    {
+        return std::isfinite(p.dry_mass) && p.dry_mass > 0.0 &&
+               std::isfinite(p.fuel_mass) && p.fuel_mass >= 0.0 &&
+               std::isfinite(p.drag_coefficient) && p.drag_coefficient >= 0.0 &&
+               std::isfinite(p.cross_section_area) && p.cross_section_area >= 0.0;
+    }
+
+    // No exception may unwind into a C caller
+    template <typename Function>
+    ps_status Guarded(Function function)
+    {
+        try
+        {
+            return function();
+        }
+        catch (...)
+        {
+            return PS_ERROR_INTERNAL;
+        }
+    }
+
+    template <typename Function>
+    auto GuardedCreate(Function function) -> decltype(function())
+    {
+        try
+        {
+            return function();
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+}
+
+extern "C"
+{
+    int ps_api_version(void)
+    {
+        return PS_API_VERSION;
+    }
+
+    void ps_reentry_scenario_defaults(ps_reentry_scenario *scenario)
+    {
+        if (!scenario)
+            return;
+
+        ReentryScenario d;
+        *scenario = {d.altitude, d.velocity, d.dryMassKg, d.dragCoefficient, d.crossSectionArea,
+                     d.shieldMassKg, d.shieldArea, d.ablationEnergy, d.chuteArea, d.chuteDragCoefficient,
+                     d.chuteDeployAltitude, d.chuteMaxMassKg, d.deltaTime, d.maxTime};
+    }
+
+    // ==============================
+    // Lifetimes
+    // ==============================
+    ps_body *ps_body_create(double mass, double radius, const ps_atmosphere_params *atmosphere)
+    {
+        if (mass <= 0.0 || radius <= 0.0)
+            return nullptr;
+
+        return GuardedCreate([&]()
+                             {
+                                 std::unique_ptr<Atmosphere> atm;
+                                 if (atmosphere)
+                                     atm = std::make_unique<Atmosphere>(atmosphere->sea_level_pressure,
+                                                                        atmosphere->sea_level_temperature,
+                                                                        atmosphere->lapse_rate,
+                                                                        atmosphere->molar_mass);
+                                 Atmosphere *raw = atm.get();
+                                 return new ps_body{std::move(atm), OrbitalBody(mass, radius, raw)}; });
+    }
+
+    void ps_body_destroy(ps_body *body)
+    {
+        delete body;
+    }
+
+    ps_heat_shield *ps_heat_shield_create(double mass, double area, double ablation_energy, double max_temperature)
+    {
+        if (mass < 0.0 || area <= 0.0 || ablation_energy <= 0.0)
+            return nullptr;
+        return GuardedCreate([&]()
+                             { return new ps_heat_shield{HeatShield(mass, area, ablation_energy, max_temperature)}; });
+    }
+
+    void ps_heat_shield_destroy(ps_heat_shield *shield)
+    {
+        delete shield;
+    }
+
+    ps_parachute *ps_parachute_create(double area, double drag_coefficient, double deploy_altitude, double max_supported_mass)
+    {
+        if (area <= 0.0)
+            return nullptr;
+        return GuardedCreate([&]()
+                             { return new ps_parachute{Parachute(area, drag_coefficient, deploy_altitude, max_supported_mass)}; });
+    }
+
+    void ps_parachute_destroy(ps_parachute *parachute)
+    {
+        delete parachute;
+    }
+
+    ps_vessel *ps_vessel_create(ps_body *body, const ps_vessel_params *p)
+    {
+        if (!body || !p || !ValidVesselParams(*p))
+            return nullptr;
+
+        // ThrustModel divides by vacuum Isp; an unpowered vessel still needs a finite one
+        double ispVacuum = p->isp_vacuum > 0.0 ? p->isp_vacuum : 1.0;
+        ThrustModel engine(p->max_thrust, ispVacuum, p->isp_sea_level);
+        return GuardedCreate([&]()
+                             { return new ps_vessel{Vessel(p->altitude, p->velocity, p->dry_mass, p->fuel_mass,
+                                                           p->drag_coefficient, p->cross_section_area,
+                                                           &body->body, engine)}; });
+    }
+
+    void ps_vessel_destroy(ps_vessel *vessel)
+    {
+        delete vessel;
+    }
+
+    // ==============================
+    // Configuration
+    // ==============================
+    ps_status ps_vessel_attach_heat_shield(ps_vessel *vessel, ps_heat_shield *shield)
+    {
+        if (!vessel)
+            return PS_ERROR_INVALID_ARGUMENT;
+        return Guarded([&]()
+                       {
+                           // The old shield stays attached if the vessel refuses the new one
+                           HeatShieldHandle copy = shield ? vessel->components.CreateHeatShield(shield->shield) : HeatShieldHandle();
+                           if (!vessel->vessel.AttachHeatShield(vessel->components, copy))
+                           {
+                               vessel->components.Release(copy);
+                               return PS_ERROR_INVALID_ARGUMENT;
+                           }
+                           vessel->components.Release(vessel->shield);
+                           vessel->shield = copy;
+                           return PS_OK; });
+    }
+
+    ps_status ps_vessel_attach_parachute(ps_vessel *vessel, ps_parachute *parachute)
+    {
+        if (!vessel)
+            return PS_ERROR_INVALID_ARGUMENT;
+        return Guarded([&]()
+                       {
+                           ParachuteHandle copy = parachute ? vessel->components.CreateParachute(parachute->parachute) : ParachuteHandle();
+                           if (!vessel->vessel.AttachParachute(vessel->components, copy))
+                           {
+                               vessel->components.Release(copy);
+                               return PS_ERROR_INVALID_ARGUMENT;
+                           }
+                           vessel->components.Release(vessel->parachute);
+                           vessel->parachute = copy;
+                           return PS_OK; });
+    }
+
+    ps_status ps_vessel_set_throttle(ps_vessel *vessel, double throttle)
+    {
+        if (!vessel || !std::isfinite(throttle))
+            return PS_ERROR_INVALID_ARGUMENT;
+        vessel->vessel.SetThrottle(throttle);
+        return PS_OK;
+    }
+
+    ps_status ps_vessel_set_orientation(ps_vessel *vessel, double x, double y, double z)
+    {
+        if (!vessel)
+            return PS_ERROR_INVALID_ARGUMENT;
+        vessel->vessel.SetOrientationVector(Vector3(x, y, z));
+        return PS_OK;
+    }
+
+    // ==============================
+    // Stepping
+    // ==============================
+    ps_status ps_vessel_step(ps_vessel *vessel, double delta_time, size_t steps)
+    {
+        if (!vessel || !std::isfinite(delta_time) || delta_time <= 0.0)
+            return PS_ERROR_INVALID_ARGUMENT;
+        return Guarded([&]()
+                       {
+                           for (size_t i = 0; i < steps; ++i)
+                               vessel->vessel.Update(delta_time);
+                           return PS_OK; });
+    }
+
+    ps_status ps_vessel_get_state(const ps_vessel *vessel, ps_vessel_state *state)
+    {
+        if (!vessel || !state)
+            return PS_ERROR_INVALID_ARGUMENT;
+
+        const Vessel &v = vessel->vessel;
+        state->mission_time = v.GetMissionTime();
+        state->altitude = v.GetAltitude();
+        state->velocity = v.GetVelocity();
+        state->mass = v.GetMass();
+        state->fuel_mass = v.GetFuelMass();
+        state->air_density = v.GetLastAirDensity();
+        state->heat_rate = v.GetHeatRate();
+        state->total_heat_load = v.GetTotalHeatLoad();
+        state->surface_temperature = v.GetSurfaceTemperature();
+        state->heat_shield_mass = v.GetHeatShieldMass();
+        state->parachute_deployed = v.IsParachuteDeployed() ? 1 : 0;
+        state->outcome = v.HasBurnedUp()       ? PS_OUTCOME_BURNED_UP
+                         : v.HasCrashed()      ? PS_OUTCOME_CRASHED
+                         : v.HasLandedSafely() ? PS_OUTCOME_LANDED_SAFELY
+                                               : PS_OUTCOME_IN_FLIGHT;
+        return PS_OK;
+    }
+
+    ps_status ps_vessel_run(ps_vessel *vessel, double delta_time, double max_time,
+                            ps_telemetry_columns *telemetry, ps_run_summary *summary)
+    {
+        if (!vessel || !ValidTimes(delta_time, max_time))
+            return PS_ERROR_INVALID_ARGUMENT;
+
+        return Guarded([&]()
+                       {
+                           TelemetryColumns columns;
+                           if (telemetry)
+                               columns = ToColumns(*telemetry);
+
+                           ScenarioResult result = RunVessel(vessel->vessel, delta_time, max_time,
+                                                             telemetry ? &columns : nullptr);
+
+                           if (telemetry)
+                           {
+                               telemetry->count = columns.count;
+                               telemetry->dropped = columns.dropped;
+                           }
+                           if (summary)
+                               ToSummary(result, *summary);
+                           return RunStatus(telemetry); });
+    }
+
+    ps_status ps_run_reentry_batch(ps_body *body, const ps_reentry_scenario *scenarios, size_t count,
+                                   ps_run_summary *summaries, ps_telemetry_columns *telemetry,
+                                   int thread_count)
+    {
+        if (!body || (count > 0 && (!scenarios || !summaries)))
+            return PS_ERROR_INVALID_ARGUMENT;
+        for (size_t i = 0; i < count; ++i)
+            if (!ValidTimes(scenarios[i].delta_time, scenarios[i].max_time))
+                return PS_ERROR_INVALID_ARGUMENT;
+
+        std::atomic<size_t> next(0);
+        std::atomic<bool> truncated(false);
+        std::atomic<bool> failed(false);
+
+        auto runEntries = [&]()
+        {
+            for (size_t i = next++; i < count; i = next++)
+            {
+                TelemetryColumns columns;
+                if (telemetry)
+                    columns = ToColumns(telemetry[i]);
+
+                ScenarioResult result = RunReentryScenario(&body->body, ToScenario(scenarios[i]),
+                                                           telemetry ? &columns : nullptr);
+                ToSummary(result, summaries[i]);
+
+                if (telemetry)
+                {
+                    telemetry[i].count = columns.count;
+                    telemetry[i].dropped = columns.dropped;
+                    if (columns.dropped > 0)
+                        truncated = true;
+                }
+            }
+        };
+
+        // An exception leaving a std::thread terminates the host: record it
+        // and stop handing out work instead
+        auto worker = [&]()
+        {
+            try
+            {
+                runEntries();
+            }
+            catch (...)
+            {
+                failed = true;
+                next = count;
+            }
+        };
+
+        int threads = thread_count > 0 ? thread_count
+                                       : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        threads = static_cast<int>(std::min<size_t>(threads, std::max<size_t>(count, 1)));
+
+        // Fewer threads than asked for is fine; the calling thread always works
+        std::vector<std::thread> pool;
+        try
+        {
+            pool.reserve(threads - 1);
+            for (int t = 1; t < threads; ++t)
+                pool.emplace_back(worker);
+        }
+        catch (...)
+        {
+        }
+        worker();
+        for (std::thread &thread : pool)
+            thread.join();
+
+        if (failed)
+            return PS_ERROR_INTERNAL;
+        return truncated ? PS_TELEMETRY_TRUNCATED : PS_OK;
+    }
+}
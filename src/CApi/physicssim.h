@@ -0,0 +1,180 @@
+/*
+ * physicssim.h - stable C API for embedding the simulator in-process.
+ *
+ * Handles are opaque. Bodies must outlive the vessels created on them.
+ * Attaching a heat shield or parachute copies it into the vessel, so the
+ * component handle may be destroyed (or reused) right after attaching.
+ * Telemetry is written straight into caller-owned column arrays.
+ * No C++ exception crosses this API: failures to allocate or to start
+ * threads come back as PS_ERROR_INTERNAL, or NULL from the create calls.
+ */
+#ifndef PHYSICSSIM_H
+#define PHYSICSSIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define PS_API_VERSION 1
+
+    typedef enum ps_status
+    {
+        PS_OK = 0,
+        PS_TELEMETRY_TRUNCATED = 1, /* run finished, some rows did not fit */
+        PS_ERROR_INVALID_ARGUMENT = -1,
+        PS_ERROR_INTERNAL = -2 /* out of memory or threads; outputs unspecified */
+    } ps_status;
+
+    typedef enum ps_outcome
+    {
+        PS_OUTCOME_IN_FLIGHT = 0,
+        PS_OUTCOME_LANDED_SAFELY = 1,
+        PS_OUTCOME_CRASHED = 2,
+        PS_OUTCOME_BURNED_UP = 3
+    } ps_outcome;
+
+    typedef struct ps_body ps_body;
+    typedef struct ps_vessel ps_vessel;
+    typedef struct ps_heat_shield ps_heat_shield;
+    typedef struct ps_parachute ps_parachute;
+
+    typedef struct ps_atmosphere_params
+    {
+        double sea_level_pressure; /* Pa */
+        double sea_level_temperature; /* K */
+        double lapse_rate;         /* K/m */
+        double molar_mass;         /* kg/mol */
+    } ps_atmosphere_params;
+
+    typedef struct ps_vessel_params
+    {
+        double altitude; /* m */
+        double velocity; /* m/s, positive up */
+        double dry_mass; /* kg */
+        double fuel_mass; /* kg */
+        double drag_coefficient;
+        double cross_section_area; /* m² */
+        double max_thrust;         /* N, 0 for an unpowered vessel */
+        double isp_vacuum;         /* s */
+        double isp_sea_level;      /* s */
+    } ps_vessel_params;
+
+    typedef struct ps_vessel_state
+    {
+        double mission_time;
+        double altitude;
+        double velocity;
+        double mass;
+        double fuel_mass;
+        double air_density;
+        double heat_rate;
+        double total_heat_load;
+        double surface_temperature;
+        double heat_shield_mass;
+        int32_t parachute_deployed;
+        int32_t outcome; /* ps_outcome */
+    } ps_vessel_state;
+
+    /* One column per channel; NULL columns are skipped. */
+    typedef struct ps_telemetry_columns
+    {
+        double *time;
+        double *altitude;
+        double *velocity;
+        double *air_density;
+        double *heat_rate;
+        double *surface_temperature;
+        double *shield_mass;
+        size_t capacity; /* rows available in every non-NULL column */
+        size_t interval; /* record every Nth step (0 treated as 1) */
+        size_t count;    /* out: rows written */
+        size_t dropped;  /* out: rows that did not fit */
+    } ps_telemetry_columns;
+
+    typedef struct ps_reentry_scenario
+    {
+        double altitude;
+        double velocity;
+        double dry_mass;
+        double drag_coefficient;
+        double cross_section_area;
+        double shield_mass; /* 0 = no shield */
+        double shield_area;
+        double ablation_energy; /* J/kg */
+        double chute_area;      /* 0 = no parachute */
+        double chute_drag_coefficient;
+        double chute_deploy_altitude;
+        double chute_max_mass;
+        double delta_time;
+        double max_time;
+    } ps_reentry_scenario;
+
+    typedef struct ps_run_summary
+    {
+        int32_t outcome; /* ps_outcome */
+        int32_t reserved;
+        double flight_time;
+        double impact_speed;
+        double max_altitude;
+        double peak_heat_rate;
+        double peak_deceleration;
+        double shield_remaining;
+        int64_t steps;
+    } ps_run_summary;
+
+    int ps_api_version(void);
+
+    /* Fills a scenario with the SimulateReentry capsule defaults. */
+    void ps_reentry_scenario_defaults(ps_reentry_scenario *scenario);
+
+    /* atmosphere may be NULL for an airless body. */
+    ps_body *ps_body_create(double mass, double radius, const ps_atmosphere_params *atmosphere);
+    void ps_body_destroy(ps_body *body);
+
+    ps_heat_shield *ps_heat_shield_create(double mass, double area, double ablation_energy, double max_temperature);
+    void ps_heat_shield_destroy(ps_heat_shield *shield);
+
+    ps_parachute *ps_parachute_create(double area, double drag_coefficient, double deploy_altitude, double max_supported_mass);
+    void ps_parachute_destroy(ps_parachute *parachute);
+
+    /* NULL unless dry_mass is positive and fuel_mass, drag_coefficient and
+     * cross_section_area are finite and >= 0. */
+    ps_vessel *ps_vessel_create(ps_body *body, const ps_vessel_params *params);
+    void ps_vessel_destroy(ps_vessel *vessel);
+
+    /* A NULL component detaches. If the vessel refuses the component, the
+     * call returns PS_ERROR_INVALID_ARGUMENT and the previous one stays. */
+    ps_status ps_vessel_attach_heat_shield(ps_vessel *vessel, ps_heat_shield *shield);
+    ps_status ps_vessel_attach_parachute(ps_vessel *vessel, ps_parachute *parachute);
+    /* throttle must be finite; it is clamped to 0..1. */
+    ps_status ps_vessel_set_throttle(ps_vessel *vessel, double throttle);
+    ps_status ps_vessel_set_orientation(ps_vessel *vessel, double x, double y, double z);
+
+    ps_status ps_vessel_step(ps_vessel *vessel, double delta_time, size_t steps);
+    ps_status ps_vessel_get_state(const ps_vessel *vessel, ps_vessel_state *state);
+
+    /* Steps until ground contact or max_time. telemetry and summary may be NULL.
+     * delta_time must be finite and positive, max_time finite and >= 0. */
+    ps_status ps_vessel_run(ps_vessel *vessel, double delta_time, double max_time,
+                            ps_telemetry_columns *telemetry, ps_run_summary *summary);
+
+    /*
+     * Runs count independent reentries on the body across thread_count
+     * threads (0 = all cores). summaries has count entries; telemetry is NULL
+     * or an array of count column sets. Each scenario's delta_time and
+     * max_time are checked as for ps_vessel_run; any invalid one fails the
+     * whole call before anything runs.
+     */
+    ps_status ps_run_reentry_batch(ps_body *body, const ps_reentry_scenario *scenarios, size_t count,
+                                   ps_run_summary *summaries, ps_telemetry_columns *telemetry,
+                                   int thread_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PHYSICSSIM_H */
@@ -0,0 +1,187 @@
+#include "ChebyshevEphemeris.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    constexpr double degrees = M_PI / 180.0;
+    constexpr double secondsPerDay = 86400.0;
+    constexpr double astronomicalUnit = 1.495978707e11; // m
+    constexpr double earthEquatorialRadius = 6378140.0; // m, as used by the lunar parallax series
+}
+
+ChebyshevEphemeris::ChebyshevEphemeris() {}
+
+ChebyshevEphemeris ChebyshevEphemeris::Fit(const std::function<Vector3(double)> &position,
+                                           double startTime,
+                                           double endTime,
+                                           double segmentLength,
+                                           int degree)
+{
+    ChebyshevEphemeris ephemeris;
+    if (degree < 0 || segmentLength <= 0.0 || endTime <= startTime)
+        return ephemeris;
+
+    const int n = degree + 1;
+    ephemeris.header.degree = uint32_t(degree);
+    ephemeris.header.segmentCount = uint32_t(std::ceil((endTime - startTime) / segmentLength));
+    ephemeris.header.startTime = startTime;
+    ephemeris.header.segmentLength = segmentLength;
+    ephemeris.coefficients.assign(size_t(ephemeris.header.segmentCount) * 3 * n, 0.0);
+
+    std::vector<Vector3> samples(n);
+    for (uint32_t s = 0; s < ephemeris.header.segmentCount; ++s)
+    {
+        double mid = startTime + (s + 0.5) * segmentLength;
+        double half = 0.5 * segmentLength;
+        for (int k = 0; k < n; ++k)
+            samples[k] = position(mid + half * std::cos(M_PI * (k + 0.5) / n));
+
+        // Discrete Chebyshev transform; c0 is stored halved so evaluation
+        // needs no special case
+        double *segment = &ephemeris.coefficients[size_t(s) * 3 * n];
+        for (int j = 0; j < n; ++j)
+        {
+            Vector3 sum;
+            for (int k = 0; k < n; ++k)
+                sum = sum + samples[k] * std::cos(M_PI * j * (k + 0.5) / n);
+            double scale = (j == 0 ? 1.0 : 2.0) / n;
+            segment[0 * n + j] = sum.x * scale;
+            segment[1 * n + j] = sum.y * scale;
+            segment[2 * n + j] = sum.z * scale;
+        }
+    }
+
+    // Check between the nodes, where interpolation error peaks
+    for (uint32_t s = 0; s < ephemeris.header.segmentCount; ++s)
+        for (int k = 0; k <= 2 * n; ++k)
+        {
+            double t = startTime + (s + 0.5 + 0.5 * std::cos(M_PI * k / (2.0 * n))) * segmentLength;
+            double error = (ephemeris.Evaluate(t) - position(t)).Length();
+            ephemeris.header.fitError = std::max(ephemeris.header.fitError, error);
+        }
+    return ephemeris;
+}
+
+Vector3 ChebyshevEphemeris::Evaluate(double timeSeconds, bool *inSpan) const
+{
+    if (inSpan)
+        *inSpan = Covers(timeSeconds, timeSeconds);
+    if (IsEmpty())
+        return Vector3();
+
+    double offset = (timeSeconds - header.startTime) / header.segmentLength;
+    offset = std::clamp(offset, 0.0, double(header.segmentCount));
+    uint32_t s = std::min(uint32_t(offset), header.segmentCount - 1);
+    double x = 2.0 * (offset - s) - 1.0; // [-1, 1] within the segment
+
+    const int n = int(header.degree) + 1;
+    const double *segment = &coefficients[size_t(s) * 3 * n];
+    double result[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        // Clenshaw recurrence
+        const double *c = segment + axis * n;
+        double b1 = 0.0, b2 = 0.0;
+        for (int j = n - 1; j >= 1; --j)
+        {
+            double b0 = c[j] + 2.0 * x * b1 - b2;
+            b2 = b1;
+            b1 = b0;
+        }
+        result[axis] = c[0] + x * b1 - b2;
+    }
+    return Vector3(result[0], result[1], result[2]);
+}
+
+bool ChebyshevEphemeris::Covers(double startTime, double endTime) const
+{
+    return !IsEmpty() && startTime >= GetStartTime() && endTime <= GetEndTime();
+}
+
+bool ChebyshevEphemeris::Save(const std::string &path) const
+{
+    std::string partial = path + ".partial";
+    {
+        std::ofstream file(partial, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(coefficients.data()), coefficients.size() * sizeof(double));
+        if (!file.flush())
+            return false;
+    }
+    return std::rename(partial.c_str(), path.c_str()) == 0;
+}
+
+bool ChebyshevEphemeris::Load(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    const uint64_t fileSize = file ? uint64_t(file.tellg()) : 0;
+    file.seekg(0);
+    EphemerisFileHeader loaded;
+    if (!file.read(reinterpret_cast<char *>(&loaded), sizeof(loaded)))
+        return false;
+    if (std::memcmp(loaded.magic, EphemerisFileHeader().magic, sizeof(loaded.magic)) != 0 ||
+        loaded.segmentCount == 0 || !std::isfinite(loaded.startTime) ||
+        !std::isfinite(loaded.segmentLength) || loaded.segmentLength <= 0.0 || loaded.degree > 64)
+        return false;
+
+    // The coefficients the header promises must be in the file before they
+    // are allocated; with degree <= 64 the product cannot overflow
+    const uint64_t valueCount = uint64_t(loaded.segmentCount) * 3 * (loaded.degree + 1);
+    if (valueCount > (fileSize - sizeof(loaded)) / sizeof(double))
+        return false;
+
+    std::vector<double> values(valueCount);
+    if (!file.read(reinterpret_cast<char *>(values.data()), values.size() * sizeof(double)))
+        return false;
+
+    header = loaded;
+    coefficients = std::move(values);
+    return true;
+}
+
+// ==============================
+// Analytic sources
+// ==============================
+Vector3 ApproximateSunPosition(double secondsSinceJ2000)
+{
+    double n = secondsSinceJ2000 / secondsPerDay;
+    double meanLongitude = (280.460 + 0.9856474 * n) * degrees;
+    double meanAnomaly = (357.528 + 0.9856003 * n) * degrees;
+    double eclipticLongitude = meanLongitude + (1.915 * std::sin(meanAnomaly) + 0.020 * std::sin(2.0 * meanAnomaly)) * degrees;
+    double distance = (1.00014 - 0.01671 * std::cos(meanAnomaly) - 0.00014 * std::cos(2.0 * meanAnomaly)) * astronomicalUnit;
+    double obliquity = (23.439 - 0.0000004 * n) * degrees;
+
+    return Vector3(distance * std::cos(eclipticLongitude),
+                   distance * std::cos(obliquity) * std::sin(eclipticLongitude),
+                   distance * std::sin(obliquity) * std::sin(eclipticLongitude));
+}
+
+Vector3 ApproximateMoonPosition(double secondsSinceJ2000)
+{
+    double T = secondsSinceJ2000 / (36525.0 * secondsPerDay);
+    auto sine = [&](double amplitude, double phase, double rate)
+    { return amplitude * std::sin((phase + rate * T) * degrees); };
+    auto cosine = [&](double amplitude, double phase, double rate)
+    { return amplitude * std::cos((phase + rate * T) * degrees); };
+
+    double longitude = 218.32 + 481267.881 * T + sine(6.29, 135.0, 477198.87) -
+                       sine(1.27, 259.3, -413335.36) + sine(0.66, 235.7, 890534.22) +
+                       sine(0.21, 269.9, 954397.74) - sine(0.19, 357.5, 35999.05) -
+                       sine(0.11, 186.5, 966404.03);
+    double latitude = sine(5.13, 93.3, 483202.02) + sine(0.28, 228.2, 960400.89) -
+                      sine(0.28, 318.3, 6003.15) - sine(0.17, 217.6, -407332.21);
+    double parallax = 0.9508 + cosine(0.0518, 135.0, 477198.87) + cosine(0.0095, 259.3, -413335.36) +
+                      cosine(0.0078, 235.7, 890534.22) + cosine(0.0028, 269.9, 954397.74);
+
+    double distance = earthEquatorialRadius / std::sin(parallax * degrees);
+    double l = std::cos(latitude * degrees) * std::cos(longitude * degrees);
+    double m = std::cos(latitude * degrees) * std::sin(longitude * degrees);
+    double n = std::sin(latitude * degrees);
+
+    // Ecliptic to equatorial, mean obliquity at J2000
+    return Vector3(l, 0.9175 * m - 0.3978 * n, 0.3978 * m + 0.9175 * n) * distance;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <Vector3.h>
+
+// On-disk layout: this header followed by the coefficients as doubles,
+// ordered [segment][axis][degree + 1]
+struct EphemerisFileHeader
+{
+    char magic[8] = {'P', 'S', 'I', 'M', 'E', 'P', 'H', '1'};
+    uint32_t degree = 0;
+    uint32_t segmentCount = 0;
+    double startTime = 0.0;     // s since J2000
+    double segmentLength = 0.0; // s
+    double fitError = 0.0;      // m, worst deviation from the source seen during the fit
+};
+
+// Piecewise Chebyshev fit of a position over time in equal-length segments.
+// Fitting samples the source and is meant to run offline; evaluation is an
+// index computation and a Clenshaw recurrence per axis, so a third-body
+// lookup costs a few dozen multiply-adds per step.
+class ChebyshevEphemeris
+{
+public:
+    ChebyshevEphemeris();
+
+    // Interpolates the source at the Chebyshev nodes of every segment
+    static ChebyshevEphemeris Fit(const std::function<Vector3(double)> &position,
+                                  double startTime,
+                                  double endTime,
+                                  double segmentLength,
+                                  int degree);
+
+    // Writes a sibling temporary and renames it over `path`, so a reader
+    // never sees a half-written file
+    bool Save(const std::string &path) const;
+    bool Load(const std::string &path);
+
+    // Times outside the fitted span clamp to its ends; inSpan, when given,
+    // reports whether the time was inside it
+    Vector3 Evaluate(double timeSeconds, bool *inSpan = nullptr) const;
+    bool Covers(double startTime, double endTime) const;
+
+    bool IsEmpty() const { return header.segmentCount == 0; }
+    double GetStartTime() const { return header.startTime; }
+    double GetEndTime() const { return header.startTime + header.segmentCount * header.segmentLength; }
+    int GetDegree() const { return int(header.degree); }
+    size_t GetSegmentCount() const { return header.segmentCount; }
+    double GetFitError() const { return header.fitError; }
+
+private:
+    EphemerisFileHeader header;
+    std::vector<double> coefficients;
+};
+
+// Low-precision analytic geocentric positions from the Astronomical
+// Almanac, in metres in the mean equatorial frame, time in seconds since
+// J2000. Sun to about 0.01°, Moon to about 0.3°: the offline source for
+// fitted ephemerides, not for per-step use.
+Vector3 ApproximateSunPosition(double secondsSinceJ2000);
+Vector3 ApproximateMoonPosition(double secondsSinceJ2000);
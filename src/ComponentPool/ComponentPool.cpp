@@ -0,0 +1,33 @@
+#include "ComponentPool.h"
+
+ComponentArena::ComponentArena(size_t heatShieldCapacity, size_t parachuteCapacity)
+    : heatShields(heatShieldCapacity),
+      parachutes(parachuteCapacity)
+{
+}
+
+HeatShieldHandle ComponentArena::CreateHeatShield(const HeatShield &shield)
+{
+    return heatShields.Create(shield);
+}
+
+ParachuteHandle ComponentArena::CreateParachute(const Parachute &parachute)
+{
+    return parachutes.Create(parachute);
+}
+
+void ComponentArena::Release(HeatShieldHandle handle)
+{
+    heatShields.Release(handle);
+}
+
+void ComponentArena::Release(ParachuteHandle handle)
+{
+    parachutes.Release(handle);
+}
+
+void ComponentArena::Reset()
+{
+    heatShields.Reset();
+    parachutes.Reset();
+}
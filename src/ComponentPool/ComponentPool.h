@@ -0,0 +1,152 @@
+#pragma once
+#include <HeatShield.h>
+#include <Parachute.h>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Index into a ComponentPool plus the generation of the slot it was issued
+// for. A handle outlives nothing: once its component is released, or the
+// pool is reset, it resolves to nullptr instead of dangling.
+template <typename T>
+struct PoolHandle
+{
+    static constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+    uint32_t index = InvalidIndex;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != InvalidIndex; }
+    bool operator==(const PoolHandle &other) const = default;
+};
+
+// Contiguous slot storage with a free list. Reset() drops every component in
+// O(1) by advancing the pool epoch, so components must not need destruction.
+template <typename T>
+class ComponentPool
+{
+    static_assert(std::is_trivially_destructible_v<T>, "pooled components are dropped without destruction");
+
+public:
+    using Handle = PoolHandle<T>;
+
+    explicit ComponentPool(size_t capacity = 0)
+    {
+        slots.reserve(capacity);
+    }
+
+    template <typename... Args>
+    Handle Create(Args &&...args)
+    {
+        uint32_t index;
+        if (!freeSlots.empty())
+        {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        else
+        {
+            index = usedSlots++;
+            if (index == slots.size())
+                slots.emplace_back();
+        }
+
+        Slot &slot = slots[index];
+        slot.value.emplace(std::forward<Args>(args)...);
+        slot.epoch = epoch;
+        ++slot.generation;
+        ++liveCount;
+        return {index, slot.generation};
+    }
+
+    void Release(Handle handle)
+    {
+        if (!Get(handle))
+            return;
+        slots[handle.index].value.reset();
+        freeSlots.push_back(handle.index);
+        --liveCount;
+    }
+
+    // Invalidates every handle; storage is kept for the next batch
+    void Reset()
+    {
+        ++epoch;
+        usedSlots = 0;
+        liveCount = 0;
+        freeSlots.clear();
+    }
+
+    T *Get(Handle handle)
+    {
+        return const_cast<T *>(std::as_const(*this).Get(handle));
+    }
+
+    const T *Get(Handle handle) const
+    {
+        if (handle.index >= usedSlots)
+            return nullptr;
+        const Slot &slot = slots[handle.index];
+        if (slot.epoch != epoch || slot.generation != handle.generation || !slot.value)
+            return nullptr;
+        return &*slot.value;
+    }
+
+    // Visit live components in storage order
+    template <typename Visitor>
+    void ForEach(Visitor visit)
+    {
+        for (uint32_t i = 0; i < usedSlots; ++i)
+            if (slots[i].value && slots[i].epoch == epoch)
+                visit(*slots[i].value);
+    }
+
+    size_t GetLiveCount() const { return liveCount; }
+    size_t GetCapacity() const { return slots.capacity(); }
+
+private:
+    struct Slot
+    {
+        std::optional<T> value;
+        uint32_t generation = 0;
+        uint32_t epoch = 0;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    uint32_t usedSlots = 0; // slots handed out since the last Reset
+    uint32_t epoch = 0;
+    size_t liveCount = 0;
+};
+
+using HeatShieldHandle = PoolHandle<HeatShield>;
+using ParachuteHandle = PoolHandle<Parachute>;
+
+// Per-run owner of vessel components. Vessels hold handles into one arena;
+// a Monte Carlo batch resets the arena instead of freeing each component.
+class ComponentArena
+{
+public:
+    explicit ComponentArena(size_t heatShieldCapacity = 0, size_t parachuteCapacity = 0);
+
+    HeatShieldHandle CreateHeatShield(const HeatShield &shield);
+    ParachuteHandle CreateParachute(const Parachute &parachute);
+
+    void Release(HeatShieldHandle handle);
+    void Release(ParachuteHandle handle);
+    void Reset();
+
+    HeatShield *Get(HeatShieldHandle handle) { return heatShields.Get(handle); }
+    const HeatShield *Get(HeatShieldHandle handle) const { return heatShields.Get(handle); }
+    Parachute *Get(ParachuteHandle handle) { return parachutes.Get(handle); }
+    const Parachute *Get(ParachuteHandle handle) const { return parachutes.Get(handle); }
+
+    ComponentPool<HeatShield> &GetHeatShields() { return heatShields; }
+    ComponentPool<Parachute> &GetParachutes() { return parachutes; }
+
+private:
+    ComponentPool<HeatShield> heatShields;
+    ComponentPool<Parachute> parachutes;
+};
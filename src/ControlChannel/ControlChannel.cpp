@@ -0,0 +1,211 @@
+#include "ControlChannel.h"
+#include <atomic>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+namespace
+{
+    constexpr uint64_t layoutMagic = 0x50534354524c3031; // "PSCTRL01"
+    constexpr int maxReadAttempts = 64;
+
+    // Payload copied as relaxed 64-bit atomics, so a torn read is detected by
+    // the sequence check instead of being a data race
+    template <typename T>
+    struct SeqlockSlot
+    {
+        static_assert(std::is_trivially_copyable_v<T> && sizeof(T) % sizeof(uint64_t) == 0);
+        static constexpr size_t wordCount = sizeof(T) / sizeof(uint64_t);
+
+        std::atomic<uint32_t> sequence; // odd while a write is in progress
+        std::atomic<uint64_t> words[wordCount];
+
+        void Store(const T &value)
+        {
+            uint64_t buffer[wordCount];
+            std::memcpy(buffer, &value, sizeof(T));
+
+            uint32_t s = sequence.load(std::memory_order_relaxed);
+            sequence.store(s + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_t i = 0; i < wordCount; ++i)
+                words[i].store(buffer[i], std::memory_order_relaxed);
+            sequence.store(s + 2, std::memory_order_release);
+        }
+
+        // Returns the sequence of the snapshot, or 0 if none could be taken
+        uint32_t Load(T &value) const
+        {
+            uint64_t buffer[wordCount];
+            for (int attempt = 0; attempt < maxReadAttempts; ++attempt)
+            {
+                uint32_t before = sequence.load(std::memory_order_acquire);
+                if (before & 1)
+                    continue;
+                for (size_t i = 0; i < wordCount; ++i)
+                    buffer[i] = words[i].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence.load(std::memory_order_relaxed) == before)
+                {
+                    std::memcpy(&value, buffer, sizeof(T));
+                    return before;
+                }
+            }
+            return 0;
+        }
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+                  "shared-memory atomics must be address-free");
+}
+
+struct ControlChannelLayout
+{
+    std::atomic<uint64_t> magic; // published last by the plant
+    SeqlockSlot<ControlInputs> inputs;
+    SeqlockSlot<PlantTelemetry> telemetry;
+    std::atomic<uint32_t> shutdown;
+};
+
+ControlChannel::ControlChannel()
+    : shared(nullptr),
+      owner(false),
+      lastInputsSequence(0),
+      lastTelemetrySequence(0)
+{
+}
+
+ControlChannel::~ControlChannel()
+{
+    Close();
+}
+
+bool ControlChannel::Create(const std::string &channelName)
+{
+    Close();
+    int fd = ::shm_open(channelName.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd < 0)
+        return false;
+
+    void *memory = MAP_FAILED;
+    if (::ftruncate(fd, sizeof(ControlChannelLayout)) == 0)
+        memory = ::mmap(nullptr, sizeof(ControlChannelLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED)
+    {
+        ::shm_unlink(channelName.c_str());
+        return false;
+    }
+
+    // Zeroed atomics are valid initial states; the magic is released last so
+    // a controller attaching early sees an uninitialized segment
+    std::memset(memory, 0, sizeof(ControlChannelLayout));
+    shared = static_cast<ControlChannelLayout *>(memory);
+    shared->magic.store(layoutMagic, std::memory_order_release);
+
+    name = channelName;
+    owner = true;
+    lastInputsSequence = 0;
+    lastTelemetrySequence = 0;
+    return true;
+}
+
+bool ControlChannel::Open(const std::string &channelName)
+{
+    Close();
+    int fd = ::shm_open(channelName.c_str(), O_RDWR, 0);
+    if (fd < 0)
+        return false;
+
+    // A segment shorter than the layout (not yet sized by the plant, or some
+    // other program's) would fault on first access past its end
+    struct stat status;
+    if (::fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(ControlChannelLayout)))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void *memory = ::mmap(nullptr, sizeof(ControlChannelLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED)
+        return false;
+
+    ControlChannelLayout *layout = static_cast<ControlChannelLayout *>(memory);
+    if (layout->magic.load(std::memory_order_acquire) != layoutMagic)
+    {
+        ::munmap(memory, sizeof(ControlChannelLayout));
+        return false;
+    }
+
+    shared = layout;
+    name = channelName;
+    owner = false;
+    lastInputsSequence = 0;
+    lastTelemetrySequence = 0;
+    return true;
+}
+
+void ControlChannel::Close()
+{
+    if (!shared)
+        return;
+    ::munmap(shared, sizeof(ControlChannelLayout));
+    if (owner)
+        ::shm_unlink(name.c_str());
+    shared = nullptr;
+    owner = false;
+    name.clear();
+}
+
+void ControlChannel::PublishInputs(const ControlInputs &inputs)
+{
+    if (shared)
+        shared->inputs.Store(inputs);
+}
+
+bool ControlChannel::PollInputs(ControlInputs &inputs)
+{
+    if (!shared)
+        return false;
+    ControlInputs snapshot;
+    uint32_t sequence = shared->inputs.Load(snapshot);
+    if (sequence == 0 || sequence == lastInputsSequence)
+        return false;
+    lastInputsSequence = sequence;
+    inputs = snapshot;
+    return true;
+}
+
+void ControlChannel::PublishTelemetry(const PlantTelemetry &telemetry)
+{
+    if (shared)
+        shared->telemetry.Store(telemetry);
+}
+
+bool ControlChannel::PollTelemetry(PlantTelemetry &telemetry)
+{
+    if (!shared)
+        return false;
+    PlantTelemetry snapshot;
+    uint32_t sequence = shared->telemetry.Load(snapshot);
+    if (sequence == 0 || sequence == lastTelemetrySequence)
+        return false;
+    lastTelemetrySequence = sequence;
+    telemetry = snapshot;
+    return true;
+}
+
+void ControlChannel::RequestShutdown()
+{
+    if (shared)
+        shared->shutdown.store(1, std::memory_order_release);
+}
+
+bool ControlChannel::ShutdownRequested() const
+{
+    return shared && shared->shutdown.load(std::memory_order_acquire) != 0;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Controller -> plant
+struct ControlInputs
+{
+    double throttle = 1.0;     // 0..1
+    double orientationX = 0.0; // thrust axis, normalized by the plant
+    double orientationY = 1.0;
+    double orientationZ = 0.0;
+    uint64_t telemetryFrame = 0; // plant frame the inputs were computed from
+};
+
+// Plant -> controller
+struct PlantTelemetry
+{
+    uint64_t frame = 0;
+    double missionTime = 0.0;     // s
+    double altitude = 0.0;        // m
+    double velocity = 0.0;        // m/s
+    double fuelMass = 0.0;        // kg
+    double dynamicPressure = 0.0; // Pa
+    double throttle = 0.0;        // as applied this frame
+    uint64_t finished = 0;        // nonzero once the plant stops stepping
+};
+
+struct ControlChannelLayout;
+
+// Lock-free exchange between a plant and a controller process through POSIX
+// shared memory. Each direction is a single-writer seqlock: the writer never
+// waits, and a reader retries a bounded number of times, so neither side can
+// stall the other's frame. Readers only see the latest value; intermediate
+// writes are overwritten, which is what a sampled control loop wants.
+class ControlChannel
+{
+public:
+    ControlChannel();
+    ~ControlChannel();
+
+    ControlChannel(const ControlChannel &) = delete;
+    ControlChannel &operator=(const ControlChannel &) = delete;
+
+    // Plant side: creates (or resets) the segment and unlinks it on Close.
+    // Names follow shm_open: a leading '/' and no further slashes.
+    bool Create(const std::string &name);
+    // Controller side: attaches to a segment created by the plant
+    bool Open(const std::string &name);
+    void Close();
+    bool IsOpen() const { return shared != nullptr; }
+
+    void PublishInputs(const ControlInputs &inputs);
+    // True when a consistent write newer than the last one read is returned
+    bool PollInputs(ControlInputs &inputs);
+
+    void PublishTelemetry(const PlantTelemetry &telemetry);
+    bool PollTelemetry(PlantTelemetry &telemetry);
+
+    void RequestShutdown();
+    bool ShutdownRequested() const;
+
+private:
+    ControlChannelLayout *shared;
+    std::string name;
+    bool owner;
+    uint32_t lastInputsSequence;
+    uint32_t lastTelemetrySequence;
+};
@@ -0,0 +1,270 @@
+#include "ConvergenceStudy.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+    struct Metric
+    {
+        const char *name;
+        double (*extract)(const ScenarioResult &);
+    };
+
+    // Accuracy order of each stepper on smooth problems; 0 = no fixed order
+    // (multi-rate picks its own sub-steps, so halving dt is not a ladder)
+    int FormalOrder(IntegrationMethod method)
+    {
+        switch (method)
+        {
+        case IntegrationMethod::SemiImplicitEuler:
+        case IntegrationMethod::ExplicitEuler:
+            return 1;
+        case IntegrationMethod::Heun:
+            return 2;
+        case IntegrationMethod::RungeKutta4:
+            return 4;
+        case IntegrationMethod::MultiRate:
+            return 0;
+        }
+        return 0;
+    }
+
+    // Derivative evaluations per step
+    int StageCount(IntegrationMethod method)
+    {
+        switch (method)
+        {
+        case IntegrationMethod::Heun:
+            return 2;
+        case IntegrationMethod::RungeKutta4:
+            return 4;
+        default:
+            return 1;
+        }
+    }
+
+    // Observed order and extrapolated value from the finest three levels
+    struct Extrapolation
+    {
+        double order = NAN; // NaN when the differences are not monotone
+        double value = 0.0;
+        bool asymptotic = false;
+    };
+
+    // Largest gap between observed and formal order still taken as asymptotic
+    constexpr double orderTolerance = 0.5;
+
+    Extrapolation Extrapolate(double fine, double medium, double coarse, int formalOrder)
+    {
+        Extrapolation result;
+        result.value = fine;
+
+        double fineStep = fine - medium;
+        double coarseStep = medium - coarse;
+        if (fineStep == 0.0 && coarseStep == 0.0)
+        {
+            result.asymptotic = formalOrder > 0; // already exact at this resolution
+            return result;
+        }
+
+        // Outside the asymptotic range the differences change sign or shrink
+        // at the wrong rate, and extrapolating would only add error
+        if (fineStep == 0.0 || coarseStep == 0.0 || (fineStep > 0.0) != (coarseStep > 0.0))
+            return result;
+        result.order = std::log2(coarseStep / fineStep);
+        if (formalOrder <= 0 || std::abs(result.order - formalOrder) > orderTolerance)
+            return result;
+
+        result.asymptotic = true;
+        result.value = fine + fineStep / (std::pow(2.0, formalOrder) - 1.0);
+        return result;
+    }
+
+    ConvergenceReport RunStudy(const std::string &scenarioName,
+                               const std::vector<Metric> &metrics,
+                               const ConvergenceSettings &settings,
+                               const std::function<ScenarioResult(IntegrationMethod, double)> &run)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        ConvergenceReport report;
+        report.scenario = scenarioName;
+        report.methods = settings.methods;
+        for (size_t m = 0; m < metrics.size(); ++m)
+        {
+            report.metricNames.push_back(metrics[m].name);
+            report.tolerances.push_back(m < settings.tolerances.size() ? settings.tolerances[m] : settings.tolerance);
+        }
+
+        for (IntegrationMethod method : settings.methods)
+        {
+            double deltaTime = settings.coarsestDeltaTime;
+            for (int level = 0; level < settings.levels; ++level, deltaTime *= 0.5)
+            {
+                Clock::time_point start = Clock::now();
+                ScenarioResult result = run(method, deltaTime);
+
+                ConvergenceRun entry;
+                entry.method = method;
+                entry.deltaTime = deltaTime;
+                entry.steps = result.steps;
+                entry.evaluations = result.steps * StageCount(method);
+                entry.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+                for (const Metric &metric : metrics)
+                    entry.values.push_back(metric.extract(result));
+                report.runs.push_back(entry);
+            }
+        }
+
+        // Reference per metric: the extrapolation of the highest-order method
+        // that is in its asymptotic range at the finest three levels
+        size_t levels = settings.levels;
+        report.reference.assign(metrics.size(), NAN);
+        report.asymptotic.assign(metrics.size(), false);
+        report.orders.assign(settings.methods.size(), std::vector<double>(metrics.size(), NAN));
+        report.inRange.assign(settings.methods.size(), std::vector<bool>(metrics.size(), false));
+        for (size_t m = 0; m < metrics.size(); ++m)
+        {
+            int bestOrder = 0;
+            for (size_t i = 0; i < settings.methods.size() && levels >= 3; ++i)
+            {
+                int formalOrder = FormalOrder(settings.methods[i]);
+                const ConvergenceRun *finest = &report.runs[i * levels + levels - 1];
+                Extrapolation e = Extrapolate(finest[0].values[m], finest[-1].values[m], finest[-2].values[m],
+                                              formalOrder);
+                report.orders[i][m] = e.order;
+                report.inRange[i][m] = e.asymptotic;
+                if (e.asymptotic && formalOrder > bestOrder)
+                {
+                    bestOrder = formalOrder;
+                    report.reference[m] = e.value;
+                    report.asymptotic[m] = true;
+                }
+            }
+        }
+
+        for (ConvergenceRun &entry : report.runs)
+            for (size_t m = 0; m < metrics.size(); ++m)
+                entry.errors.push_back(report.asymptotic[m]
+                                           ? std::abs(entry.values[m] - report.reference[m]) /
+                                                 std::max(std::abs(report.reference[m]), 1e-12)
+                                           : NAN);
+        return report;
+    }
+}
+
+const ConvergenceRun *ConvergenceReport::Cheapest() const
+{
+    const ConvergenceRun *best = nullptr;
+    for (const ConvergenceRun &entry : runs)
+    {
+        // Evaluations, not wall time: a single timing of a sub-millisecond
+        // run is mostly noise
+        bool meets = true;
+        for (size_t m = 0; m < entry.errors.size(); ++m)
+            meets = meets && (!asymptotic[m] || entry.errors[m] <= tolerances[m]);
+        if (meets && (!best || entry.evaluations < best->evaluations))
+            best = &entry;
+    }
+    return best;
+}
+
+std::string ConvergenceReport::Format() const
+{
+    std::ostringstream out;
+    out << "  [" << scenario << "] relative error vs Richardson reference\n";
+    out << "    " << std::left << std::setw(20) << "method" << std::right
+        << std::setw(9) << "dt (s)" << std::setw(9) << "steps" << std::setw(10) << "ms";
+    for (const std::string &name : metricNames)
+        out << std::setw(16) << name;
+    out << "\n";
+
+    for (const ConvergenceRun &entry : runs)
+    {
+        out << "    " << std::left << std::setw(20) << ToString(entry.method) << std::right
+            << std::fixed << std::setprecision(5) << std::setw(9) << entry.deltaTime
+            << std::setw(9) << entry.steps
+            << std::setprecision(2) << std::setw(10) << entry.seconds * 1000.0
+            << std::scientific;
+        for (double error : entry.errors)
+            if (std::isnan(error))
+                out << std::setw(16) << "-";
+            else
+                out << std::setw(16) << error;
+        out << "\n";
+    }
+
+    // '*' marks the method/metric pairs inside their asymptotic range
+    out << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < methods.size(); ++i)
+    {
+        out << "    observed order, " << std::left << std::setw(20) << ToString(methods[i]) << std::right;
+        for (size_t m = 0; m < orders[i].size(); ++m)
+        {
+            if (std::isnan(orders[i][m]))
+                out << std::setw(8) << "-";
+            else
+                out << std::setw(8) << orders[i][m];
+            out << (inRange[i][m] ? "*" : " ");
+        }
+        out << "\n";
+    }
+
+    out << "    reference:";
+    out << std::setprecision(6);
+    for (size_t m = 0; m < metricNames.size(); ++m)
+    {
+        out << " " << metricNames[m] << " = ";
+        if (asymptotic[m])
+            out << reference[m];
+        else
+            out << "non-asymptotic (excluded)";
+        out << (m + 1 < metricNames.size() ? "," : "\n");
+    }
+
+    if (const ConvergenceRun *best = Cheapest())
+        out << std::setprecision(5) << "    cheapest within tolerance: " << ToString(best->method)
+            << " at dt = " << best->deltaTime << " s (" << best->steps << " steps, "
+            << best->evaluations << " evaluations)\n";
+    else
+        out << "    no run meets every tolerance\n";
+    return out.str();
+}
+
+ConvergenceReport RunConvergenceStudy(OrbitalBody *body,
+                                      const ReentryScenario &scenario,
+                                      const ConvergenceSettings &settings)
+{
+    std::vector<Metric> metrics = {
+        {"impact time", [](const ScenarioResult &r) { return r.impactTime; }},
+        {"impact speed", [](const ScenarioResult &r) { return r.impactSpeed; }},
+        {"peak heat", [](const ScenarioResult &r) { return r.peakHeatRate; }},
+        {"shield left", [](const ScenarioResult &r) { return r.shieldRemainingKg; }}};
+
+    return RunStudy("reentry", metrics, settings, [&](IntegrationMethod method, double deltaTime)
+                    {
+                        ReentryScenario run = scenario;
+                        run.integrationMethod = method;
+                        run.deltaTime = deltaTime;
+                        return RunReentryScenario(body, run); });
+}
+
+ConvergenceReport RunConvergenceStudy(OrbitalBody *body,
+                                      const LaunchScenario &scenario,
+                                      const ConvergenceSettings &settings)
+{
+    std::vector<Metric> metrics = {
+        {"apex altitude", [](const ScenarioResult &r) { return r.apexAltitude; }},
+        {"max q", [](const ScenarioResult &r) { return r.peakDynamicPressure; }}};
+
+    return RunStudy("launch", metrics, settings, [&](IntegrationMethod method, double deltaTime)
+                    {
+                        LaunchScenario run = scenario;
+                        run.integrationMethod = method;
+                        run.deltaTime = deltaTime;
+                        return RunLaunchScenario(body, run); });
+}
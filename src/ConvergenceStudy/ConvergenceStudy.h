@@ -0,0 +1,63 @@
+#pragma once
+#include <Scenario.h>
+#include <string>
+#include <vector>
+
+class OrbitalBody;
+
+struct ConvergenceSettings
+{
+    std::vector<IntegrationMethod> methods = {
+        IntegrationMethod::SemiImplicitEuler,
+        IntegrationMethod::ExplicitEuler,
+        IntegrationMethod::Heun,
+        IntegrationMethod::RungeKutta4};
+    double coarsestDeltaTime = 0.4; // s, halved at every level
+    int levels = 7;
+    double tolerance = 1e-3;        // relative, for metrics without their own
+    std::vector<double> tolerances; // per metric, overrides `tolerance`
+};
+
+struct ConvergenceRun
+{
+    IntegrationMethod method = IntegrationMethod::SemiImplicitEuler;
+    double deltaTime = 0.0;
+    long steps = 0;
+    long evaluations = 0;       // steps x stages of the method
+    double seconds = 0.0;       // wall time, informational only
+    std::vector<double> values; // one per metric
+    std::vector<double> errors; // relative to the extrapolated reference, NaN if none
+};
+
+struct ConvergenceReport
+{
+    std::string scenario;
+    std::vector<std::string> metricNames;
+    std::vector<double> tolerances;
+    std::vector<double> reference;              // Richardson-extrapolated
+    std::vector<bool> asymptotic;               // per metric: some method gave a reference
+    std::vector<std::vector<double>> orders;    // [method][metric], observed, NaN if not monotone
+    std::vector<std::vector<bool>> inRange;     // [method][metric], asymptotic at the finest levels
+    std::vector<IntegrationMethod> methods;
+    std::vector<ConvergenceRun> runs;
+
+    // Run with the fewest derivative evaluations meeting every asymptotic
+    // metric's tolerance, nullptr if none does
+    const ConvergenceRun *Cheapest() const;
+    std::string Format() const;
+};
+
+// Run a scenario across a ladder of step sizes for each integrator and rate
+// every run against a Richardson-extrapolated reference. A metric is only
+// extrapolated from a method whose finest three levels converge
+// monotonically at that method's formal order; metrics with no such method
+// are reported as non-asymptotic and left out of the ranking. Reentry metrics:
+// impact time, impact speed, peak heat rate, remaining shield. Launch
+// metrics: apex altitude, peak dynamic pressure.
+ConvergenceReport RunConvergenceStudy(OrbitalBody *body,
+                                      const ReentryScenario &scenario,
+                                      const ConvergenceSettings &settings);
+
+ConvergenceReport RunConvergenceStudy(OrbitalBody *body,
+                                      const LaunchScenario &scenario,
+                                      const ConvergenceSettings &settings);
@@ -0,0 +1,409 @@
+#include "EventBus.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
+namespace
+{
+    std::atomic<uint64_t> nextBusId(1);
+
+    // Same scheme as the metrics shards: last queue used, then per bus
+    thread_local uint64_t cachedBus = 0;
+    thread_local void *cachedQueue = nullptr;
+    thread_local bool queuesReturned = false; // set once this thread's rings were retired
+
+    // Live buses by id: an exiting thread only retires rings of buses that
+    // still exist
+    std::mutex &DirectoryMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    std::unordered_map<uint64_t, EventBus *> &Directory()
+    {
+        static std::unordered_map<uint64_t, EventBus *> directory;
+        return directory;
+    }
+
+    size_t RoundUpToPowerOfTwo(size_t value)
+    {
+        size_t result = 1;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+}
+
+const char *ToString(SimEventType type)
+{
+    switch (type)
+    {
+    case SimEventType::ParachuteDeployed:
+        return "parachute deployed";
+    case SimEventType::Burnout:
+        return "burnout";
+    case SimEventType::Apex:
+        return "apex";
+    case SimEventType::ShieldDepleted:
+        return "shield depleted";
+    case SimEventType::Impact:
+        return "impact";
+    case SimEventType::BurnedUp:
+        return "burned up";
+    }
+    return "unknown";
+}
+
+// ==============================
+// Sinks
+// ==============================
+ConsoleSink::ConsoleSink(std::ostream &out, std::vector<SimEventType> types)
+    : out(out)
+{
+    for (SimEventType type : types)
+        enabled[int(type)] = true;
+}
+
+void ConsoleSink::Follow(uint64_t vesselId)
+{
+    std::lock_guard<std::mutex> lock(followMutex);
+    followed.push_back(vesselId);
+}
+
+void ConsoleSink::Unfollow(uint64_t vesselId)
+{
+    std::lock_guard<std::mutex> lock(followMutex);
+    followed.erase(std::remove(followed.begin(), followed.end(), vesselId), followed.end());
+}
+
+void ConsoleSink::Consume(const SimEvent &event)
+{
+    if (!enabled[int(event.type)])
+        return;
+    {
+        std::lock_guard<std::mutex> lock(followMutex);
+        if (std::find(followed.begin(), followed.end(), event.vesselId) == followed.end())
+            return;
+    }
+
+    // Formatted separately so the shared stream's flags are left alone
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(1);
+    switch (event.type)
+    {
+    case SimEventType::ParachuteDeployed:
+        line << "🪂 Parachute deployed at " << event.altitude << " m";
+        break;
+    case SimEventType::Burnout:
+        line << "🛑 Fuel exhausted at t = " << event.missionTime << " seconds";
+        break;
+    case SimEventType::Apex:
+        line << "📍 Apex reached at t = " << event.missionTime << " seconds";
+        break;
+    case SimEventType::ShieldDepleted:
+        line << "🔥 Heat shield depleted at " << event.altitude << " m";
+        break;
+    case SimEventType::Impact:
+        line << "💥 Impact at " << -event.velocity << " m/s";
+        break;
+    case SimEventType::BurnedUp:
+        line << "☄️  Burned up at t = " << event.missionTime << " seconds";
+        break;
+    }
+    out << line.str() << "\n";
+}
+
+FileSink::FileSink(const std::string &path)
+    : file(path)
+{
+    file << "wall_ns,vessel,event,mission_time,altitude,velocity\n";
+}
+
+void FileSink::Consume(const SimEvent &event)
+{
+    file << event.wallTimeNanos << "," << event.vesselId << "," << ToString(event.type) << ","
+         << event.missionTime << "," << event.altitude << "," << event.velocity << "\n";
+}
+
+void StatsSink::Consume(const SimEvent &event)
+{
+    ++counts[int(event.type)];
+    missionTimeSums[int(event.type)] += event.missionTime;
+}
+
+uint64_t StatsSink::GetTotal() const
+{
+    uint64_t total = 0;
+    for (uint64_t count : counts)
+        total += count;
+    return total;
+}
+
+double StatsSink::GetMeanMissionTime(SimEventType type) const
+{
+    return counts[int(type)] ? missionTimeSums[int(type)] / counts[int(type)] : 0.0;
+}
+
+std::string StatsSink::Format() const
+{
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    for (int i = 0; i < simEventTypeCount; ++i)
+        if (counts[i])
+            out << (out.tellp() > 0 ? ", " : "") << counts[i] << " " << ToString(SimEventType(i))
+                << " (mean t = " << missionTimeSums[i] / counts[i] << " s)";
+    return out.str();
+}
+
+// ==============================
+// Bus
+// ==============================
+struct EventBus::ThreadQueues
+{
+    std::unordered_map<uint64_t, Queue *> byBus;
+
+    ~ThreadQueues()
+    {
+        queuesReturned = true;
+        cachedBus = 0;
+        cachedQueue = nullptr;
+
+        std::lock_guard<std::mutex> lock(DirectoryMutex());
+        for (const auto &[busId, queue] : byBus)
+        {
+            auto found = Directory().find(busId);
+            if (found != Directory().end())
+                found->second->RetireQueue(queue);
+        }
+    }
+};
+
+EventBus::EventBus(size_t queueCapacity, double pollSeconds)
+    : id(nextBusId++),
+      capacity(RoundUpToPowerOfTwo(std::max<size_t>(queueCapacity, 2))),
+      pollSeconds(pollSeconds),
+      active(false),
+      retiredDropped(0),
+      flushRequests(0),
+      flushedThrough(0),
+      running(false),
+      stopping(false),
+      consuming(false)
+{
+    std::lock_guard<std::mutex> lock(DirectoryMutex());
+    Directory()[id] = this;
+}
+
+EventBus::~EventBus()
+{
+    Stop();
+    std::lock_guard<std::mutex> lock(DirectoryMutex());
+    Directory().erase(id);
+}
+
+EventBus &EventBus::Global()
+{
+    static EventBus bus;
+    return bus;
+}
+
+bool EventBus::AddSink(EventSink *sink)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running || !sink)
+        return false;
+    sinks.push_back(sink);
+    return true;
+}
+
+bool EventBus::Start()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running)
+        return false;
+    running = true;
+    stopping = false;
+    consuming = true;
+    consumer = std::thread(&EventBus::Loop, this);
+    active.store(true);
+    return true;
+}
+
+void EventBus::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running)
+            return;
+        running = false;
+        active.store(false);
+        stopping = true;
+    }
+    wake.notify_all();
+    consumer.join();
+}
+
+EventBus::Queue *EventBus::LocalQueue()
+{
+    if (cachedBus == id)
+        return static_cast<Queue *>(cachedQueue);
+    if (queuesReturned)
+        return nullptr;
+
+    thread_local ThreadQueues threadQueues;
+    Queue *&queue = threadQueues.byBus[id];
+    if (!queue)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (freeQueues.empty())
+            queues.push_back(std::make_unique<Queue>(capacity));
+        else
+        {
+            queues.push_back(std::move(freeQueues.back()));
+            freeQueues.pop_back();
+        }
+        queue = queues.back().get();
+    }
+    cachedBus = id;
+    cachedQueue = queue;
+    return queue;
+}
+
+// On the exiting producer thread. Only the consumer empties and recycles
+// rings, since it may be draining this one right now; a stopped bus has no
+// consumer and recycles here.
+void EventBus::RetireQueue(Queue *queue)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    queue->retired = true;
+    if (!consuming)
+        RecycleRetired();
+}
+
+// Caller holds the mutex and no Drain is in flight
+void EventBus::RecycleRetired()
+{
+    for (size_t i = 0; i < queues.size();)
+    {
+        Queue *queue = queues[i].get();
+        uint64_t head = queue->head.load(std::memory_order_acquire);
+        if (!queue->retired || (consuming && queue->tail.load(std::memory_order_relaxed) != head))
+        {
+            ++i;
+            continue;
+        }
+
+        // A stopped bus never delivers what is left; count it as dropped
+        retiredDropped += queue->dropped.load(std::memory_order_relaxed) +
+                          (head - queue->tail.load(std::memory_order_relaxed));
+        queue->head.store(0, std::memory_order_relaxed);
+        queue->tail.store(0, std::memory_order_relaxed);
+        queue->dropped.store(0, std::memory_order_relaxed);
+        queue->retired = false;
+        freeQueues.push_back(std::move(queues[i]));
+        queues[i] = std::move(queues.back());
+        queues.pop_back();
+    }
+}
+
+void EventBus::Publish(const SimEvent &event)
+{
+    if (!IsActive())
+        return;
+
+    Queue *queue = LocalQueue();
+    if (!queue)
+        return;
+    uint64_t head = queue->head.load(std::memory_order_relaxed);
+    if (head - queue->tail.load(std::memory_order_acquire) >= capacity)
+    {
+        queue->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    SimEvent &slot = queue->slots[head & (capacity - 1)];
+    slot = event;
+    slot.wallTimeNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now().time_since_epoch())
+                             .count();
+    queue->head.store(head + 1, std::memory_order_release);
+}
+
+void EventBus::Flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!running)
+        return;
+    uint64_t ticket = ++flushRequests;
+    wake.notify_all();
+    flushed.wait(lock, [&]
+                 { return flushedThrough >= ticket; });
+}
+
+uint64_t EventBus::GetDroppedCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t dropped = retiredDropped;
+    for (const std::unique_ptr<Queue> &queue : queues)
+        dropped += queue->dropped.load(std::memory_order_relaxed);
+    return dropped;
+}
+
+size_t EventBus::GetQueueCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return queues.size() + freeQueues.size();
+}
+
+void EventBus::Drain(const std::vector<Queue *> &snapshot)
+{
+    for (Queue *queue : snapshot)
+    {
+        uint64_t tail = queue->tail.load(std::memory_order_relaxed);
+        uint64_t head = queue->head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail)
+            for (EventSink *sink : sinks)
+                sink->Consume(queue->slots[tail & (capacity - 1)]);
+        queue->tail.store(tail, std::memory_order_release);
+    }
+}
+
+void EventBus::Loop()
+{
+    auto interval = std::chrono::duration<double>(pollSeconds);
+    std::vector<Queue *> snapshot;
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;)
+    {
+        uint64_t ticket = flushRequests;
+        bool last = stopping;
+        snapshot.clear();
+        for (const std::unique_ptr<Queue> &queue : queues)
+            snapshot.push_back(queue.get());
+
+        lock.unlock();
+        Drain(snapshot);
+        bool flushing = last || ticket != flushedThrough;
+        if (flushing)
+            for (EventSink *sink : sinks)
+                sink->Flush();
+        lock.lock();
+
+        // Rings drained above whose threads have exited; done before
+        // answering the flush so a flushing caller sees them recycled
+        RecycleRetired();
+        flushedThrough = ticket;
+        if (flushing)
+            flushed.notify_all();
+        if (last)
+        {
+            consuming = false;
+            break;
+        }
+        wake.wait_for(lock, interval, [&]
+                      { return stopping || flushRequests != ticket; });
+    }
+}
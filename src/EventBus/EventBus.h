@@ -0,0 +1,169 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class SimEventType : uint8_t
+{
+    ParachuteDeployed,
+    Burnout,
+    Apex,
+    ShieldDepleted,
+    Impact, // landed or crashed; velocity is the impact velocity
+    BurnedUp
+};
+
+constexpr int simEventTypeCount = 6;
+
+const char *ToString(SimEventType type);
+
+struct SimEvent
+{
+    SimEventType type = SimEventType::Impact;
+    uint64_t vesselId = 0;
+    double missionTime = 0.0; // s
+    double altitude = 0.0;    // m
+    double velocity = 0.0;    // m/s
+    int64_t wallTimeNanos = 0; // steady clock, stamped on publish
+};
+
+// Sinks run on the bus's consumer thread only, so they need no locking of
+// their own; read their results after EventBus::Flush or Stop
+class EventSink
+{
+public:
+    virtual ~EventSink() = default;
+    virtual void Consume(const SimEvent &event) = 0;
+    virtual void Flush() {}
+};
+
+// One line per event, for the types it was given and the vessels it
+// follows, so a narrated run is not drowned out by a sweep beside it
+class ConsoleSink : public EventSink
+{
+public:
+    ConsoleSink(std::ostream &out, std::vector<SimEventType> types);
+    void Consume(const SimEvent &event) override;
+    void Flush() override { out.flush(); }
+
+    // Safe to call while the bus is running
+    void Follow(uint64_t vesselId);
+    void Unfollow(uint64_t vesselId);
+
+private:
+    std::ostream &out;
+    bool enabled[simEventTypeCount] = {};
+    std::mutex followMutex;
+    std::vector<uint64_t> followed;
+};
+
+// CSV: wall time, vessel, event, mission time, altitude, velocity
+class FileSink : public EventSink
+{
+public:
+    explicit FileSink(const std::string &path);
+    bool IsOpen() const { return file.is_open(); }
+    void Consume(const SimEvent &event) override;
+    void Flush() override { file.flush(); }
+
+private:
+    std::ofstream file;
+};
+
+class StatsSink : public EventSink
+{
+public:
+    void Consume(const SimEvent &event) override;
+
+    uint64_t GetCount(SimEventType type) const { return counts[int(type)]; }
+    uint64_t GetTotal() const;
+    // Mean mission time of each event type, e.g. time to deploy
+    double GetMeanMissionTime(SimEventType type) const;
+    std::string Format() const;
+
+private:
+    uint64_t counts[simEventTypeCount] = {};
+    double missionTimeSums[simEventTypeCount] = {};
+};
+
+// Simulation events from any number of stepping threads to a set of sinks.
+// Each publishing thread owns a fixed-size single-producer ring, so
+// publishing never takes a lock or touches a stream; a consumer thread
+// drains the rings every poll interval and feeds the sinks. A full ring
+// drops the event and counts it rather than stall the physics. Events keep
+// their order per thread, not across threads. A thread's ring is retired
+// when the thread exits; the consumer delivers what is left in it and puts
+// it on a free list for the next publishing thread.
+class EventBus
+{
+public:
+    explicit EventBus(size_t queueCapacity = 4096, double pollSeconds = 0.002);
+    ~EventBus();
+    EventBus(const EventBus &) = delete;
+    EventBus &operator=(const EventBus &) = delete;
+
+    // Bus the simulation modules publish to
+    static EventBus &Global();
+
+    // Sinks are caller-owned and fixed once the bus is started
+    bool AddSink(EventSink *sink);
+    bool Start();
+    void Stop(); // delivers everything already published
+
+    // Publishing to a bus that is not running is a no-op
+    bool IsActive() const { return active.load(std::memory_order_relaxed); }
+    void Publish(const SimEvent &event);
+
+    // Returns once every event this thread published before the call has
+    // reached the sinks and the sinks are flushed
+    void Flush();
+
+    uint64_t GetDroppedCount() const;
+    size_t GetQueueCount() const; // allocated rings, in use or free
+
+private:
+    struct Queue
+    {
+        explicit Queue(size_t capacity) : slots(capacity) {}
+
+        std::vector<SimEvent> slots;
+        alignas(64) std::atomic<uint64_t> head{0}; // producer
+        alignas(64) std::atomic<uint64_t> tail{0}; // consumer
+        std::atomic<uint64_t> dropped{0};
+        bool retired = false; // producer thread exited; guarded by the bus mutex
+    };
+
+    struct ThreadQueues; // this thread's ring per bus, retired at thread exit
+
+    Queue *LocalQueue(); // nullptr while the thread is being torn down
+    void RetireQueue(Queue *queue);
+    void RecycleRetired();
+    void Drain(const std::vector<Queue *> &snapshot);
+    void Loop();
+
+    const uint64_t id; // tells thread-local queue caches apart across buses
+    const size_t capacity;
+    const double pollSeconds;
+    std::atomic<bool> active;
+
+    mutable std::mutex mutex; // queues, sinks and the consumer handshake
+    std::condition_variable wake;
+    std::condition_variable flushed;
+    std::vector<std::unique_ptr<Queue>> queues;     // drained by the consumer
+    std::vector<std::unique_ptr<Queue>> freeQueues; // emptied, for the next thread
+    uint64_t retiredDropped;
+    std::vector<EventSink *> sinks;
+    uint64_t flushRequests;
+    uint64_t flushedThrough;
+    bool running;
+    bool stopping;
+    bool consuming; // consumer thread between Start and its final pass
+    std::thread consumer;
+};
@@ -0,0 +1,79 @@
+#include "FastMath.h"
+
+namespace
+{
+    // One mode check per batch; the fast loop body is branch-free so the
+    // compiler can keep it in vector registers
+    template <typename Real, typename FastKernel, typename StandardKernel>
+    void Apply(const Real *in, Real *out, size_t count, FastKernel fast, StandardKernel standard)
+    {
+        if (FastMath::IsFast())
+        {
+#pragma omp simd
+            for (size_t i = 0; i < count; ++i)
+                out[i] = fast(in[i]);
+        }
+        else
+        {
+            for (size_t i = 0; i < count; ++i)
+                out[i] = standard(in[i]);
+        }
+    }
+}
+
+namespace FastMath
+{
+    const char *ToString(Mode mode)
+    {
+        switch (mode)
+        {
+        case Mode::Standard:
+            return "standard";
+        case Mode::Fast:
+            return "fast";
+        }
+        return "unknown";
+    }
+
+    void Exp(const double *in, double *out, size_t count)
+    {
+        Apply(in, out, count, [](double x) { return FastExp(x); }, [](double x) { return std::exp(x); });
+    }
+
+    void Exp(const float *in, float *out, size_t count)
+    {
+        Apply(in, out, count, [](float x) { return FastExp(x); }, [](float x) { return std::exp(x); });
+    }
+
+    void Pow(const double *in, double exponent, double *out, size_t count)
+    {
+        Apply(in, out, count, [exponent](double x) { return FastPow(x, exponent); },
+              [exponent](double x) { return std::pow(x, exponent); });
+    }
+
+    void Pow(const float *in, float exponent, float *out, size_t count)
+    {
+        Apply(in, out, count, [exponent](float x) { return FastPow(x, exponent); },
+              [exponent](float x) { return std::pow(x, exponent); });
+    }
+
+    void Sin(const double *in, double *out, size_t count)
+    {
+        Apply(in, out, count, [](double x) { return FastSin(x); }, [](double x) { return std::sin(x); });
+    }
+
+    void Cos(const double *in, double *out, size_t count)
+    {
+        Apply(in, out, count, [](double x) { return FastCos(x); }, [](double x) { return std::cos(x); });
+    }
+
+    void Asin(const double *in, double *out, size_t count)
+    {
+        Apply(in, out, count, [](double x) { return FastAsin(x); }, [](double x) { return std::asin(x); });
+    }
+
+    void Acos(const double *in, double *out, size_t count)
+    {
+        Apply(in, out, count, [](double x) { return FastAcos(x); }, [](double x) { return std::acos(x); });
+    }
+}
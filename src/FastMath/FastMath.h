@@ -0,0 +1,323 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Polynomial replacements for the transcendental functions on the step hot
+// path, selectable at runtime. In Standard mode every wrapper forwards to
+// <cmath>, so results are bit-identical to calling it directly.
+//
+// Kernels are branch-free (selects, integer bit tricks for 2^n and the
+// exponent) so batched loops vectorize. Each polynomial is the shortest
+// Taylor series whose truncation error stays inside the contract, which
+// trades the last six or so digits of <cmath> for speed. Accuracy contract,
+// in double, checked by TestFastMathAccuracy:
+//   Exp          relative 1e-9             x in [-708, 709]
+//   Log          absolute 1e-10            x positive and normal
+//   Pow          relative 1e-9             x > 0, |y| <= 10
+//   Sin, Cos     absolute 1e-9             |x| <= 1e5
+//   Asin, Acos   absolute 1e-9             x in [-1, 1]
+// Float takes shorter series for Exp and Log, accurate to a few float ULP.
+namespace FastMath
+{
+    enum class Mode
+    {
+        Standard, // <cmath>
+        Fast      // polynomial kernels
+    };
+
+    inline std::atomic<Mode> activeMode{Mode::Standard};
+
+    inline void SetMode(Mode mode) { activeMode.store(mode, std::memory_order_relaxed); }
+    inline Mode GetMode() { return activeMode.load(std::memory_order_relaxed); }
+    inline bool IsFast() { return GetMode() == Mode::Fast; }
+    const char *ToString(Mode mode);
+
+    constexpr double ExpMaxRelativeError = 1e-9;
+    constexpr double LogMaxAbsoluteError = 1e-10;
+    constexpr double PowMaxRelativeError = 1e-9;
+    constexpr double SinCosMaxAbsoluteError = 1e-9;
+    constexpr double AsinAcosMaxAbsoluteError = 1e-9;
+    constexpr double FloatMaxUlpError = 4.0; // float Exp
+
+    namespace Detail
+    {
+        template <typename Real>
+        struct Bits;
+
+        template <>
+        struct Bits<double>
+        {
+            using Int = uint64_t;
+            static constexpr int MantissaBits = 52;
+            static constexpr Int Bias = 1023;
+            static constexpr double Shifter = 6755399441055744.0; // 1.5 * 2^52: adding rounds to an integer
+            static constexpr double MinExp = -708.0;
+            static constexpr double MaxExp = 709.0;
+            static constexpr double Ln2Hi = 6.93147180369123816490e-01; // trailing zeros keep n * Ln2Hi exact
+            static constexpr double Ln2Lo = 1.90821492927058770002e-10;
+            static constexpr double HalfPiA = 1.57079632673412561417e+00; // π/2 in three parts
+            static constexpr double HalfPiB = 6.07710050630396597660e-11;
+            static constexpr double HalfPiC = 2.02226624871116645580e-21;
+            static constexpr int ExpDegree = 8; // |r|^9 / 9! <= 2e-10
+            static constexpr int LogTerms = 5;  // 2|s| z^6 / 13 <= 2e-11
+        };
+
+        template <>
+        struct Bits<float>
+        {
+            using Int = uint32_t;
+            static constexpr int MantissaBits = 23;
+            static constexpr Int Bias = 127;
+            static constexpr float Shifter = 12582912.0f; // 1.5 * 2^23
+            static constexpr float MinExp = -87.0f;
+            static constexpr float MaxExp = 88.0f;
+            static constexpr float Ln2Hi = 6.9314575195e-01f;
+            static constexpr float Ln2Lo = 1.4286067653e-06f;
+            static constexpr float HalfPiA = 1.5707855225e+00f;
+            static constexpr float HalfPiB = 1.0804273188e-05f;
+            static constexpr float HalfPiC = 6.0770943833e-11f;
+            static constexpr int ExpDegree = 6; // |r|^7 / 7! <= 1.2e-7
+            static constexpr int LogTerms = 3;  // 2|s| z^4 / 9 <= 3e-8
+        };
+
+        // Taylor coefficients of e^x: 1 / n!
+        constexpr int MaxExpDegree = 8;
+        inline constexpr std::array<double, MaxExpDegree + 1> ExpCoefficients = []
+        {
+            std::array<double, MaxExpDegree + 1> coefficients{};
+            double c = 1.0;
+            for (int n = 0; n <= MaxExpDegree; ++n)
+            {
+                if (n > 0)
+                    c /= n;
+                coefficients[n] = c;
+            }
+            return coefficients;
+        }();
+
+        // Taylor coefficients of asin(x)/x in powers of x²:
+        // (2n)! / (4^n (n!)² (2n + 1)); 13 terms leave 6e-11 at x = 0.5
+        constexpr int AsinTerms = 13;
+        inline constexpr std::array<double, AsinTerms> AsinCoefficients = []
+        {
+            std::array<double, AsinTerms> coefficients{};
+            double c = 1.0;
+            for (int n = 0; n < AsinTerms; ++n)
+            {
+                if (n > 0)
+                    c *= (2.0 * n - 1.0) / (2.0 * n);
+                coefficients[n] = c / (2.0 * n + 1.0);
+            }
+            return coefficients;
+        }();
+
+        // sin(r) and cos(r) for |r| <= π/4
+        template <typename Real>
+        inline Real SinPolynomial(Real r)
+        {
+            Real z = r * r;
+            Real p = Real(-1.0 / 39916800.0); // -1/11!, |r|^13 / 13! <= 7e-12
+            p = Real(1.0 / 362880.0) + z * p;
+            p = Real(-1.0 / 5040.0) + z * p;
+            p = Real(1.0 / 120.0) + z * p;
+            p = Real(-1.0 / 6.0) + z * p;
+            return r + r * z * p;
+        }
+
+        template <typename Real>
+        inline Real CosPolynomial(Real r)
+        {
+            Real z = r * r;
+            Real p = Real(-1.0 / 3628800.0); // -1/10!, |r|^12 / 12! <= 1.2e-10
+            p = Real(1.0 / 40320.0) + z * p;
+            p = Real(-1.0 / 720.0) + z * p;
+            p = Real(1.0 / 24.0) + z * p;
+            p = Real(-0.5) + z * p;
+            return Real(1) + z * p;
+        }
+
+        // asin for |x| <= 0.5
+        template <typename Real>
+        inline Real AsinPolynomial(Real x)
+        {
+            Real z = x * x;
+            Real p = Real(AsinCoefficients[AsinTerms - 1]);
+#pragma GCC unroll 32
+            for (int n = AsinTerms - 2; n >= 0; --n)
+                p = Real(AsinCoefficients[n]) + z * p;
+            return x * p;
+        }
+
+        template <typename Real>
+        inline Real Select(bool condition, Real a, Real b)
+        {
+            return condition ? a : b;
+        }
+    }
+
+    // ==============================
+    // Kernels (always the approximation)
+    // ==============================
+    template <typename Real>
+    inline Real FastExp(Real x)
+    {
+        using B = Detail::Bits<Real>;
+        constexpr Real log2e = Real(1.4426950408889634);
+
+        Real clamped = Detail::Select(x < B::MinExp, B::MinExp, Detail::Select(x > B::MaxExp, B::MaxExp, x));
+
+        // n = round(x / ln 2); its low bits land in the mantissa of `shifted`
+        Real shifted = clamped * log2e + B::Shifter;
+        Real n = shifted - B::Shifter;
+        Real r = clamped - n * B::Ln2Hi - n * B::Ln2Lo;
+
+        // e^r, |r| <= ln2 / 2
+        Real p = Real(Detail::ExpCoefficients[B::ExpDegree]);
+#pragma GCC unroll 16
+        for (int n = B::ExpDegree - 1; n >= 0; --n)
+            p = Real(Detail::ExpCoefficients[n]) + r * p;
+
+        // 2^n from the rounded integer's bits
+        typename B::Int scaleBits = (std::bit_cast<typename B::Int>(shifted) + B::Bias) << B::MantissaBits;
+        Real result = p * std::bit_cast<Real>(scaleBits);
+
+        result = Detail::Select(x < B::MinExp, Real(0), result);
+        return Detail::Select(x > B::MaxExp, Real(INFINITY), result);
+    }
+
+    // x must be positive and normal
+    template <typename Real>
+    inline Real FastLog(Real x)
+    {
+        using B = Detail::Bits<Real>;
+        using Int = typename B::Int;
+        constexpr Int mantissaMask = (Int(1) << B::MantissaBits) - 1;
+        constexpr Int one = B::Bias << B::MantissaBits;
+
+        Int bits = std::bit_cast<Int>(x);
+        Real m = std::bit_cast<Real>((bits & mantissaMask) | one); // [1, 2)
+
+        // Biased exponent as a float without an int-to-float conversion
+        constexpr Int magic = std::bit_cast<Int>(Real(Int(1) << B::MantissaBits));
+        Real e = std::bit_cast<Real>((bits >> B::MantissaBits) | magic) - Real(Int(1) << B::MantissaBits) - Real(B::Bias);
+
+        // Centre the mantissa on 1: [sqrt(1/2), sqrt(2))
+        bool high = m > Real(1.4142135623730951);
+        m = Detail::Select(high, m * Real(0.5), m);
+        e = Detail::Select(high, e + Real(1), e);
+
+        // log(m) = 2 atanh(s), |s| <= 0.1716
+        Real s = (m - Real(1)) / (m + Real(1));
+        Real z = s * s;
+        Real p = Real(1.0 / (2 * B::LogTerms + 1));
+#pragma GCC unroll 16
+        for (int k = B::LogTerms - 1; k >= 1; --k)
+            p = Real(1.0 / (2 * k + 1)) + z * p;
+        Real logm = Real(2) * s + Real(2) * s * z * p;
+
+        return e * B::Ln2Hi + (logm + e * B::Ln2Lo);
+    }
+
+    // x must be positive and normal
+    template <typename Real>
+    inline Real FastPow(Real x, Real y)
+    {
+        return FastExp(y * FastLog(x));
+    }
+
+    template <typename Real>
+    inline Real FastSinCos(Real x, int quadrantOffset)
+    {
+        using B = Detail::Bits<Real>;
+        using Int = typename B::Int;
+        constexpr Real twoOverPi = Real(0.63661977236758134308);
+
+        Real shifted = x * twoOverPi + B::Shifter;
+        Real q = shifted - B::Shifter;
+        Real r = x - q * B::HalfPiA - q * B::HalfPiB - q * B::HalfPiC;
+
+        // Quadrant picks sin or cos and the sign, applied as bit masks so the
+        // selection stays in integer vector ops
+        Int quadrant = std::bit_cast<Int>(shifted) + Int(quadrantOffset);
+        Int useCos = Int(0) - (quadrant & 1);
+        Int sign = (quadrant & 2) << (sizeof(Int) * 8 - 2);
+        Int s = std::bit_cast<Int>(Detail::SinPolynomial(r));
+        Int c = std::bit_cast<Int>(Detail::CosPolynomial(r));
+        return std::bit_cast<Real>(((c & useCos) | (s & ~useCos)) ^ sign);
+    }
+
+    template <typename Real>
+    inline Real FastSin(Real x) { return FastSinCos(x, 0); }
+
+    template <typename Real>
+    inline Real FastCos(Real x) { return FastSinCos(x, 1); }
+
+    template <typename Real>
+    inline Real FastAsin(Real x)
+    {
+        constexpr Real halfPi = Real(1.57079632679489661923);
+        Real a = std::fabs(x);
+        bool large = a > Real(0.5);
+
+        // asin(a) = π/2 - 2 asin(sqrt((1 - a) / 2)) above 0.5
+        Real z = Detail::Select(large, std::sqrt((Real(1) - a) * Real(0.5)), a);
+        Real p = Detail::AsinPolynomial(z);
+        Real result = Detail::Select(large, halfPi - Real(2) * p, p);
+        return std::copysign(result, x);
+    }
+
+    template <typename Real>
+    inline Real FastAcos(Real x)
+    {
+        constexpr Real halfPi = Real(1.57079632679489661923);
+        constexpr Real pi = Real(3.14159265358979323846);
+        Real a = std::fabs(x);
+        bool large = a > Real(0.5);
+
+        // acos(x) = 2 asin(sqrt((1 - |x|) / 2)) near ±1, mirrored for x < 0
+        Real z = Detail::Select(large, std::sqrt((Real(1) - a) * Real(0.5)), x);
+        Real p = Detail::AsinPolynomial(z);
+        Real nearOne = Detail::Select(x > Real(0), Real(2) * p, pi - Real(2) * p);
+        return Detail::Select(large, nearOne, halfPi - p);
+    }
+
+    // ==============================
+    // Mode-dispatched scalar wrappers
+    // ==============================
+    template <typename Real>
+    inline Real Exp(Real x) { return IsFast() ? FastExp(x) : std::exp(x); }
+
+    template <typename Real>
+    inline Real Pow(Real x, Real y)
+    {
+        return (IsFast() && x > Real(0)) ? FastPow(x, y) : std::pow(x, y);
+    }
+
+    template <typename Real>
+    inline Real Sin(Real x) { return IsFast() ? FastSin(x) : std::sin(x); }
+
+    template <typename Real>
+    inline Real Cos(Real x) { return IsFast() ? FastCos(x) : std::cos(x); }
+
+    template <typename Real>
+    inline Real Asin(Real x) { return IsFast() ? FastAsin(x) : std::asin(x); }
+
+    template <typename Real>
+    inline Real Acos(Real x) { return IsFast() ? FastAcos(x) : std::acos(x); }
+
+    // ==============================
+    // Mode-dispatched batches (out may alias in)
+    // ==============================
+    void Exp(const double *in, double *out, size_t count);
+    void Exp(const float *in, float *out, size_t count);
+    void Pow(const double *in, double exponent, double *out, size_t count); // in > 0
+    void Pow(const float *in, float exponent, float *out, size_t count);
+    void Sin(const double *in, double *out, size_t count);
+    void Cos(const double *in, double *out, size_t count);
+    void Asin(const double *in, double *out, size_t count);
+    void Acos(const double *in, double *out, size_t count);
+}
@@ -30,6 +30,23 @@ void HeatShield::AbsorbHeat(double heatFluxWPerM2, double deltaTime)
     mass -= actualAblated;
     totalAblatedMass += actualAblated;
 
+    UpdateSurfaceTemperature();
+}
+
+double HeatShield::GetAblationRate(double heatFluxWPerM2) const
+{
+    return mass > 0.0 ? heatFluxWPerM2 * area / ablationEnergyPerKg : 0.0;
+}
+
+void HeatShield::Restore(double remainingMassKg, double ablatedMassKg)
+{
+    mass = std::clamp(remainingMassKg, 0.0, initialMass);
+    totalAblatedMass = std::max(0.0, ablatedMassKg);
+    UpdateSurfaceTemperature();
+}
+
+void HeatShield::UpdateSurfaceTemperature()
+{
     // Estimate temp (optional - can link to heat flux instead)
     surfaceTemp = (mass > 0.0)
                       ? maxSurfaceTemp * (1.0 - mass / initialMass)
@@ -17,7 +17,15 @@ public:
 
     bool IsDepleted() const;
 
+    // kg/s ablated under a heat flux, while any shield remains
+    double GetAblationRate(double heatFluxWPerM2) const;
+
+    // Restore a checkpointed ablation state
+    void Restore(double remainingMassKg, double ablatedMassKg);
+
 private:
+    void UpdateSurfaceTemperature();
+
     double ablationEnergyPerKg; // J/kg
     double area;                // m² (shielded)
     double initialMass;
@@ -0,0 +1,340 @@
+#include "LaunchOptimizer.h"
+#include <OrbitalBody.h>
+#include <Vessel.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <thread>
+
+namespace
+{
+    constexpr double standardGravity = 9.80665; // m/s²
+
+    double InterpolateKnots(const std::vector<double> &knots, double time, double duration)
+    {
+        if (knots.empty() || time < 0.0 || time > duration)
+            return 0.0;
+        if (knots.size() == 1)
+            return knots[0];
+
+        double position = time / duration * (knots.size() - 1);
+        size_t i = std::min(static_cast<size_t>(position), knots.size() - 2);
+        double t = position - i;
+        return knots[i] + (knots[i + 1] - knots[i]) * t;
+    }
+}
+
+// ==============================
+// Profile
+// ==============================
+double LaunchProfile::ThrottleAt(double time) const
+{
+    return std::clamp(InterpolateKnots(throttleKnots, time, duration), 0.0, 1.0);
+}
+
+// ==============================
+// Optimizer
+// ==============================
+LaunchOptimizer::LaunchOptimizer(OrbitalBody *body,
+                                 const LaunchVehicle &vehicle,
+                                 const LaunchOptimizerSettings &settings)
+    : body(body),
+      vehicle(vehicle),
+      settings(settings),
+      incumbentCost(std::numeric_limits<double>::infinity()) {}
+
+LaunchProfile LaunchOptimizer::DecodeProfile(const std::vector<double> &parameters) const
+{
+    LaunchProfile profile;
+    profile.duration = settings.scheduleDuration;
+
+    // One throttle knot per parameter; box [0, 1]
+    for (int i = 0; i < settings.knotCount; ++i)
+        profile.throttleKnots.push_back(std::clamp(parameters[i], 0.0, 1.0));
+    return profile;
+}
+
+double LaunchOptimizer::Cost(double apex, double maxQ, double fuelUsed) const
+{
+    double shortfall = std::max(0.0, settings.targetApexAltitude - apex);
+    switch (settings.objective)
+    {
+    case LaunchObjective::MaxApexAltitude:
+        return -apex;
+    case LaunchObjective::MinMaxDynamicPressure:
+        return maxQ + settings.shortfallPenaltyPerMeter * shortfall;
+    case LaunchObjective::MinFuelToApex:
+        return fuelUsed + settings.shortfallPenaltyPerMeter * shortfall;
+    }
+    return 0.0;
+}
+
+double LaunchOptimizer::CostLowerBound(double apexBound, double maxQ, double fuelUsed) const
+{
+    // Peak q and fuel burned only grow, apex can't beat its bound
+    return Cost(apexBound, maxQ, fuelUsed);
+}
+
+double LaunchOptimizer::ApexUpperBound(double altitude, double velocity, double mass, double fuel, double missionTime) const
+{
+    // Best case: every remaining kg of fuel burned instantly at vacuum Isp with
+    // no drag. Any real schedule loses to gravity and drag, and burning later
+    // means burning at a lower speed, so this energy is an upper bound.
+    double deltaV = vehicle.engine.GetVacuumISP() * standardGravity *
+                    std::log(mass / std::max(mass - fuel, 1e-9));
+
+    // Thrust is still integrated explicitly: the step that empties the tank
+    // applies its full impulse, up to one step of full thrust on the dry mass
+    // more than the rocket equation allows
+    if (fuel > 0.0)
+        deltaV += vehicle.engine.GetMaxThrust() / vehicle.dryMassKg * settings.deltaTime;
+    double speed = velocity + deltaV;
+    if (speed <= 0.0)
+        return altitude;
+
+    // Gravity as the rockets feel it: the full model (J2, third bodies) at
+    // the default site (0, 0), as an effective point mass g r². J2 makes g r²
+    // shrink with height, so it is taken again at the first estimate and the
+    // smaller value kept: weaker gravity can only raise the apex.
+    auto effectiveMu = [&](double height)
+    {
+        double r = body->GetRadius() + height;
+        return body->ComputeGravitationalAcceleration(height, 0.0, 0.0, missionTime) * r * r;
+    };
+    auto apexFor = [&](double mu)
+    {
+        double radius = body->GetRadius() + altitude;
+        double energy = mu / radius - 0.5 * speed * speed;
+        if (energy <= 0.0)
+            return std::numeric_limits<double>::infinity(); // escape
+        return mu / energy - body->GetRadius();
+    };
+
+    double mu = effectiveMu(altitude);
+    double estimate = apexFor(mu);
+    if (!std::isfinite(estimate))
+        return estimate;
+    mu = std::min(mu, effectiveMu(estimate));
+
+    // Drag and gravity are closed form: each step holds gravity at its start
+    // value (the stronger one on the way up) and advances altitude with the
+    // end-of-step speed, both of which keep the simulated climb below this
+    return apexFor(mu) + 10.0;
+}
+
+LaunchEvaluation LaunchOptimizer::Evaluate(const LaunchProfile &profile, double incumbent) const
+{
+    Vessel rocket(
+        0.0,
+        0.0,
+        vehicle.dryMassKg,
+        vehicle.fuelMassKg,
+        vehicle.dragCoefficient,
+        vehicle.crossSectionArea,
+        body,
+        vehicle.engine);
+
+    LaunchEvaluation result;
+    double time = 0.0;
+    double maxAltitude = 0.0;
+
+    while (time <= settings.maxTime)
+    {
+        rocket.SetThrottle(profile.ThrottleAt(time));
+        rocket.Update(settings.deltaTime);
+        time += settings.deltaTime;
+        ++result.steps;
+
+        double altitude = rocket.GetAltitude();
+        double velocity = rocket.GetVelocity();
+        maxAltitude = std::max(maxAltitude, altitude);
+
+        double q = 0.5 * rocket.GetLastAirDensity() * velocity * velocity;
+        result.maxDynamicPressure = std::max(result.maxDynamicPressure, q);
+
+        bool engineDone = rocket.GetFuelMass() <= 0.0 || time > profile.duration;
+        if ((engineDone && velocity <= 0.0) || altitude < 0.0)
+            break;
+
+        if (result.steps % settings.boundCheckInterval == 0)
+        {
+            double apexBound = std::max(maxAltitude,
+                                        ApexUpperBound(altitude, velocity, rocket.GetMass(),
+                                                       engineDone ? 0.0 : rocket.GetFuelMass(),
+                                                       rocket.GetMissionTime()));
+            double bound = CostLowerBound(apexBound, result.maxDynamicPressure,
+                                          vehicle.fuelMassKg - rocket.GetFuelMass());
+            if (bound >= incumbent)
+            {
+                result.terminatedEarly = true;
+                result.cost = bound;
+                break;
+            }
+        }
+    }
+
+    result.apexAltitude = maxAltitude;
+    result.fuelUsed = vehicle.fuelMassKg - rocket.GetFuelMass();
+    if (!result.terminatedEarly)
+        result.cost = Cost(result.apexAltitude, result.maxDynamicPressure, result.fuelUsed);
+    return result;
+}
+
+void LaunchOptimizer::OfferIncumbent(const std::vector<double> &parameters, const LaunchEvaluation &evaluation)
+{
+    if (!evaluation.terminatedEarly && evaluation.cost < incumbentCost)
+    {
+        incumbentCost = evaluation.cost;
+        incumbentParameters = parameters;
+        incumbentEvaluation = evaluation;
+    }
+}
+
+void LaunchOptimizer::EvaluatePopulation(const std::vector<std::vector<double>> &candidates,
+                                         std::vector<LaunchEvaluation> &results)
+{
+    results.assign(candidates.size(), LaunchEvaluation());
+    std::atomic<size_t> next(0);
+
+    // Workers prune against the incumbent from earlier generations only, so
+    // the search is reproducible regardless of thread count or timing.
+    const double incumbent = incumbentCost;
+    auto worker = [&]()
+    {
+        for (size_t i = next++; i < candidates.size(); i = next++)
+            results[i] = Evaluate(DecodeProfile(candidates[i]), incumbent);
+    };
+
+    int threadCount = settings.threadCount > 0
+                          ? settings.threadCount
+                          : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    threadCount = std::min<int>(threadCount, candidates.size());
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < threadCount; ++t)
+        threads.emplace_back(worker);
+    worker();
+    for (std::thread &thread : threads)
+        thread.join();
+
+    for (size_t i = 0; i < candidates.size(); ++i)
+        OfferIncumbent(candidates[i], results[i]);
+}
+
+LaunchOptimizationResult LaunchOptimizer::Optimize()
+{
+    // === Separable CMA-ES (Ros & Hansen 2008) ===
+    const int n = settings.knotCount;
+    const int lambda = std::max(4, settings.populationSize);
+    const int mu = lambda / 2;
+
+    std::vector<double> weights(mu);
+    for (int i = 0; i < mu; ++i)
+        weights[i] = std::log(mu + 0.5) - std::log(i + 1.0);
+    double weightSum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    double weightSquares = 0.0;
+    for (double &w : weights)
+    {
+        w /= weightSum;
+        weightSquares += w * w;
+    }
+    const double muEff = 1.0 / weightSquares;
+
+    const double cSigma = (muEff + 2.0) / (n + muEff + 5.0);
+    const double dSigma = 1.0 + 2.0 * std::max(0.0, std::sqrt((muEff - 1.0) / (n + 1.0)) - 1.0) + cSigma;
+    const double cc = (4.0 + muEff / n) / (n + 4.0 + 2.0 * muEff / n);
+    const double sepScale = (n + 2.0) / 3.0;
+    const double c1 = std::min(1.0, sepScale * 2.0 / ((n + 1.3) * (n + 1.3) + muEff));
+    const double cMu = std::min(1.0 - c1, sepScale * 2.0 * (muEff - 2.0 + 1.0 / muEff) / ((n + 2.0) * (n + 2.0) + muEff));
+    const double chiN = std::sqrt(n) * (1.0 - 1.0 / (4.0 * n) + 1.0 / (21.0 * n * n));
+
+    std::vector<double> mean(n, settings.initialThrottle);
+    std::vector<double> variance(n, 1.0);
+    std::vector<double> pathSigma(n, 0.0), pathC(n, 0.0);
+    double sigma = settings.initialStepSize;
+
+    std::mt19937 rng(settings.seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    incumbentCost = std::numeric_limits<double>::infinity();
+    incumbentParameters = mean;
+
+    LaunchOptimizationResult result;
+    std::vector<std::vector<double>> steps(lambda, std::vector<double>(n));
+    std::vector<std::vector<double>> candidates(lambda, std::vector<double>(n));
+    std::vector<LaunchEvaluation> evaluations;
+
+    for (int generation = 0; generation < settings.maxGenerations; ++generation)
+    {
+        for (int k = 0; k < lambda; ++k)
+            for (int i = 0; i < n; ++i)
+            {
+                steps[k][i] = std::sqrt(variance[i]) * normal(rng);
+                candidates[k][i] = mean[i] + sigma * steps[k][i];
+            }
+
+        EvaluatePopulation(candidates, evaluations);
+        result.evaluations += lambda;
+        for (const LaunchEvaluation &evaluation : evaluations)
+            if (evaluation.terminatedEarly)
+                ++result.earlyTerminations;
+
+        // Early-terminated candidates only have a bound on their cost, which
+        // may still undercut a completed candidate of this generation: rank
+        // them after every completed one, among themselves by the bound.
+        std::vector<int> order(lambda);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+                  [&](int a, int b)
+                  {
+                      if (evaluations[a].terminatedEarly != evaluations[b].terminatedEarly)
+                          return evaluations[b].terminatedEarly;
+                      return evaluations[a].cost < evaluations[b].cost;
+                  });
+
+        std::vector<double> weightedStep(n, 0.0);
+        for (int j = 0; j < mu; ++j)
+            for (int i = 0; i < n; ++i)
+                weightedStep[i] += weights[j] * steps[order[j]][i];
+
+        double pathSigmaNorm = 0.0;
+        for (int i = 0; i < n; ++i)
+        {
+            mean[i] += sigma * weightedStep[i];
+            pathSigma[i] = (1.0 - cSigma) * pathSigma[i] +
+                           std::sqrt(cSigma * (2.0 - cSigma) * muEff) * weightedStep[i] / std::sqrt(variance[i]);
+            pathSigmaNorm += pathSigma[i] * pathSigma[i];
+        }
+        pathSigmaNorm = std::sqrt(pathSigmaNorm);
+
+        double hSigmaThreshold = (1.4 + 2.0 / (n + 1.0)) * chiN *
+                                 std::sqrt(1.0 - std::pow(1.0 - cSigma, 2.0 * (generation + 1)));
+        double hSigma = pathSigmaNorm < hSigmaThreshold ? 1.0 : 0.0;
+
+        for (int i = 0; i < n; ++i)
+        {
+            pathC[i] = (1.0 - cc) * pathC[i] + hSigma * std::sqrt(cc * (2.0 - cc) * muEff) * weightedStep[i];
+
+            double rankMu = 0.0;
+            for (int j = 0; j < mu; ++j)
+                rankMu += weights[j] * steps[order[j]][i] * steps[order[j]][i];
+
+            variance[i] = (1.0 - c1 - cMu) * variance[i] +
+                          c1 * (pathC[i] * pathC[i] + (1.0 - hSigma) * cc * (2.0 - cc) * variance[i]) +
+                          cMu * rankMu;
+        }
+
+        sigma *= std::exp((cSigma / dSigma) * (pathSigmaNorm / chiN - 1.0));
+        result.generations = generation + 1;
+
+        if (sigma < 1e-4)
+            break;
+    }
+
+    result.bestProfile = DecodeProfile(incumbentParameters);
+    result.bestEvaluation = incumbentEvaluation;
+    return result;
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <vector>
+#include <ThrustModel.h>
+
+class OrbitalBody;
+
+enum class LaunchObjective
+{
+    MaxApexAltitude,       // maximize apex
+    MinMaxDynamicPressure, // minimize peak q while reaching targetApexAltitude
+    MinFuelToApex          // minimize fuel burned while reaching targetApexAltitude
+};
+
+// Throttle knots spread evenly over [0, duration]; linear in between,
+// engine cut off after the last knot. Vessels fly a vertical line, so
+// throttle is the only control the model can express.
+struct LaunchProfile
+{
+    std::vector<double> throttleKnots; // 0..1
+    double duration = 120.0;           // s
+
+    double ThrottleAt(double time) const;
+};
+
+struct LaunchVehicle
+{
+    double dryMassKg = 10000.0;
+    double fuelMassKg = 20000.0;
+    double dragCoefficient = 2.0;
+    double crossSectionArea = 1.2; // m²
+    ThrustModel engine = ThrustModel(1.5e6, 350.0, 280.0);
+};
+
+struct LaunchOptimizerSettings
+{
+    LaunchObjective objective = LaunchObjective::MaxApexAltitude;
+    int knotCount = 6;
+    double scheduleDuration = 120.0; // s
+    double targetApexAltitude = 100000.0; // m, constraint for the min-* objectives
+    double shortfallPenaltyPerMeter = 10.0;
+
+    int populationSize = 16;
+    int maxGenerations = 40;
+    double initialStepSize = 0.3;
+    double initialThrottle = 0.7;
+    unsigned seed = 1;
+    int threadCount = 0; // 0 = hardware concurrency
+
+    double deltaTime = 0.1;
+    double maxTime = 600.0;
+    int boundCheckInterval = 10; // steps between early-termination checks
+};
+
+struct LaunchEvaluation
+{
+    double cost = 0.0; // lower is better; a lower bound when terminatedEarly
+    double apexAltitude = 0.0;
+    double maxDynamicPressure = 0.0; // Pa
+    double fuelUsed = 0.0;           // kg
+    int steps = 0;
+    bool terminatedEarly = false;
+};
+
+struct LaunchOptimizationResult
+{
+    LaunchProfile bestProfile;
+    LaunchEvaluation bestEvaluation;
+    int generations = 0;
+    int evaluations = 0;
+    int earlyTerminations = 0;
+};
+
+// Separable CMA-ES over a parameterized ascent schedule. Each generation is
+// evaluated in parallel; a candidate is abandoned as soon as a provable lower
+// bound on its cost is no better than the best candidate of earlier
+// generations, and then ranks behind every completed candidate.
+class LaunchOptimizer
+{
+public:
+    LaunchOptimizer(OrbitalBody *body,
+                    const LaunchVehicle &vehicle,
+                    const LaunchOptimizerSettings &settings = LaunchOptimizerSettings());
+
+    LaunchOptimizationResult Optimize();
+
+    // Fly one profile; stops early when its cost bound reaches incumbentCost
+    LaunchEvaluation Evaluate(const LaunchProfile &profile, double incumbentCost) const;
+
+    LaunchProfile DecodeProfile(const std::vector<double> &parameters) const;
+
+private:
+    double ApexUpperBound(double altitude, double velocity, double mass, double fuel, double missionTime) const;
+    double CostLowerBound(double apexBound, double maxQ, double fuelUsed) const;
+    double Cost(double apex, double maxQ, double fuelUsed) const;
+
+    void EvaluatePopulation(const std::vector<std::vector<double>> &candidates,
+                            std::vector<LaunchEvaluation> &results);
+    void OfferIncumbent(const std::vector<double> &parameters, const LaunchEvaluation &evaluation);
+
+    OrbitalBody *body;
+    LaunchVehicle vehicle;
+    LaunchOptimizerSettings settings;
+
+    double incumbentCost;
+    std::vector<double> incumbentParameters;
+    LaunchEvaluation incumbentEvaluation;
+};
@@ -0,0 +1,444 @@
+#include "MetricsRegistry.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+namespace
+{
+    std::atomic<uint64_t> nextRegistryId(1);
+
+    // Last shard this thread used; a thread alternating between registries
+    // falls back to the per-registry lookup. Registry ids are never reused,
+    // so entries of destroyed registries are never matched again.
+    thread_local uint64_t cachedOwner = 0;
+    thread_local void *cachedShard = nullptr;
+    thread_local bool shardsReturned = false; // set once this thread's shards were handed back
+
+    // Live registries by id: an exiting thread only hands shards back to
+    // registries that still exist
+    std::mutex &DirectoryMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    std::unordered_map<uint64_t, MetricsRegistry *> &Directory()
+    {
+        static std::unordered_map<uint64_t, MetricsRegistry *> directory;
+        return directory;
+    }
+
+    void Increment(std::atomic<uint64_t> &slot, uint64_t amount)
+    {
+        // Single writer per shard: no read-modify-write needed
+        slot.store(slot.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    std::string Family(const std::string &name)
+    {
+        return name.substr(0, name.find('{'));
+    }
+
+    // `{a="b"}` -> `a="b"`, empty without labels
+    std::string Labels(const std::string &name)
+    {
+        size_t open = name.find('{');
+        if (open == std::string::npos || name.back() != '}')
+            return "";
+        return name.substr(open + 1, name.size() - open - 2);
+    }
+
+    std::string FormatValue(double value)
+    {
+        if (std::isinf(value))
+            return value > 0.0 ? "+Inf" : "-Inf";
+        if (std::isnan(value))
+            return "NaN";
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.17g", value);
+        return text;
+    }
+}
+
+// ==============================
+// Handles
+// ==============================
+void MetricCounter::Add(uint64_t amount) const
+{
+    if (!registry || !registry->IsEnabled())
+        return;
+    if (MetricsRegistry::Shard *shard = registry->LocalShard())
+        Increment(shard->slots[slot], amount);
+}
+
+void MetricHistogram::Observe(double value) const
+{
+    if (!registry || !registry->IsEnabled())
+        return;
+    MetricsRegistry::Shard *shard = registry->LocalShard();
+    if (!shard)
+        return;
+    size_t bucket = std::lower_bound(bounds->begin(), bounds->end(), value) - bounds->begin(); // le is inclusive
+    Increment(shard->slots[slot + bucket], 1);
+
+    std::atomic<uint64_t> &sum = shard->slots[slot + bounds->size() + 1];
+    double total = std::bit_cast<double>(sum.load(std::memory_order_relaxed)) + value;
+    sum.store(std::bit_cast<uint64_t>(total), std::memory_order_relaxed);
+}
+
+// ==============================
+// Registry
+// ==============================
+struct MetricsRegistry::ThreadShards
+{
+    std::unordered_map<uint64_t, Shard *> byRegistry;
+
+    ~ThreadShards()
+    {
+        shardsReturned = true;
+        cachedOwner = 0;
+        cachedShard = nullptr;
+
+        std::lock_guard<std::mutex> lock(DirectoryMutex());
+        for (const auto &[registryId, shard] : byRegistry)
+        {
+            auto found = Directory().find(registryId);
+            if (found != Directory().end())
+                found->second->RetireShard(shard);
+        }
+    }
+};
+
+MetricsRegistry::MetricsRegistry()
+    : id(nextRegistryId++),
+      enabled(true),
+      retired(slotCapacity, 0),
+      nextSlot(0),
+      nextGaugeId(1)
+{
+    std::lock_guard<std::mutex> lock(DirectoryMutex());
+    Directory()[id] = this;
+}
+
+MetricsRegistry::~MetricsRegistry()
+{
+    std::lock_guard<std::mutex> lock(DirectoryMutex());
+    Directory().erase(id);
+}
+
+MetricsRegistry &MetricsRegistry::Global()
+{
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsRegistry::Shard *MetricsRegistry::LocalShard()
+{
+    if (cachedOwner == id)
+        return static_cast<Shard *>(cachedShard);
+    if (shardsReturned)
+        return nullptr; // updates from later thread-exit destructors are dropped
+
+    thread_local ThreadShards threadShards;
+    Shard *&shard = threadShards.byRegistry[id];
+    if (!shard)
+        shard = AcquireShard();
+    cachedOwner = id;
+    cachedShard = shard;
+    return shard;
+}
+
+MetricsRegistry::Shard *MetricsRegistry::AcquireShard()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!freeShards.empty())
+    {
+        Shard *shard = freeShards.back();
+        freeShards.pop_back();
+        return shard;
+    }
+    shards.push_back(std::make_unique<Shard>());
+    return shards.back().get();
+}
+
+// Runs on the exiting owner thread, so its last relaxed stores are visible;
+// readers hold the mutex and see the counts either in the shard or in
+// retired, never both
+void MetricsRegistry::RetireShard(Shard *shard)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const Metric &metric : metrics)
+    {
+        if (metric.kind == Kind::Counter)
+            retired[metric.slot] += shard->slots[metric.slot].load(std::memory_order_relaxed);
+        else if (metric.kind == Kind::Histogram)
+        {
+            uint32_t sumSlot = metric.slot + uint32_t(metric.bounds->size()) + 1;
+            for (uint32_t s = metric.slot; s < sumSlot; ++s)
+                retired[s] += shard->slots[s].load(std::memory_order_relaxed);
+            double sum = std::bit_cast<double>(retired[sumSlot]) +
+                         std::bit_cast<double>(shard->slots[sumSlot].load(std::memory_order_relaxed));
+            retired[sumSlot] = std::bit_cast<uint64_t>(sum);
+        }
+    }
+    for (uint32_t s = 0; s < nextSlot; ++s)
+        shard->slots[s].store(0, std::memory_order_relaxed);
+    freeShards.push_back(shard);
+}
+
+const MetricsRegistry::Metric *MetricsRegistry::Find(const std::string &name) const
+{
+    for (const Metric &metric : metrics)
+        if (metric.name == name)
+            return &metric;
+    return nullptr;
+}
+
+MetricCounter MetricsRegistry::AddCounter(const std::string &name, const std::string &help)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    MetricCounter counter;
+    if (const Metric *existing = Find(name))
+    {
+        if (existing->kind == Kind::Counter)
+        {
+            counter.registry = this;
+            counter.slot = existing->slot;
+        }
+        return counter;
+    }
+    if (nextSlot + 1 > slotCapacity)
+        return counter;
+
+    Metric metric;
+    metric.kind = Kind::Counter;
+    metric.name = name;
+    metric.help = help;
+    metric.slot = nextSlot++;
+    metrics.push_back(std::move(metric));
+
+    counter.registry = this;
+    counter.slot = metrics.back().slot;
+    return counter;
+}
+
+MetricHistogram MetricsRegistry::AddHistogram(const std::string &name,
+                                              const std::string &help,
+                                              const std::vector<double> &bounds)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    MetricHistogram histogram;
+    const Metric *metric = Find(name);
+    if (!metric)
+    {
+        size_t slots = bounds.size() + 2; // buckets, +Inf, sum
+        if (nextSlot + slots > slotCapacity || !std::is_sorted(bounds.begin(), bounds.end()))
+            return histogram;
+
+        Metric added;
+        added.kind = Kind::Histogram;
+        added.name = name;
+        added.help = help;
+        added.slot = nextSlot;
+        added.bounds = std::make_unique<std::vector<double>>(bounds);
+        nextSlot += uint32_t(slots);
+        metrics.push_back(std::move(added));
+        metric = &metrics.back();
+    }
+    if (metric->kind != Kind::Histogram)
+        return histogram;
+
+    histogram.registry = this;
+    histogram.slot = metric->slot;
+    histogram.bounds = metric->bounds.get();
+    return histogram;
+}
+
+int MetricsRegistry::AddGauge(const std::string &name, const std::string &help, std::function<double()> sample)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (Find(name))
+        return 0;
+
+    Metric metric;
+    metric.kind = Kind::Gauge;
+    metric.name = name;
+    metric.help = help;
+    metric.sample = std::move(sample);
+    metric.gaugeId = nextGaugeId++;
+    metrics.push_back(std::move(metric));
+    return metrics.back().gaugeId;
+}
+
+void MetricsRegistry::RemoveGauge(int gaugeId)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    metrics.erase(std::remove_if(metrics.begin(), metrics.end(), [&](const Metric &metric)
+                                 { return metric.kind == Kind::Gauge && metric.gaugeId == gaugeId; }),
+                  metrics.end());
+}
+
+uint64_t MetricsRegistry::Sum(uint32_t slot) const
+{
+    uint64_t total = retired[slot];
+    for (const std::unique_ptr<Shard> &shard : shards)
+        total += shard->slots[slot].load(std::memory_order_relaxed);
+    return total;
+}
+
+double MetricsRegistry::SumDouble(uint32_t slot) const
+{
+    double total = std::bit_cast<double>(retired[slot]);
+    for (const std::unique_ptr<Shard> &shard : shards)
+        total += std::bit_cast<double>(shard->slots[slot].load(std::memory_order_relaxed));
+    return total;
+}
+
+uint64_t MetricsRegistry::ReadCounter(const std::string &name) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const Metric *metric = Find(name);
+    return metric && metric->kind == Kind::Counter ? Sum(metric->slot) : 0;
+}
+
+size_t MetricsRegistry::GetShardCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return shards.size();
+}
+
+std::string MetricsRegistry::Export() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // One HELP/TYPE block per family, members in registration order
+    std::vector<const Metric *> ordered;
+    for (const Metric &metric : metrics)
+        ordered.push_back(&metric);
+    std::stable_sort(ordered.begin(), ordered.end(), [](const Metric *a, const Metric *b)
+                     { return Family(a->name) < Family(b->name); });
+
+    std::string out;
+    std::string previousFamily;
+    for (const Metric *metric : ordered)
+    {
+        std::string family = Family(metric->name);
+        std::string labels = Labels(metric->name);
+        if (family != previousFamily)
+        {
+            const char *type = metric->kind == Kind::Counter ? "counter" : metric->kind == Kind::Histogram ? "histogram"
+                                                                                                            : "gauge";
+            out += "# HELP " + family + " " + metric->help + "\n";
+            out += "# TYPE " + family + " " + type + "\n";
+            previousFamily = family;
+        }
+
+        switch (metric->kind)
+        {
+        case Kind::Counter:
+            out += metric->name + " " + std::to_string(Sum(metric->slot)) + "\n";
+            break;
+        case Kind::Gauge:
+            out += metric->name + " " + FormatValue(metric->sample()) + "\n";
+            break;
+        case Kind::Histogram:
+        {
+            std::string prefix = labels.empty() ? "" : labels + ",";
+            uint64_t cumulative = 0;
+            for (size_t b = 0; b <= metric->bounds->size(); ++b)
+            {
+                cumulative += Sum(metric->slot + uint32_t(b));
+                double bound = b < metric->bounds->size() ? (*metric->bounds)[b] : INFINITY;
+                out += family + "_bucket{" + prefix + "le=\"" + FormatValue(bound) + "\"} " + std::to_string(cumulative) + "\n";
+            }
+            std::string suffix = labels.empty() ? "" : "{" + labels + "}";
+            out += family + "_sum" + suffix + " " + FormatValue(SumDouble(metric->slot + uint32_t(metric->bounds->size()) + 1)) + "\n";
+            out += family + "_count" + suffix + " " + std::to_string(cumulative) + "\n";
+            break;
+        }
+        }
+    }
+    return out;
+}
+
+std::vector<double> MetricsRegistry::ExponentialBuckets(double start, double factor, int count)
+{
+    std::vector<double> bounds;
+    for (int i = 0; i < count; ++i, start *= factor)
+        bounds.push_back(start);
+    return bounds;
+}
+
+// ==============================
+// Exporter
+// ==============================
+MetricsExporter::MetricsExporter(const MetricsRegistry &registry, const std::string &path, double intervalSeconds)
+    : registry(registry),
+      path(path),
+      intervalSeconds(intervalSeconds),
+      stopping(false),
+      writeCount(0)
+{
+}
+
+MetricsExporter::~MetricsExporter()
+{
+    Stop();
+}
+
+bool MetricsExporter::Start()
+{
+    if (thread.joinable() || !WriteNow())
+        return false;
+    stopping = false;
+    thread = std::thread(&MetricsExporter::Loop, this);
+    return true;
+}
+
+void MetricsExporter::Stop()
+{
+    if (!thread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    thread.join();
+    WriteNow();
+}
+
+bool MetricsExporter::WriteNow()
+{
+    std::string text = registry.Export();
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.write(text.data(), text.size()))
+            return false;
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error)
+        return false;
+    ++writeCount;
+    return true;
+}
+
+void MetricsExporter::Loop()
+{
+    auto interval = std::chrono::duration<double>(intervalSeconds);
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!wake.wait_for(lock, interval, [&]
+                          { return stopping; }))
+    {
+        lock.unlock();
+        WriteNow();
+        lock.lock();
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class MetricsRegistry;
+
+// Handles are cheap to copy; a default-constructed or failed registration
+// gives an inert handle that ignores updates
+class MetricCounter
+{
+public:
+    void Add(uint64_t amount = 1) const;
+
+private:
+    friend class MetricsRegistry;
+    MetricsRegistry *registry = nullptr;
+    uint32_t slot = 0;
+};
+
+class MetricHistogram
+{
+public:
+    void Observe(double value) const;
+
+private:
+    friend class MetricsRegistry;
+    MetricsRegistry *registry = nullptr;
+    uint32_t slot = 0; // buckets (last is +Inf), then the sum
+    const std::vector<double> *bounds = nullptr;
+};
+
+// Named counters, histograms and gauges for long-running sweeps. Every thread
+// that updates a metric gets its own shard of slots, so an update is a
+// relaxed load and store on a cache line no other thread writes; readers sum
+// the shards. When a thread exits, its counts fold into a retired total and
+// its shard goes on a free list, so short-lived worker threads do not grow
+// memory or export cost. Gauges are callbacks sampled at export time. Names
+// may carry a Prometheus label set, e.g.
+// `physicssim_trajectories_total{outcome="crashed"}`.
+class MetricsRegistry
+{
+public:
+    static constexpr size_t slotCapacity = 1024; // per shard, shared by all metrics
+
+    MetricsRegistry();
+    ~MetricsRegistry();
+    MetricsRegistry(const MetricsRegistry &) = delete;
+    MetricsRegistry &operator=(const MetricsRegistry &) = delete;
+
+    // Process-wide registry the simulation modules report into
+    static MetricsRegistry &Global();
+
+    // Registering an existing name returns the existing metric
+    MetricCounter AddCounter(const std::string &name, const std::string &help);
+    MetricHistogram AddHistogram(const std::string &name, const std::string &help, const std::vector<double> &bounds);
+    int AddGauge(const std::string &name, const std::string &help, std::function<double()> sample);
+    void RemoveGauge(int id);
+
+    // Disabled registries drop updates; for measuring their overhead
+    void SetEnabled(bool enabled) { this->enabled.store(enabled, std::memory_order_relaxed); }
+    bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    uint64_t ReadCounter(const std::string &name) const; // 0 when unknown
+    size_t GetShardCount() const; // allocated, in use or free
+
+    // Prometheus text exposition format, version 0.0.4
+    std::string Export() const;
+
+    static std::vector<double> ExponentialBuckets(double start, double factor, int count);
+
+private:
+    friend class MetricCounter;
+    friend class MetricHistogram;
+
+    struct alignas(64) Shard
+    {
+        std::atomic<uint64_t> slots[slotCapacity]; // zeroed by the C++20 default constructor
+    };
+
+    enum class Kind
+    {
+        Counter,
+        Histogram,
+        Gauge
+    };
+
+    struct Metric
+    {
+        Kind kind = Kind::Counter;
+        std::string name; // including labels
+        std::string help;
+        uint32_t slot = 0;
+        std::unique_ptr<std::vector<double>> bounds; // histograms
+        std::function<double()> sample;              // gauges
+        int gaugeId = 0;
+    };
+
+    struct ThreadShards; // this thread's shard per registry, handed back at thread exit
+
+    Shard *LocalShard(); // nullptr while the thread is being torn down
+    Shard *AcquireShard();
+    void RetireShard(Shard *shard);
+    const Metric *Find(const std::string &name) const;
+    uint64_t Sum(uint32_t slot) const;
+    double SumDouble(uint32_t slot) const;
+
+    const uint64_t id; // tells thread-local shard caches apart across registries
+    std::atomic<bool> enabled;
+
+    mutable std::mutex mutex; // metrics, shards and slot allocation
+    std::vector<Metric> metrics;
+    std::vector<std::unique_ptr<Shard>> shards; // every shard, in use or free
+    std::vector<Shard *> freeShards;            // zeroed, for the next thread
+    std::vector<uint64_t> retired;              // counts of exited threads, laid out like a shard
+    uint32_t nextSlot;
+    int nextGaugeId;
+};
+
+// Background thread writing the registry's exposition text to a file every
+// interval, via a temporary file and rename so scrapers (for example the
+// node exporter's textfile collector) never see a partial write
+class MetricsExporter
+{
+public:
+    MetricsExporter(const MetricsRegistry &registry, const std::string &path, double intervalSeconds);
+    ~MetricsExporter();
+
+    bool Start();
+    void Stop(); // writes a final snapshot
+    bool WriteNow();
+
+    uint64_t GetWriteCount() const { return writeCount.load(); }
+
+private:
+    void Loop();
+
+    const MetricsRegistry &registry;
+    std::string path;
+    double intervalSeconds;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping;
+    std::thread thread;
+    std::atomic<uint64_t> writeCount;
+};
@@ -0,0 +1,192 @@
+#include "MissionScript.h"
+#include <OrbitalBody.h>
+#include <Vessel.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+// ==============================
+// Conditions
+// ==============================
+bool MissionCondition::IsMet(const Vessel &vessel, double time) const
+{
+    switch (kind)
+    {
+    case Kind::Delay:
+        return time >= waitStartTime + threshold;
+    case Kind::FuelBelowPercent:
+        return vessel.GetFuelPercent() < threshold;
+    case Kind::Apex:
+        return vessel.GetVelocity() <= 0.0;
+    case Kind::AltitudeBelow:
+        return vessel.GetAltitude() < threshold;
+    }
+    return true;
+}
+
+double MissionCondition::EarliestTime(const Vessel &vessel, double time) const
+{
+    constexpr double never = std::numeric_limits<double>::infinity();
+    const OrbitalBody *body = vessel.GetParentBody();
+
+    switch (kind)
+    {
+    case Kind::Delay:
+        return waitStartTime + threshold;
+
+    case Kind::FuelBelowPercent:
+    {
+        // Mass flow only depends on throttle, so burn time is exact
+        double flow = vessel.GetEngine().ComputeMassFlowRate(0.0);
+        if (flow <= 0.0 || vessel.GetFuelMass() <= 0.0)
+            return never;
+        double targetFuel = threshold / 100.0 * vessel.GetInitialFuelMass();
+        return time + std::max(0.0, vessel.GetFuelMass() - targetFuel) / flow;
+    }
+
+    case Kind::Apex:
+    {
+        // Gravity and drag both shrink as the vessel climbs and slows, so
+        // today's deceleration bounds the rest of the coast.
+        double deceleration = body->ComputeGravitationalAcceleration(vessel.GetAltitude()) +
+                              vessel.GetLastDragAcceleration();
+        return time + std::max(0.0, vessel.GetVelocity()) / deceleration;
+    }
+
+    case Kind::AltitudeBelow:
+    {
+        // Fastest way down: free fall from the current descent rate
+        double drop = vessel.GetAltitude() - threshold;
+        double descentRate = std::max(0.0, -vessel.GetVelocity());
+        double g = body->ComputeGravitationalAcceleration(std::max(0.0, threshold));
+        return time + (std::sqrt(descentRate * descentRate + 2.0 * g * drop) - descentRate) / g;
+    }
+    }
+    return time;
+}
+
+MissionAwaiter WaitSeconds(double seconds)
+{
+    return {{MissionCondition::Kind::Delay, seconds}};
+}
+
+MissionAwaiter WaitUntilFuelBelow(double percent)
+{
+    return {{MissionCondition::Kind::FuelBelowPercent, percent}};
+}
+
+MissionAwaiter WaitUntilApex()
+{
+    return {{MissionCondition::Kind::Apex, 0.0}};
+}
+
+MissionAwaiter WaitUntilAltitudeBelow(double altitudeMeters)
+{
+    return {{MissionCondition::Kind::AltitudeBelow, altitudeMeters}};
+}
+
+bool MissionAwaiter::await_suspend(std::coroutine_handle<MissionScript::promise_type> handle)
+{
+    MissionScript::promise_type &promise = handle.promise();
+    double time = promise.scheduler->GetTime();
+
+    condition.waitStartTime = time;
+    if (condition.IsMet(*promise.vessel, time))
+        return false; // keep running
+
+    promise.waiting = condition;
+    return true;
+}
+
+// ==============================
+// Script handle
+// ==============================
+MissionScript::MissionScript(MissionScript &&other) noexcept
+    : handle(std::exchange(other.handle, nullptr)) {}
+
+MissionScript &MissionScript::operator=(MissionScript &&other) noexcept
+{
+    if (this != &other)
+    {
+        if (handle)
+            handle.destroy();
+        handle = std::exchange(other.handle, nullptr);
+    }
+    return *this;
+}
+
+MissionScript::~MissionScript()
+{
+    if (handle)
+        handle.destroy();
+}
+
+bool MissionScript::IsDone() const
+{
+    return !handle || handle.done();
+}
+
+// ==============================
+// Scheduler
+// ==============================
+MissionScheduler::MissionScheduler(double maxSleepSeconds)
+    : maxSleep(maxSleepSeconds),
+      now(0.0),
+      conditionChecks(0),
+      resumes(0),
+      running(0) {}
+
+void MissionScheduler::Add(MissionScript script)
+{
+    script.handle.promise().scheduler = this;
+    scripts.push_back(std::move(script));
+    ++running;
+    Resume(scripts.size() - 1);
+}
+
+void MissionScheduler::Resume(size_t script)
+{
+    MissionScript &entry = scripts[script];
+    entry.handle.resume();
+    ++resumes;
+
+    if (entry.IsDone())
+    {
+        --running;
+        return;
+    }
+
+    const MissionScript::promise_type &promise = entry.handle.promise();
+    double wake = promise.waiting.EarliestTime(*promise.vessel, now);
+    wakeQueue.push({std::min(wake, now + maxSleep), script});
+}
+
+void MissionScheduler::Advance(double time)
+{
+    now = time;
+
+    while (!wakeQueue.empty() && wakeQueue.top().time <= now)
+    {
+        size_t script = wakeQueue.top().script;
+        wakeQueue.pop();
+
+        const MissionScript::promise_type &promise = scripts[script].handle.promise();
+        ++conditionChecks;
+        if (promise.waiting.IsMet(*promise.vessel, now))
+        {
+            Resume(script);
+        }
+        else
+        {
+            double wake = promise.waiting.EarliestTime(*promise.vessel, now);
+            wakeQueue.push({std::clamp(wake, std::nextafter(now, now + 1.0), now + maxSleep), script});
+        }
+    }
+}
+
+double MissionScheduler::GetTime() const { return now; }
+size_t MissionScheduler::GetScriptCount() const { return scripts.size(); }
+size_t MissionScheduler::GetRunningCount() const { return running; }
+size_t MissionScheduler::GetConditionChecks() const { return conditionChecks; }
+size_t MissionScheduler::GetResumes() const { return resumes; }
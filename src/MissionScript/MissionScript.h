@@ -0,0 +1,130 @@
+#pragma once
+#include <coroutine>
+#include <cstddef>
+#include <functional>
+#include <queue>
+#include <vector>
+
+class Vessel;
+class MissionScheduler;
+
+// What a suspended mission script is waiting for
+struct MissionCondition
+{
+    enum class Kind
+    {
+        Delay,            // threshold = seconds after the wait started
+        FuelBelowPercent, // threshold = % of initial fuel
+        Apex,             // vertical velocity reaches zero
+        AltitudeBelow     // threshold = m
+    };
+
+    Kind kind = Kind::Delay;
+    double threshold = 0.0;
+    double waitStartTime = 0.0;
+
+    bool IsMet(const Vessel &vessel, double time) const;
+
+    // Earliest simulation time at which the condition could become true,
+    // from conservative bounds on how fast the watched quantity can change.
+    double EarliestTime(const Vessel &vessel, double time) const;
+};
+
+// Coroutine type for mission scripts. A script's first parameter is the
+// vessel it flies:
+//
+//     MissionScript Ascent(Vessel &vessel)
+//     {
+//         co_await WaitUntilFuelBelow(10.0);
+//         vessel.SetThrottle(0.0);
+//     }
+class MissionScript
+{
+public:
+    struct promise_type
+    {
+        template <typename... Args>
+        promise_type(Vessel &flown, Args &...) : vessel(&flown) {}
+
+        MissionScript get_return_object()
+        {
+            return MissionScript(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { throw; }
+
+        Vessel *vessel;
+        MissionScheduler *scheduler = nullptr;
+        MissionCondition waiting;
+    };
+
+    MissionScript(MissionScript &&other) noexcept;
+    MissionScript &operator=(MissionScript &&other) noexcept;
+    MissionScript(const MissionScript &) = delete;
+    MissionScript &operator=(const MissionScript &) = delete;
+    ~MissionScript();
+
+    bool IsDone() const;
+
+private:
+    friend class MissionScheduler;
+    explicit MissionScript(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+// co_await target: suspends unless the condition already holds
+struct MissionAwaiter
+{
+    MissionCondition condition;
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<MissionScript::promise_type> handle);
+    void await_resume() const noexcept {}
+};
+
+MissionAwaiter WaitSeconds(double seconds);
+MissionAwaiter WaitUntilFuelBelow(double percent);
+MissionAwaiter WaitUntilApex();
+MissionAwaiter WaitUntilAltitudeBelow(double altitudeMeters);
+
+// Resumes scripts only when their wait condition can fire. Suspended scripts
+// sit in a queue ordered by their earliest possible wake time, so a step
+// touches only the scripts that are due instead of polling every one.
+class MissionScheduler
+{
+public:
+    explicit MissionScheduler(double maxSleepSeconds = 10.0);
+
+    // Takes ownership and runs the script up to its first wait
+    void Add(MissionScript script);
+
+    // Call after stepping the vessels to the given simulation time
+    void Advance(double time);
+
+    double GetTime() const;
+    size_t GetScriptCount() const;
+    size_t GetRunningCount() const;
+    size_t GetConditionChecks() const;
+    size_t GetResumes() const;
+
+private:
+    struct Wake
+    {
+        double time;
+        size_t script;
+        bool operator>(const Wake &other) const { return time > other.time; }
+    };
+
+    void Resume(size_t script);
+
+    double maxSleep; // s, re-check bound for externally changed vessels
+    double now;
+    size_t conditionChecks;
+    size_t resumes;
+    size_t running;
+    std::vector<MissionScript> scripts;
+    std::priority_queue<Wake, std::vector<Wake>, std::greater<Wake>> wakeQueue;
+};
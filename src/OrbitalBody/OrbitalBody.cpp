@@ -1,9 +1,13 @@
 #include "OrbitalBody.h"
+#include <ChebyshevEphemeris.h>
+#include <cmath>
+#include <vector>
 
 const double Gravity = 6.67430e-11;
 
 OrbitalBody::OrbitalBody(double m, double r, Atmosphere *a)
-    : mass(m), radius(r), atmosphere(a) {}
+    : mass(m), radius(r), atmosphere(a),
+      j2(0.0), rotationRate(0.0), rotationAtEpoch(0.0), ephemerisEpoch(0.0) {}
 
 double OrbitalBody::ComputeGravitationalAcceleration(double altitude) const
 {
@@ -11,6 +15,110 @@ double OrbitalBody::ComputeGravitationalAcceleration(double altitude) const
     return Gravity * mass / (distance * distance);
 }
 
+double OrbitalBody::ComputeGravitationalAcceleration(double altitude,
+                                                     double latitudeDeg,
+                                                     double longitudeDeg,
+                                                     double missionTime) const
+{
+    if (!HasPerturbations())
+        return ComputeGravitationalAcceleration(altitude);
+
+    Vector3 position = ComputeSitePosition(altitude, latitudeDeg, longitudeDeg, missionTime);
+    Vector3 up = position.Normalized();
+    return -ComputeGravitationalAccelerationVector(position, missionTime).Dot(up);
+}
+
+void OrbitalBody::ComputeGravitationalAccelerations(const double *altitudes,
+                                                   double *out,
+                                                   size_t count,
+                                                   double latitudeDeg,
+                                                   double longitudeDeg,
+                                                   double missionTime) const
+{
+    if (!HasPerturbations())
+    {
+        for (size_t i = 0; i < count; ++i)
+            out[i] = ComputeGravitationalAcceleration(altitudes[i]);
+        return;
+    }
+
+    thread_local std::vector<Vector3> sources;
+    sources.clear();
+    double ephemerisTime = ephemerisEpoch + missionTime;
+    for (const ThirdBody &body : thirdBodies)
+        sources.push_back(body.ephemeris->Evaluate(ephemerisTime));
+
+    // ComputeSitePosition with the site's trigonometry hoisted out
+    double latitude = latitudeDeg * M_PI / 180.0;
+    double longitude = longitudeDeg * M_PI / 180.0 + rotationAtEpoch + rotationRate * missionTime;
+    double cosLatitude = std::cos(latitude), sinLatitude = std::sin(latitude);
+    double cosLongitude = std::cos(longitude), sinLongitude = std::sin(longitude);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        double distance = radius + altitudes[i];
+        Vector3 position(distance * cosLatitude * cosLongitude,
+                         distance * cosLatitude * sinLongitude,
+                         distance * sinLatitude);
+        Vector3 up = position.Normalized();
+        out[i] = -AccumulateAcceleration(position, [&](size_t k)
+                                         { return sources[k]; })
+                      .Dot(up);
+    }
+}
+
+Vector3 OrbitalBody::ComputeGravitationalAccelerationVector(const Vector3 &position, double missionTime) const
+{
+    double ephemerisTime = ephemerisEpoch + missionTime;
+    return AccumulateAcceleration(position, [&](size_t k)
+                                  { return thirdBodies[k].ephemeris->Evaluate(ephemerisTime); });
+}
+
+template <typename SourceAt>
+Vector3 OrbitalBody::AccumulateAcceleration(const Vector3 &position, SourceAt sourceAt) const
+{
+    double mu = GetGravitationalParameter();
+    double r2 = position.Dot(position);
+    double r = std::sqrt(r2);
+    Vector3 acceleration = position * (-mu / (r2 * r));
+
+    // === J2 oblateness ===
+    if (j2 != 0.0)
+    {
+        double zr2 = position.z * position.z / r2;
+        double factor = -1.5 * j2 * mu * radius * radius / (r2 * r2 * r);
+        acceleration = acceleration + Vector3(position.x * factor * (1.0 - 5.0 * zr2),
+                                              position.y * factor * (1.0 - 5.0 * zr2),
+                                              position.z * factor * (3.0 - 5.0 * zr2));
+    }
+
+    // === Third bodies: pull on the vessel minus pull on this body ===
+    for (size_t k = 0; k < thirdBodies.size(); ++k)
+    {
+        const ThirdBody &body = thirdBodies[k];
+        Vector3 s = sourceAt(k);
+        Vector3 d = s - position;
+        double dLength = d.Length();
+        double sLength = s.Length();
+        acceleration = acceleration + d * (body.gravitationalParameter / (dLength * dLength * dLength)) -
+                       s * (body.gravitationalParameter / (sLength * sLength * sLength));
+    }
+    return acceleration;
+}
+
+Vector3 OrbitalBody::ComputeSitePosition(double altitude,
+                                         double latitudeDeg,
+                                         double longitudeDeg,
+                                         double missionTime) const
+{
+    double latitude = latitudeDeg * M_PI / 180.0;
+    double longitude = longitudeDeg * M_PI / 180.0 + rotationAtEpoch + rotationRate * missionTime;
+    double distance = radius + altitude;
+    return Vector3(distance * std::cos(latitude) * std::cos(longitude),
+                   distance * std::cos(latitude) * std::sin(longitude),
+                   distance * std::sin(latitude));
+}
+
 double OrbitalBody::ComputeAtmosphericPressure(double altitude) const
 {
     if (atmosphere)
@@ -18,6 +126,33 @@ double OrbitalBody::ComputeAtmosphericPressure(double altitude) const
     return 0.0;
 }
 
+void OrbitalBody::SetOblateness(double oblateness)
+{
+    j2 = oblateness;
+}
+
+void OrbitalBody::SetRotation(double radiansPerSecond, double angleAtEpochRadians)
+{
+    rotationRate = radiansPerSecond;
+    rotationAtEpoch = angleAtEpochRadians;
+}
+
+void OrbitalBody::SetEphemerisEpoch(double secondsSinceJ2000)
+{
+    ephemerisEpoch = secondsSinceJ2000;
+}
+
+void OrbitalBody::AddThirdBody(double gravitationalParameter, const ChebyshevEphemeris *ephemeris)
+{
+    if (ephemeris && !ephemeris->IsEmpty())
+        thirdBodies.push_back({gravitationalParameter, ephemeris});
+}
+
+bool OrbitalBody::HasPerturbations() const
+{
+    return j2 != 0.0 || !thirdBodies.empty();
+}
+
 Atmosphere *OrbitalBody::GetAtmosphere() const
 {
     return atmosphere;
@@ -26,4 +161,9 @@ Atmosphere *OrbitalBody::GetAtmosphere() const
 double OrbitalBody::GetRadius() const
 {
     return radius;
-}
\ No newline at end of file
+}
+
+double OrbitalBody::GetGravitationalParameter() const
+{
+    return Gravity * mass;
+}
@@ -1,21 +1,80 @@
 #pragma once
+#include <vector>
 #include <Atmosphere.h>
+#include <Vector3.h>
+
+class ChebyshevEphemeris;
+
+// Perturbing body, positioned relative to this one by an ephemeris
+struct ThirdBody
+{
+    double gravitationalParameter;       // m³/s²
+    const ChebyshevEphemeris *ephemeris; // not owned
+};
 
 class OrbitalBody
 {
 public:
     OrbitalBody(double massKg, double radiusMeters, Atmosphere *atmosphere = nullptr);
 
+    // Point mass, straight down
     double ComputeGravitationalAcceleration(double altitudeMeters) const;
 
+    // Downward component along the local vertical at a surface site,
+    // including J2 and third-body terms when configured. Horizontal
+    // components are dropped: vessels fly a vertical line.
+    double ComputeGravitationalAcceleration(double altitudeMeters,
+                                            double latitudeDeg,
+                                            double longitudeDeg,
+                                            double missionTimeSeconds) const;
+
+    // The above for a batch of altitudes at one site and time; third-body
+    // positions are evaluated once for the batch. Same results per sample.
+    void ComputeGravitationalAccelerations(const double *altitudesMeters,
+                                           double *out,
+                                           size_t count,
+                                           double latitudeDeg,
+                                           double longitudeDeg,
+                                           double missionTimeSeconds) const;
+
+    // Full acceleration at a position in the body-centred equatorial frame
+    Vector3 ComputeGravitationalAccelerationVector(const Vector3 &position, double missionTimeSeconds) const;
+
+    // Site at altitude in the body-centred equatorial frame (Z along the
+    // spin axis), rotated to mission time
+    Vector3 ComputeSitePosition(double altitudeMeters,
+                                double latitudeDeg,
+                                double longitudeDeg,
+                                double missionTimeSeconds) const;
+
     double ComputeAtmosphericPressure(double altitudeMeters) const;
 
+    // === Higher-fidelity gravity (all off by default) ===
+    void SetOblateness(double j2);
+    // Longitude 0 lies at angleAtEpoch from the frame's X axis at mission time 0
+    void SetRotation(double radiansPerSecond, double angleAtEpochRadians = 0.0);
+    // Ephemeris time (s since J2000) at mission time 0
+    void SetEphemerisEpoch(double secondsSinceJ2000);
+    void AddThirdBody(double gravitationalParameter, const ChebyshevEphemeris *ephemeris);
+    bool HasPerturbations() const;
+
     Atmosphere *GetAtmosphere() const;
 
     double GetRadius() const;
+    double GetGravitationalParameter() const;
 
 private:
+    // sourceAt(k) is third body k's position at the time of interest
+    template <typename SourceAt>
+    Vector3 AccumulateAcceleration(const Vector3 &position, SourceAt sourceAt) const;
+
     double mass;
     double radius;
     Atmosphere *atmosphere;
+
+    double j2;
+    double rotationRate;       // rad/s
+    double rotationAtEpoch;    // rad
+    double ephemerisEpoch;     // s since J2000
+    std::vector<ThirdBody> thirdBodies;
 };
@@ -0,0 +1,168 @@
+#include "Parareal.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double SecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // Step a private copy of the prototype from `state` to `endTime`, or
+    // until ground contact
+    VesselState Propagate(const Vessel &prototype, const VesselState &state, double endTime, double deltaTime)
+    {
+        thread_local ComponentArena components(1, 1);
+        components.Reset();
+
+        Vessel vessel = prototype;
+        vessel.CopyComponentsTo(components);
+        vessel.SetState(state);
+
+        // Count steps rather than accumulating time so slice ends line up; a
+        // slice that is not a whole number of steps ends on a short step
+        double span = endTime - state.missionTime;
+        long steps = static_cast<long>(std::ceil(span / deltaTime - 1e-9));
+        for (long i = 0; i < steps && vessel.GetAltitude() > 0.0; ++i)
+            vessel.Update(std::min(deltaTime, span - i * deltaTime));
+
+        return vessel.GetState();
+    }
+
+    // U = G(new) + F(old) - G(old), on the continuous components
+    VesselState Correct(const VesselState &coarseNew, const VesselState &fineOld, const VesselState &coarseOld)
+    {
+        auto blend = [](double g, double f, double gOld) { return g + (f - gOld); };
+
+        VesselState state;
+        state.altitude = blend(coarseNew.altitude, fineOld.altitude, coarseOld.altitude);
+        state.velocity = blend(coarseNew.velocity, fineOld.velocity, coarseOld.velocity);
+        state.fuelMass = std::max(0.0, blend(coarseNew.fuelMass, fineOld.fuelMass, coarseOld.fuelMass));
+        state.totalHeatLoad = std::max(0.0, blend(coarseNew.totalHeatLoad, fineOld.totalHeatLoad, coarseOld.totalHeatLoad));
+        state.heatShieldMass = std::max(0.0, blend(coarseNew.heatShieldMass, fineOld.heatShieldMass, coarseOld.heatShieldMass));
+        state.ablatedMass = std::max(0.0, blend(coarseNew.ablatedMass, fineOld.ablatedMass, coarseOld.ablatedMass));
+        state.missionTime = blend(coarseNew.missionTime, fineOld.missionTime, coarseOld.missionTime);
+        state.parachuteDeployed = fineOld.parachuteDeployed || coarseNew.parachuteDeployed;
+        return state;
+    }
+
+    // Largest relative component change, with a unit floor so quantities
+    // passing through zero do not dominate
+    double Defect(const VesselState &a, const VesselState &b)
+    {
+        auto relative = [](double x, double y) { return std::abs(x - y) / (std::max(std::abs(x), std::abs(y)) + 1.0); };
+
+        double defect = std::max({relative(a.altitude, b.altitude),
+                                  relative(a.velocity, b.velocity),
+                                  relative(a.fuelMass, b.fuelMass),
+                                  relative(a.totalHeatLoad, b.totalHeatLoad),
+                                  relative(a.heatShieldMass, b.heatShieldMass),
+                                  relative(a.missionTime, b.missionTime)});
+        if (a.parachuteDeployed != b.parachuteDeployed)
+            defect = std::max(defect, 1.0);
+        return defect;
+    }
+
+    template <typename Job>
+    void ParallelFor(int begin, int end, int threadCount, Job job)
+    {
+        std::atomic<int> next{begin};
+        auto worker = [&]()
+        {
+            for (int i = next++; i < end; i = next++)
+                job(i);
+        };
+
+        std::vector<std::thread> threads;
+        for (int t = 1; t < std::min(threadCount, end - begin); ++t)
+            threads.emplace_back(worker);
+        worker();
+        for (std::thread &thread : threads)
+            thread.join();
+    }
+}
+
+VesselState PropagateSerial(const Vessel &prototype, const VesselState &initialState, double endTime, double deltaTime)
+{
+    return Propagate(prototype, initialState, endTime, deltaTime);
+}
+
+PararealResult RunParareal(const Vessel &prototype, const VesselState &initialState, const PararealSettings &settings)
+{
+    Clock::time_point runStart = Clock::now();
+
+    int hardwareThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    int threadCount = settings.threadCount > 0 ? settings.threadCount : hardwareThreads;
+    int sliceCount = settings.sliceCount > 0 ? settings.sliceCount : 4 * threadCount;
+    int maxIterations = settings.maxIterations > 0 ? std::min(settings.maxIterations, sliceCount) : sliceCount;
+    double sliceLength = (settings.endTime - settings.startTime) / sliceCount;
+
+    auto sliceEnd = [&](int slice) { return settings.startTime + sliceLength * (slice + 1); };
+
+    PararealResult result;
+    std::vector<VesselState> &boundaries = result.boundaries;
+    boundaries.resize(sliceCount + 1);
+    boundaries[0] = initialState;
+    boundaries[0].missionTime = settings.startTime;
+
+    // === Initial coarse sweep ===
+    std::vector<VesselState> coarse(sliceCount); // G(U_n) from the last sweep
+    for (int n = 0; n < sliceCount; ++n)
+    {
+        coarse[n] = Propagate(prototype, boundaries[n], sliceEnd(n), settings.coarseDeltaTime);
+        boundaries[n + 1] = coarse[n];
+    }
+    result.coarseSeconds = SecondsSince(runStart);
+
+    // === Parareal iterations ===
+    // After iteration k the first k boundaries equal the serial fine
+    // solution, so only the remaining slices are refined.
+    std::vector<VesselState> fine(sliceCount);
+    for (int k = 0; k < maxIterations; ++k)
+    {
+        Clock::time_point iterationStart = Clock::now();
+
+        ParallelFor(k, sliceCount, threadCount, [&](int n)
+                    { fine[n] = Propagate(prototype, boundaries[n], sliceEnd(n), settings.fineDeltaTime); });
+
+        PararealIteration diagnostics;
+        diagnostics.iteration = k + 1;
+        diagnostics.fineSlices = sliceCount - k;
+
+        // The slice after the first refined one is exact; correct the rest
+        boundaries[k + 1] = fine[k];
+        for (int n = k + 1; n < sliceCount; ++n)
+        {
+            VesselState coarseNew = Propagate(prototype, boundaries[n], sliceEnd(n), settings.coarseDeltaTime);
+            VesselState corrected = Correct(coarseNew, fine[n], coarse[n]);
+            coarse[n] = coarseNew;
+
+            double defect = Defect(corrected, boundaries[n + 1]);
+            if (defect > diagnostics.maxDefect)
+            {
+                diagnostics.maxDefect = defect;
+                diagnostics.worstSlice = n;
+            }
+            boundaries[n + 1] = corrected;
+        }
+
+        diagnostics.seconds = SecondsSince(iterationStart);
+        result.iterations.push_back(diagnostics);
+
+        if (diagnostics.maxDefect <= settings.tolerance)
+        {
+            result.converged = true;
+            break;
+        }
+    }
+
+    result.finalState = boundaries[sliceCount];
+    result.totalSeconds = SecondsSince(runStart);
+    return result;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <Vessel.h>
+#include <vector>
+
+struct PararealSettings
+{
+    double startTime = 0.0;    // s, mission time of the initial state
+    double endTime = 600.0;    // s
+    int sliceCount = 0;        // 0 = 4 slices per hardware thread
+    double fineDeltaTime = 0.01; // s, the reference serial step
+    double coarseDeltaTime = 1.0; // s, seeds and corrects slice boundaries
+    int maxIterations = 0;     // 0 = sliceCount (exact serial agreement)
+    double tolerance = 1e-6;   // relative change of all slice boundaries
+    int threadCount = 0;       // 0 = hardware concurrency
+};
+
+struct PararealIteration
+{
+    int iteration = 0;
+    double maxDefect = 0.0; // largest relative boundary change this iteration
+    int worstSlice = 0;     // slice whose end state changed the most
+    int fineSlices = 0;     // slices propagated with the fine step
+    double seconds = 0.0;   // wall time of the iteration
+};
+
+struct PararealResult
+{
+    VesselState finalState;
+    std::vector<VesselState> boundaries; // sliceCount + 1 slice boundary states
+    std::vector<PararealIteration> iterations;
+    bool converged = false;
+    double coarseSeconds = 0.0; // initial coarse sweep
+    double totalSeconds = 0.0;
+};
+
+// Parallel-in-time propagation of one long trajectory. A coarse propagator
+// (the same Vessel::Update at a large step) seeds the slice boundaries; each
+// iteration refines all unconverged slices concurrently at the fine step and
+// sweeps the Parareal correction G(new) + F(old) - G(old) across boundaries.
+//
+// The prototype vessel is copied for every slice and never stepped itself.
+// Its components are copied into a per-thread arena, so slices do not share
+// ablation state. The throttle, orientation and parachute are fixed over the
+// run, so the trajectory must not depend on a controller.
+PararealResult RunParareal(const Vessel &prototype,
+                           const VesselState &initialState,
+                           const PararealSettings &settings);
+
+// Serial reference: the fine propagator over the whole interval
+VesselState PropagateSerial(const Vessel &prototype,
+                            const VesselState &initialState,
+                            double endTime,
+                            double deltaTime);
@@ -0,0 +1,127 @@
+#include "RealTimeScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+RealTimeScheduler::RealTimeScheduler(const PacingSettings &settings)
+    : settings(settings),
+      stopRequested(false)
+{
+}
+
+PacingStats RealTimeScheduler::Run(const std::function<bool(long, double)> &frame)
+{
+    using Clock = std::chrono::steady_clock;
+    using Micros = std::chrono::duration<double, std::micro>;
+
+    stopRequested.store(false, std::memory_order_relaxed);
+
+    const bool paced = settings.speedFactor > 0.0;
+    const double frameDeltaTime = 1.0 / settings.rateHz;
+    const Micros period(paced ? 1e6 * frameDeltaTime / settings.speedFactor : 0.0);
+    const Micros deadline = period * settings.deadlineFraction;
+    const Micros spin(settings.spinMicros);
+
+    PacingStats stats;
+    stats.periodMicros = period.count();
+    // Ring buffer: an open-ended run (maxFrames == 0) keeps constant memory
+    const size_t jitterWindow = std::max<size_t>(settings.jitterWindow, 1);
+    std::vector<float> jitter;
+    jitter.reserve(settings.maxFrames > 0 ? std::min<size_t>(settings.maxFrames, jitterWindow) : jitterWindow);
+    size_t jitterCursor = 0;
+
+    Clock::time_point start = Clock::now();
+    long release = 0; // schedule slot of the next frame
+    long index = 0;   // frames actually run
+    double jitterSum = 0.0, computeSum = 0.0;
+
+    while (!stopRequested.load(std::memory_order_relaxed) &&
+           (settings.maxFrames <= 0 || index < settings.maxFrames))
+    {
+        Clock::time_point releaseTime = start + std::chrono::duration_cast<Clock::duration>(period * double(release));
+
+        // === Wait for the release ===
+        if (paced)
+        {
+            if (Clock::now() < releaseTime - spin)
+                std::this_thread::sleep_until(releaseTime - spin);
+            while (Clock::now() < releaseTime)
+                ;
+        }
+
+        // === Run the frame ===
+        Clock::time_point begin = Clock::now();
+        bool keepGoing = frame(index, index * frameDeltaTime);
+        Clock::time_point end = Clock::now();
+        ++index;
+
+        double lateness = paced ? Micros(begin - releaseTime).count() : 0.0;
+        double compute = Micros(end - begin).count();
+        if (jitter.size() < jitterWindow)
+            jitter.push_back(float(lateness));
+        else
+            jitter[jitterCursor] = float(lateness);
+        jitterCursor = (jitterCursor + 1) % jitterWindow;
+        jitterSum += lateness;
+        computeSum += compute;
+        stats.maxJitterMicros = std::max(stats.maxJitterMicros, lateness);
+        stats.maxComputeMicros = std::max(stats.maxComputeMicros, compute);
+
+        ++release;
+        if (paced)
+        {
+            if (end > releaseTime + std::chrono::duration_cast<Clock::duration>(deadline))
+                ++stats.deadlineMisses;
+
+            Clock::time_point nextRelease = start + std::chrono::duration_cast<Clock::duration>(period * double(release));
+            if (end > nextRelease)
+            {
+                ++stats.overruns;
+                if (settings.skipMissedFrames)
+                {
+                    // Jump to the first release still in the future
+                    long behind = long(std::ceil(Micros(end - start).count() / period.count())) - release;
+                    if (behind > 0)
+                    {
+                        release += behind;
+                        stats.skippedFrames += behind;
+                    }
+                }
+            }
+        }
+
+        if (!keepGoing)
+            break;
+    }
+
+    stats.frames = index;
+    stats.wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    stats.simulatedSeconds = index * frameDeltaTime;
+    if (index > 0)
+    {
+        stats.meanJitterMicros = jitterSum / index;
+        stats.meanComputeMicros = computeSum / index;
+        size_t p99 = std::min(jitter.size() - 1, size_t(0.99 * jitter.size()));
+        std::nth_element(jitter.begin(), jitter.begin() + p99, jitter.end());
+        stats.p99JitterMicros = jitter[p99];
+    }
+    return stats;
+}
+
+std::string PacingStats::Format() const
+{
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    out << "  Frames: " << frames << " (" << simulatedSeconds << " s simulated in "
+        << std::setprecision(3) << wallSeconds << " s, " << std::setprecision(2) << AchievedSpeed() << "x)\n";
+    out << std::setprecision(1);
+    out << "  Jitter: mean " << meanJitterMicros << " µs, p99 " << p99JitterMicros
+        << " µs, max " << maxJitterMicros << " µs (period " << periodMicros << " µs)\n";
+    out << "  Compute: mean " << meanComputeMicros << " µs, max " << maxComputeMicros << " µs\n";
+    out << "  Deadline misses: " << deadlineMisses << ", overruns: " << overruns
+        << ", skipped frames: " << skippedFrames << "\n";
+    return out.str();
+}
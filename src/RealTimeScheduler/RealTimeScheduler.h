@@ -0,0 +1,57 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct PacingSettings
+{
+    double rateHz = 100.0;          // frames per simulated second
+    double speedFactor = 1.0;       // 1 = real time, N = N× real time, 0 = unpaced
+    double deadlineFraction = 1.0;  // a frame must finish within this share of its wall period
+    int spinMicros = 200;           // busy-wait the tail of each sleep for lower wakeup jitter
+    bool skipMissedFrames = false;  // after an overrun drop releases to re-align, instead of running late frames back to back
+    long maxFrames = 0;             // 0 = until the frame callback or Stop() ends the run
+    size_t jitterWindow = 65536;    // most recent frames kept for the p99; bounds memory on open-ended runs
+};
+
+struct PacingStats
+{
+    long frames = 0;
+    long deadlineMisses = 0; // finished after release + deadlineFraction * period
+    long overruns = 0;       // finished after the next frame's release
+    long skippedFrames = 0;  // releases dropped to re-align (skipMissedFrames)
+    double periodMicros = 0.0; // wall-clock period
+    double meanJitterMicros = 0.0; // start lateness relative to the release time
+    double p99JitterMicros = 0.0;  // over the last jitterWindow frames
+    double maxJitterMicros = 0.0;
+    double meanComputeMicros = 0.0; // time spent in the frame callback
+    double maxComputeMicros = 0.0;
+    double wallSeconds = 0.0;
+    double simulatedSeconds = 0.0;
+
+    double AchievedSpeed() const { return wallSeconds > 0.0 ? simulatedSeconds / wallSeconds : 0.0; }
+    std::string Format() const;
+};
+
+// Runs a frame callback on a fixed wall-clock schedule. Frame k is released
+// at start + k * period / speedFactor, so lateness never accumulates: a slow
+// frame makes the next ones start late but does not shift the schedule.
+// Every frame advances simulated time by exactly 1 / rateHz.
+class RealTimeScheduler
+{
+public:
+    explicit RealTimeScheduler(const PacingSettings &settings = PacingSettings());
+
+    // frame(index, simulatedTime) returns false to end the run
+    PacingStats Run(const std::function<bool(long, double)> &frame);
+
+    // Safe from any thread; the current frame completes first
+    void Stop() { stopRequested.store(true, std::memory_order_relaxed); }
+
+    double GetFrameDeltaTime() const { return 1.0 / settings.rateHz; }
+
+private:
+    PacingSettings settings;
+    std::atomic<bool> stopRequested;
+};
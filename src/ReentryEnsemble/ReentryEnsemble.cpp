@@ -0,0 +1,377 @@
+#include "ReentryEnsemble.h"
+#include <FastMath.h>
+#include <OrbitalBody.h>
+#include <Vessel.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+const char *ToString(EnsemblePrecision precision)
+{
+    switch (precision)
+    {
+    case EnsemblePrecision::Double:
+        return "double";
+    case EnsemblePrecision::Float:
+        return "float";
+    case EnsemblePrecision::Mixed:
+        return "mixed";
+    }
+    return "unknown";
+}
+
+namespace
+{
+    // tanh for x >= 0. The fast form is branch-free: a series below 0.1,
+    // where 1 - e^-2x would cancel, and the exponential form above.
+    template <bool Fast, typename Real>
+    inline Real Tanh(Real x)
+    {
+        if constexpr (!Fast)
+            return std::tanh(x);
+        else
+        {
+            Real z = x * x;
+            Real p = Real(-1382.0 / 155925.0);
+            p = Real(62.0 / 2835.0) + z * p;
+            p = Real(-17.0 / 315.0) + z * p;
+            p = Real(2.0 / 15.0) + z * p;
+            p = Real(-1.0 / 3.0) + z * p;
+            Real series = x + x * z * p;
+            Real e = FastMath::FastExp(Real(-2) * x);
+            return x < Real(0.1) ? series : (Real(1) - e) / (Real(1) + e);
+        }
+    }
+}
+
+template <typename ForceReal, typename StateReal>
+ReentryEnsemble<ForceReal, StateReal>::ReentryEnsemble(const OrbitalBody *body,
+                                                       const std::vector<EnsembleSample> &samples)
+    : body(body),
+      count(samples.size()),
+      peakHeatRate(samples.size()),
+      peakDeceleration(samples.size()),
+      outcomeKind(samples.size(), static_cast<Flag>(EnsembleOutcomeKind::InFlight)),
+      density(samples.size()),
+      deceleration(samples.size()),
+      gravityAltitude(samples.size()),
+      gravity(samples.size()),
+      dragRate(samples.size()),
+      nextVelocity(samples.size()),
+      time(0.0),
+      outcomes(samples.size())
+{
+    for (const EnsembleSample &s : samples)
+    {
+        mass.push_back(ForceReal(s.massKg));
+        dragArea.push_back(ForceReal(s.dragCoefficient * s.crossSectionArea));
+        shieldArea.push_back(ForceReal(s.shieldArea));
+        ablationEnergy.push_back(ForceReal(s.ablationEnergy));
+        chuteDragArea.push_back(ForceReal(s.chuteDragCoefficient * s.chuteArea));
+        chuteDeployAltitude.push_back(ForceReal(s.chuteDeployAltitude));
+        chuteMaxMass.push_back(ForceReal(s.chuteMaxMassKg));
+
+        altitude.push_back(StateReal(s.altitude));
+        velocity.push_back(StateReal(s.velocity));
+        totalHeatLoad.push_back(StateReal(0));
+        shieldMass.push_back(StateReal(s.shieldMassKg));
+        chuteDeployed.push_back(0);
+        active.push_back(s.altitude > 0.0 ? 1 : 0);
+    }
+}
+
+template <typename ForceReal, typename StateReal>
+void ReentryEnsemble<ForceReal, StateReal>::Step(ForceReal dt)
+{
+    // One mode check per step; each pass below is then straight-line code
+    if (FastMath::IsFast())
+        Advance<true>(dt);
+    else
+        Advance<false>(dt);
+}
+
+template <typename ForceReal, typename StateReal>
+template <bool Fast>
+void ReentryEnsemble<ForceReal, StateReal>::Advance(ForceReal dt)
+{
+    constexpr ForceReal heatTransferCoefficient = ForceReal(1.83e-4);
+    constexpr ForceReal emissivity = ForceReal(0.85);
+    constexpr ForceReal stefanBoltzmann = ForceReal(5.670374419e-8);
+    constexpr ForceReal heatCapacityPerArea = ForceReal(2000.0);
+    constexpr ForceReal half = ForceReal(0.5);
+    constexpr Flag landedSafely = static_cast<Flag>(EnsembleOutcomeKind::LandedSafely);
+    constexpr Flag crashed = static_cast<Flag>(EnsembleOutcomeKind::Crashed);
+    constexpr Flag burnedUp = static_cast<Flag>(EnsembleOutcomeKind::BurnedUp);
+
+    // Raw pointers for the passes: through the vectors, every store could
+    // alias their data pointers and keep the loops scalar
+    const ForceReal *massOf = mass.data(), *dragAreaOf = dragArea.data(), *shieldAreaOf = shieldArea.data();
+    const ForceReal *ablationEnergyOf = ablationEnergy.data(), *chuteDragAreaOf = chuteDragArea.data();
+    const ForceReal *chuteDeployAltitudeOf = chuteDeployAltitude.data(), *chuteMaxMassOf = chuteMaxMass.data();
+    ForceReal *densityOf = density.data();
+    double *gravityAltitudeOf = gravityAltitude.data(), *gravityOf = gravity.data();
+    StateReal *altitudeOf = altitude.data(), *velocityOf = velocity.data();
+    StateReal *heatLoadOf = totalHeatLoad.data(), *shieldMassOf = shieldMass.data();
+    StateReal *dragRateOf = dragRate.data(), *nextVelocityOf = nextVelocity.data();
+    ForceReal *decelerationOf = deceleration.data();
+    ForceReal *peakHeatRateOf = peakHeatRate.data(), *peakDecelerationOf = peakDeceleration.data();
+    Flag *chuteDeployedOf = chuteDeployed.data(), *activeOf = active.data(), *kindOf = outcomeKind.data();
+
+    // === Densities and gravity for the whole batch ===
+    // Density stays zero without an atmosphere; gravity is taken at the
+    // start of the step, as Vessel::ComputeGravity sees it
+    if (const Atmosphere *atm = body->GetAtmosphere())
+    {
+#pragma omp simd
+        for (size_t i = 0; i < count; ++i)
+            densityOf[i] = ForceReal(altitudeOf[i]);
+        atm->GetDensitiesAs<ForceReal>(densityOf, densityOf, count);
+    }
+#pragma omp simd
+    for (size_t i = 0; i < count; ++i)
+        gravityAltitudeOf[i] = double(altitudeOf[i]);
+    body->ComputeGravitationalAccelerations(gravityAltitudeOf, gravityOf, count, 0.0, 0.0, time);
+
+    // === Drag, parachute and gravity, in closed form ===
+    Flag rising = 0;
+#pragma omp simd reduction(+ : rising)
+    for (size_t i = 0; i < count; ++i)
+    {
+        StateReal v = velocityOf[i];
+        ForceReal m = massOf[i];
+        bool alive = activeOf[i] != Flag(0);
+        ForceReal rho = densityOf[i], chuteDragArea = chuteDragAreaOf[i];
+        bool chuteUsable = (chuteDragArea > ForceReal(0)) & (m <= chuteMaxMassOf[i]);
+        bool deployed = (chuteDeployedOf[i] != Flag(0)) | (alive & chuteUsable & (ForceReal(altitudeOf[i]) <= chuteDeployAltitudeOf[i]));
+        chuteDeployedOf[i] = deployed ? Flag(1) : Flag(0);
+
+        ForceReal bodyFactor = half * rho * dragAreaOf[i] / m;
+        ForceReal chuteFactor = (deployed & chuteUsable) ? half * rho * chuteDragArea / m : ForceReal(0);
+        ForceReal dragFactor = (bodyFactor + chuteFactor) * ForceReal(activeOf[i]);
+        ForceReal fv = ForceReal(v);
+        decelerationOf[i] = dragFactor * fv * fv;
+
+        // QuadraticDragStep for a sample that is not rising: every case on
+        // safe operands, then the valid one selected. The flag zeroes drag
+        // and the step of a finished sample, and v - g * 0 is exact
+        StateReal k = StateReal(dragFactor), h = StateReal(dt) * activeOf[i], g = StateReal(gravityOf[i]);
+        bool drag = k > StateReal(0), pull = g > StateReal(0);
+        StateReal safeK = drag ? k : StateReal(1);
+        StateReal safeGravity = pull ? g : StateReal(1);
+        StateReal terminal = std::sqrt(safeGravity / safeK);
+        StateReal ratio = -v / terminal;
+        StateReal t = Tanh<Fast>(std::sqrt(safeGravity * safeK) * h);
+        StateReal falling = -terminal * (ratio + t) / (StateReal(1) + ratio * t);
+        StateReal dragOnly = v / (StateReal(1) + k * std::abs(v) * h) - g * h;
+        StateReal vacuum = v - g * h;
+        dragRateOf[i] = k;
+        nextVelocityOf[i] = drag ? (pull ? falling : dragOnly) : vacuum;
+        rising += (alive & (v > StateReal(0))) ? Flag(1) : Flag(0);
+    }
+
+    // Rising samples coast up through tan/atan, which has no kernel; rare
+    // enough to take the scalar step
+    if (rising > Flag(0))
+        for (size_t i = 0; i < count; ++i)
+            if (activeOf[i] != Flag(0) && velocityOf[i] > StateReal(0))
+                nextVelocityOf[i] = QuadraticDragStep<StateReal>(velocityOf[i], StateReal(gravityOf[i]), dragRateOf[i],
+                                                                 StateReal(dt));
+
+    // === Heating, ablation, radiative cooling, position and outcome ===
+    // Every store is unconditional: a "mask ? new : old" store is turned
+    // back into a branch and keeps the pass scalar. Instead a finished
+    // sample steps with zero heating and a zero time step; its kind is set
+    // once, on landing, when its velocity becomes the ground-crossing speed
+#pragma omp simd
+    for (size_t i = 0; i < count; ++i)
+    {
+        bool alive = activeOf[i] != Flag(0);
+        ForceReal h = dt * ForceReal(activeOf[i]);
+        StateReal startVelocity = velocityOf[i];
+        StateReal v = nextVelocityOf[i];
+
+        ForceReal speed = std::abs(ForceReal(v));
+        ForceReal heatRate = heatTransferCoefficient * ForceReal(activeOf[i]) * densityOf[i] * speed * speed * speed;
+        StateReal heatLoad = heatLoadOf[i] + StateReal(heatRate * h);
+
+        // shield >= 0, so this leaves a spent shield at zero
+        StateReal shield = shieldMassOf[i];
+        StateReal ablate = StateReal(heatRate * shieldAreaOf[i] * h / ablationEnergyOf[i]);
+        shield -= std::min(ablate, shield);
+
+        // heatLoad >= 0 here: it is clamped after cooling and only grows
+        ForceReal surfaceTemp = ForceReal(heatLoad) / heatCapacityPerArea;
+        ForceReal surfaceTemp2 = surfaceTemp * surfaceTemp;
+        ForceReal radiated = emissivity * stefanBoltzmann * surfaceTemp2 * surfaceTemp2;
+        heatLoad = std::max(StateReal(0), heatLoad - StateReal(radiated * h));
+
+        StateReal startAltitude = altitudeOf[i];
+        StateReal alt = startAltitude + v * StateReal(h);
+
+        // Same classification as Vessel::EvaluateReentryOutcome, on the
+        // end-of-step speed; the reported speed is the interpolated ground
+        // crossing, as RunVessel reports it
+        bool landed = alive & (alt <= StateReal(0));
+        StateReal fraction = startAltitude / (landed ? startAltitude - alt : StateReal(1));
+        StateReal crossingSpeed = std::abs(startVelocity + fraction * (v - startVelocity));
+        bool burned = (shield <= StateReal(0)) & ((heatRate > ForceReal(20000.0)) | (surfaceTemp > ForceReal(1200.0)));
+        Flag kind = burned ? burnedUp : (std::abs(v) > StateReal(15.0) ? crashed : landedSafely);
+        kindOf[i] += landed ? kind : Flag(0);
+
+        ForceReal peakHeat = peakHeatRateOf[i], peakDrag = peakDecelerationOf[i];
+        peakHeatRateOf[i] = peakHeat + std::max(ForceReal(0), heatRate - peakHeat);
+        peakDecelerationOf[i] = peakDrag + std::max(ForceReal(0), decelerationOf[i] - peakDrag);
+        altitudeOf[i] = alt;
+        velocityOf[i] = landed ? -crossingSpeed : v;
+        heatLoadOf[i] = heatLoad;
+        shieldMassOf[i] = shield;
+        activeOf[i] = (alive & !landed) ? Flag(1) : Flag(0);
+    }
+}
+
+template <typename ForceReal, typename StateReal>
+void ReentryEnsemble<ForceReal, StateReal>::Run(double deltaTime, double maxTime)
+{
+    long maxSteps = static_cast<long>(maxTime / deltaTime);
+    for (long step = 0; step <= maxSteps; ++step)
+    {
+        if (std::none_of(active.begin(), active.end(), [](Flag a)
+                         { return a != Flag(0); }))
+            break;
+        Step(ForceReal(deltaTime));
+        time += deltaTime;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        EnsembleOutcome &outcome = outcomes[i];
+        outcome.kind = static_cast<EnsembleOutcomeKind>(int(outcomeKind[i]));
+        outcome.peakHeatRate = double(peakHeatRate[i]);
+        outcome.peakDeceleration = double(peakDeceleration[i]);
+        outcome.impactSpeed = outcome.kind == EnsembleOutcomeKind::InFlight ? 0.0 : std::abs(double(velocity[i]));
+        outcome.shieldRemainingKg = double(shieldMass[i]);
+    }
+}
+
+template class ReentryEnsemble<double, double>;
+template class ReentryEnsemble<float, float>;
+template class ReentryEnsemble<float, double>;
+
+std::vector<EnsembleOutcome> RunReentryEnsemble(EnsemblePrecision precision,
+                                                const OrbitalBody *body,
+                                                const std::vector<EnsembleSample> &samples,
+                                                double deltaTime,
+                                                double maxTime)
+{
+    switch (precision)
+    {
+    case EnsemblePrecision::Float:
+    {
+        ReentryEnsemble<float, float> ensemble(body, samples);
+        ensemble.Run(deltaTime, maxTime);
+        return ensemble.GetOutcomes();
+    }
+    case EnsemblePrecision::Mixed:
+    {
+        ReentryEnsemble<float, double> ensemble(body, samples);
+        ensemble.Run(deltaTime, maxTime);
+        return ensemble.GetOutcomes();
+    }
+    case EnsemblePrecision::Double:
+        break;
+    }
+
+    ReentryEnsemble<double, double> ensemble(body, samples);
+    ensemble.Run(deltaTime, maxTime);
+    return ensemble.GetOutcomes();
+}
+
+// ==============================
+// Validation
+// ==============================
+namespace
+{
+    double RelativeError(double value, double reference)
+    {
+        return std::abs(value - reference) / std::max(std::abs(reference), 1e-9);
+    }
+
+    double TimeEnsemble(EnsemblePrecision precision,
+                        const OrbitalBody *body,
+                        const std::vector<EnsembleSample> &samples,
+                        double deltaTime,
+                        double maxTime,
+                        std::vector<EnsembleOutcome> &outcomes)
+    {
+        auto start = std::chrono::steady_clock::now();
+        outcomes = RunReentryEnsemble(precision, body, samples, deltaTime, maxTime);
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+PrecisionReport ValidatePrecision(EnsemblePrecision precision,
+                                  const OrbitalBody *body,
+                                  const std::vector<EnsembleSample> &samples,
+                                  double deltaTime,
+                                  double maxTime)
+{
+    std::vector<EnsembleOutcome> reference, candidate;
+
+    PrecisionReport report;
+    report.precision = precision;
+    report.sampleCount = samples.size();
+    report.referenceWallSeconds = TimeEnsemble(EnsemblePrecision::Double, body, samples, deltaTime, maxTime, reference);
+    report.wallSeconds = TimeEnsemble(precision, body, samples, deltaTime, maxTime, candidate);
+
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        const EnsembleOutcome &ref = reference[i];
+        const EnsembleOutcome &out = candidate[i];
+
+        if (out.kind != ref.kind)
+            ++report.outcomeMismatches;
+
+        double heatError = RelativeError(out.peakHeatRate, ref.peakHeatRate);
+        double decelError = RelativeError(out.peakDeceleration, ref.peakDeceleration);
+        double impactError = RelativeError(out.impactSpeed, ref.impactSpeed);
+
+        report.maxPeakHeatRateError = std::max(report.maxPeakHeatRateError, heatError);
+        report.maxPeakDecelerationError = std::max(report.maxPeakDecelerationError, decelError);
+        report.maxImpactSpeedError = std::max(report.maxImpactSpeedError, impactError);
+        report.maxShieldMassError = std::max(report.maxShieldMassError,
+                                             std::abs(out.shieldRemainingKg - ref.shieldRemainingKg));
+
+        report.meanPeakHeatRateError += heatError;
+        report.meanPeakDecelerationError += decelError;
+        report.meanImpactSpeedError += impactError;
+    }
+
+    if (!samples.empty())
+    {
+        report.meanPeakHeatRateError /= samples.size();
+        report.meanPeakDecelerationError /= samples.size();
+        report.meanImpactSpeedError /= samples.size();
+    }
+    return report;
+}
+
+std::string PrecisionReport::Format() const
+{
+    std::ostringstream out;
+    out << std::scientific << std::setprecision(2);
+    out << "  [" << ToString(precision) << "] " << sampleCount << " samples, "
+        << outcomeMismatches << " outcome mismatches ("
+        << std::fixed << 100.0 * (sampleCount - outcomeMismatches) / std::max<size_t>(sampleCount, 1)
+        << "% agree)\n";
+    out << std::scientific;
+    out << "    peak heat rate  rel err: max " << maxPeakHeatRateError << ", mean " << meanPeakHeatRateError << "\n";
+    out << "    peak decel      rel err: max " << maxPeakDecelerationError << ", mean " << meanPeakDecelerationError << "\n";
+    out << "    impact speed    rel err: max " << maxImpactSpeedError << ", mean " << meanImpactSpeedError << "\n";
+    out << "    shield mass     abs err: max " << maxShieldMassError << " kg\n";
+    out << std::fixed << std::setprecision(3);
+    out << "    wall time: " << wallSeconds << " s (double " << referenceWallSeconds << " s, "
+        << std::setprecision(2) << referenceWallSeconds / std::max(wallSeconds, 1e-9) << "x)\n";
+    return out.str();
+}
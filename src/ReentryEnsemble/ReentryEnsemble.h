@@ -0,0 +1,140 @@
+#pragma once
+#include <string>
+#include <vector>
+
+class OrbitalBody;
+
+enum class EnsemblePrecision
+{
+    Double, // reference
+    Float,  // float state and forces
+    Mixed   // float forces, double state accumulation
+};
+
+const char *ToString(EnsemblePrecision precision);
+
+// One passive reentry: capsule, optional heat shield, optional parachute
+struct EnsembleSample
+{
+    double altitude = 100000.0; // m
+    double velocity = -7500.0;  // m/s
+    double massKg = 5000.0;
+    double dragCoefficient = 1.25;
+    double crossSectionArea = 5.0; // m²
+    double shieldMassKg = 250.0;   // 0 = no shield
+    double shieldArea = 5.0;       // m²
+    double ablationEnergy = 2e6;   // J/kg
+    double chuteArea = 0.0;        // m², 0 = no chute
+    double chuteDragCoefficient = 2.2;
+    double chuteDeployAltitude = 3000.0; // m
+    double chuteMaxMassKg = 8000.0;
+};
+
+enum class EnsembleOutcomeKind
+{
+    InFlight,
+    LandedSafely,
+    Crashed,
+    BurnedUp
+};
+
+struct EnsembleOutcome
+{
+    EnsembleOutcomeKind kind = EnsembleOutcomeKind::InFlight;
+    double peakHeatRate = 0.0;     // W/m²
+    double peakDeceleration = 0.0; // m/s², drag + chute
+    double impactSpeed = 0.0;      // m/s
+    double shieldRemainingKg = 0.0;
+};
+
+// Struct-of-arrays batch of reentries stepped together, with densities and
+// gravity evaluated for the whole batch in one pass per step. ForceReal is
+// used for density, force and heating evaluation; StateReal for the
+// integrated state (altitude, velocity, heat load, shield mass). Each
+// sample takes Vessel's sequential step for a passive, nose-first capsule
+// at site (0, 0): QuadraticDragStep for drag, chute and gravity, and the
+// body's full gravity model.
+//
+// The step is two branch-free passes over the arrays: chute deployment,
+// landing, outcome and the shield are masked selects, and finished samples
+// take a zero step. The heating and landing pass always vectorizes; the
+// drag pass does in fast math mode, where it uses FastMath's kernels in
+// place of <cmath>, so float fills twice the lanes of double. Rising
+// samples, which need tan/atan, are redone by a scalar fix-up. Gravity
+// stays a scalar double evaluation per sample.
+template <typename ForceReal, typename StateReal>
+class ReentryEnsemble
+{
+public:
+    ReentryEnsemble(const OrbitalBody *body, const std::vector<EnsembleSample> &samples);
+
+    void Run(double deltaTime, double maxTime);
+
+    const std::vector<EnsembleOutcome> &GetOutcomes() const { return outcomes; }
+
+private:
+    // Flags (0 or 1) and the outcome kind are held as state values: their
+    // masks then line up with the state's lanes, and SSE2 can compare
+    // doubles but not 64-bit integers
+    using Flag = StateReal;
+
+    void Step(ForceReal deltaTime);
+    template <bool Fast>
+    void Advance(ForceReal deltaTime);
+
+    const OrbitalBody *body;
+    size_t count;
+
+    // Per-sample parameters
+    std::vector<ForceReal> mass, dragArea, shieldArea, ablationEnergy;
+    std::vector<ForceReal> chuteDragArea, chuteDeployAltitude, chuteMaxMass;
+
+    // Per-sample state. A landed sample keeps its ground-crossing speed as
+    // its velocity
+    std::vector<StateReal> altitude, velocity, totalHeatLoad, shieldMass;
+    std::vector<Flag> chuteDeployed, active;
+
+    // Per-sample results, gathered into outcomes when the run ends
+    std::vector<ForceReal> peakHeatRate, peakDeceleration;
+    std::vector<Flag> outcomeKind; // EnsembleOutcomeKind
+
+    // Per-step scratch: altitude in, density out; gravity; the drag pass's
+    // coefficient, end-of-step velocity and deceleration
+    std::vector<ForceReal> density, deceleration;
+    std::vector<double> gravityAltitude, gravity;
+    std::vector<StateReal> dragRate, nextVelocity;
+    double time; // s, mission time
+
+    std::vector<EnsembleOutcome> outcomes;
+};
+
+std::vector<EnsembleOutcome> RunReentryEnsemble(EnsemblePrecision precision,
+                                                const OrbitalBody *body,
+                                                const std::vector<EnsembleSample> &samples,
+                                                double deltaTime = 0.1,
+                                                double maxTime = 6000.0);
+
+// Reduced-precision results measured against the double reference
+struct PrecisionReport
+{
+    EnsemblePrecision precision = EnsemblePrecision::Double;
+    size_t sampleCount = 0;
+    size_t outcomeMismatches = 0;
+    double maxPeakHeatRateError = 0.0; // relative
+    double meanPeakHeatRateError = 0.0;
+    double maxPeakDecelerationError = 0.0;
+    double meanPeakDecelerationError = 0.0;
+    double maxImpactSpeedError = 0.0;
+    double meanImpactSpeedError = 0.0;
+    double maxShieldMassError = 0.0; // kg, absolute
+    double wallSeconds = 0.0;
+    double referenceWallSeconds = 0.0;
+
+    std::string Format() const;
+};
+
+PrecisionReport ValidatePrecision(EnsemblePrecision precision,
+                                  const OrbitalBody *body,
+                                  const std::vector<EnsembleSample> &samples,
+                                  double deltaTime = 0.1,
+                                  double maxTime = 6000.0);
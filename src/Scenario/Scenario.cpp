@@ -0,0 +1,211 @@
+#include "Scenario.h"
+#include <OrbitalBody.h>
+#include <Vessel.h>
+#include <MetricsRegistry.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+const char *ToString(ScenarioOutcome outcome)
+{
+    switch (outcome)
+    {
+    case ScenarioOutcome::InFlight:
+        return "in flight";
+    case ScenarioOutcome::LandedSafely:
+        return "landed safely";
+    case ScenarioOutcome::Crashed:
+        return "crashed";
+    case ScenarioOutcome::BurnedUp:
+        return "burned up";
+    }
+    return "unknown";
+}
+
+namespace
+{
+    // Reported once per trajectory, never per step
+    struct ScenarioMetrics
+    {
+        MetricCounter steps;
+        MetricCounter outcomes[4]; // by ScenarioOutcome
+        MetricHistogram wallTime;
+
+        ScenarioMetrics()
+        {
+            MetricsRegistry &registry = MetricsRegistry::Global();
+            steps = registry.AddCounter("physicssim_steps_total", "Integration steps taken by RunVessel.");
+            const char *labels[] = {"in_flight", "landed_safely", "crashed", "burned_up"};
+            for (int i = 0; i < 4; ++i)
+                outcomes[i] = registry.AddCounter(std::string("physicssim_trajectories_total{outcome=\"") + labels[i] + "\"}",
+                                                  "Trajectories completed, by outcome.");
+            wallTime = registry.AddHistogram("physicssim_trajectory_seconds", "Wall time per trajectory.",
+                                             MetricsRegistry::ExponentialBuckets(1e-5, 2.0, 22));
+        }
+    };
+
+    const ScenarioMetrics &Metrics()
+    {
+        static ScenarioMetrics metrics;
+        return metrics;
+    }
+
+    void RecordTelemetry(TelemetryColumns &columns, const Vessel &vessel, double time)
+    {
+        if (columns.count >= columns.capacity)
+        {
+            ++columns.dropped;
+            return;
+        }
+
+        size_t row = columns.count++;
+        if (columns.time)
+            columns.time[row] = time;
+        if (columns.altitude)
+            columns.altitude[row] = vessel.GetAltitude();
+        if (columns.velocity)
+            columns.velocity[row] = vessel.GetVelocity();
+        if (columns.airDensity)
+            columns.airDensity[row] = vessel.GetLastAirDensity();
+        if (columns.heatRate)
+            columns.heatRate[row] = vessel.GetHeatRate();
+        if (columns.surfaceTemperature)
+            columns.surfaceTemperature[row] = vessel.GetSurfaceTemperature();
+        if (columns.shieldMass)
+            columns.shieldMass[row] = vessel.GetHeatShieldMass();
+    }
+}
+
+ScenarioResult RunVessel(Vessel &vessel, double deltaTime, double maxTime, TelemetryColumns *telemetry, bool stopAtApex)
+{
+    OrbitalBody *body = vessel.GetParentBody();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    if (telemetry)
+    {
+        telemetry->count = 0;
+        telemetry->dropped = 0;
+    }
+    size_t interval = telemetry ? std::max<size_t>(1, telemetry->interval) : 1;
+
+    ScenarioResult result;
+    result.maxAltitude = vessel.GetAltitude();
+    double time = 0.0;
+    double olderAltitude = vessel.GetAltitude(); // two steps back, for the apex fit
+
+    // A launch starts on the ground and may take a few steps to leave it
+    bool airborne = vessel.GetAltitude() > 0.0;
+    while (time <= maxTime && (vessel.GetAltitude() > 0.0 || (stopAtApex && !airborne)))
+    {
+        double gravity = body->ComputeGravitationalAcceleration(vessel.GetAltitude());
+        double previousAltitude = vessel.GetAltitude();
+        double previousVelocity = vessel.GetVelocity();
+
+        vessel.Update(deltaTime);
+        time += deltaTime;
+        ++result.steps;
+
+        double acceleration = (vessel.GetVelocity() - previousVelocity) / deltaTime + gravity;
+        double dynamicPressure = 0.5 * vessel.GetLastAirDensity() * previousVelocity * previousVelocity;
+        result.peakDeceleration = std::max(result.peakDeceleration, std::abs(acceleration));
+        result.peakHeatRate = std::max(result.peakHeatRate, vessel.GetHeatRate());
+        result.peakDynamicPressure = std::max(result.peakDynamicPressure, dynamicPressure);
+        result.maxAltitude = std::max(result.maxAltitude, vessel.GetAltitude());
+        airborne = airborne || vessel.GetAltitude() > 0.0;
+
+        if (telemetry && result.steps % interval == 0)
+            RecordTelemetry(*telemetry, vessel, vessel.GetMissionTime());
+
+        // Ground contact inside this step: interpolate the crossing
+        if (airborne && vessel.GetAltitude() <= 0.0)
+        {
+            double fraction = previousAltitude / (previousAltitude - vessel.GetAltitude());
+            result.impactTime = time - deltaTime * (1.0 - fraction);
+            result.impactSpeed = std::abs(previousVelocity + fraction * (vessel.GetVelocity() - previousVelocity));
+        }
+
+        // Apex after burnout (as in SimulateLaunch): vertex of the parabola
+        // through the last three altitude samples
+        if (stopAtApex && vessel.GetFuelMass() <= 0.0 && vessel.GetVelocity() <= 0.0)
+        {
+            double curvature = olderAltitude - 2.0 * previousAltitude + vessel.GetAltitude();
+            double slope = 0.5 * (vessel.GetAltitude() - olderAltitude);
+            result.apexAltitude = curvature < 0.0
+                                      ? previousAltitude - 0.5 * slope * slope / curvature
+                                      : previousAltitude;
+            break;
+        }
+        olderAltitude = previousAltitude;
+    }
+
+    result.flightTime = time;
+    result.shieldRemainingKg = vessel.GetHeatShieldMass();
+
+    if (vessel.HasBurnedUp())
+        result.outcome = ScenarioOutcome::BurnedUp;
+    else if (vessel.HasCrashed())
+        result.outcome = ScenarioOutcome::Crashed;
+    else if (vessel.HasLandedSafely())
+        result.outcome = ScenarioOutcome::LandedSafely;
+
+    const ScenarioMetrics &metrics = Metrics();
+    metrics.steps.Add(uint64_t(result.steps));
+    metrics.outcomes[int(result.outcome)].Add();
+    metrics.wallTime.Observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    return result;
+}
+
+ScenarioResult RunLaunchScenario(OrbitalBody *body,
+                                 const LaunchScenario &scenario,
+                                 TelemetryColumns *telemetry)
+{
+    ThrustModel engine(scenario.maxThrust, scenario.vacuumISP, scenario.seaLevelISP);
+    Vessel rocket(
+        0.0,
+        0.0,
+        scenario.dryMassKg,
+        scenario.fuelMassKg,
+        scenario.dragCoefficient,
+        scenario.crossSectionArea,
+        body,
+        engine);
+    rocket.SetThrottle(scenario.throttle);
+    rocket.SetIntegrationMethod(scenario.integrationMethod);
+    rocket.SetMultiRateSettings(scenario.multiRate);
+
+    return RunVessel(rocket, scenario.deltaTime, scenario.maxTime, telemetry, true);
+}
+
+ScenarioResult RunReentryScenario(OrbitalBody *body,
+                                  const ReentryScenario &scenario,
+                                  TelemetryColumns *telemetry)
+{
+    ThrustModel dummyEngine(0.0, 0.0, 0.0);
+    Vessel capsule(
+        scenario.altitude,
+        scenario.velocity,
+        scenario.dryMassKg,
+        0.0,
+        scenario.dragCoefficient,
+        scenario.crossSectionArea,
+        body,
+        dummyEngine);
+    capsule.SetOrientationVector(Vector3(0.0, -1.0, 0.0)); // nose first
+    capsule.SetIntegrationMethod(scenario.integrationMethod);
+    capsule.SetMultiRateSettings(scenario.multiRate);
+
+    // One arena per thread, reset per run: no allocation once warmed up
+    thread_local ComponentArena components(1, 1);
+    components.Reset();
+
+    if (scenario.shieldMassKg > 0.0)
+        capsule.AttachHeatShield(components, components.CreateHeatShield(HeatShield(
+                                                 scenario.shieldMassKg, scenario.shieldArea, scenario.ablationEnergy)));
+
+    if (scenario.chuteArea > 0.0)
+        capsule.AttachParachute(components, components.CreateParachute(Parachute(
+                                                scenario.chuteArea, scenario.chuteDragCoefficient,
+                                                scenario.chuteDeployAltitude, scenario.chuteMaxMassKg)));
+
+    return RunVessel(capsule, scenario.deltaTime, scenario.maxTime, telemetry);
+}
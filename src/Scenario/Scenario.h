@@ -0,0 +1,101 @@
+#pragma once
+#include <Vessel.h>
+#include <cstddef>
+
+class OrbitalBody;
+
+// Passive capsule reentry, as in SimulateReentry / TestReentryOutcomes
+struct ReentryScenario
+{
+    double altitude = 100000.0; // m
+    double velocity = -7500.0;  // m/s
+    double dryMassKg = 5000.0;
+    double dragCoefficient = 1.25;
+    double crossSectionArea = 5.0; // m²
+    double shieldMassKg = 250.0;   // 0 = no heat shield
+    double shieldArea = 5.0;       // m²
+    double ablationEnergy = 2e6;   // J/kg
+    double chuteArea = 0.0;        // m², 0 = no parachute
+    double chuteDragCoefficient = 2.2;
+    double chuteDeployAltitude = 3000.0; // m
+    double chuteMaxMassKg = 8000.0;
+    double deltaTime = 0.1; // s
+    double maxTime = 600.0; // s
+    IntegrationMethod integrationMethod = IntegrationMethod::SemiImplicitEuler;
+    MultiRateSettings multiRate; // for IntegrationMethod::MultiRate
+};
+
+// Vertical launch from the surface to apex, as in SimulateLaunch
+struct LaunchScenario
+{
+    double maxThrust = 1.5e6; // N
+    double vacuumISP = 350.0; // s
+    double seaLevelISP = 280.0;
+    double throttle = 1.0;
+    double dryMassKg = 10000.0;
+    double fuelMassKg = 20000.0;
+    double dragCoefficient = 2.0;
+    double crossSectionArea = 1.2; // m²
+    double deltaTime = 0.1;        // s
+    double maxTime = 600.0;        // s
+    IntegrationMethod integrationMethod = IntegrationMethod::SemiImplicitEuler;
+    MultiRateSettings multiRate; // for IntegrationMethod::MultiRate
+};
+
+enum class ScenarioOutcome
+{
+    InFlight,
+    LandedSafely,
+    Crashed,
+    BurnedUp
+};
+
+const char *ToString(ScenarioOutcome outcome);
+
+struct ScenarioResult
+{
+    ScenarioOutcome outcome = ScenarioOutcome::InFlight;
+    double flightTime = 0.0;       // s, whole steps
+    double impactTime = 0.0;       // s, interpolated ground crossing
+    double impactSpeed = 0.0;      // m/s, at the interpolated crossing
+    double maxAltitude = 0.0;      // m, sampled
+    double apexAltitude = 0.0;     // m, interpolated (launches only)
+    double peakHeatRate = 0.0;     // W/m²
+    double peakDeceleration = 0.0; // m/s², non-gravitational
+    double peakDynamicPressure = 0.0; // Pa
+    double shieldRemainingKg = 0.0;
+    long steps = 0;
+};
+
+// Caller-owned column arrays, one row per recorded step. Null columns are
+// skipped; rows past capacity are dropped and counted in `dropped`.
+struct TelemetryColumns
+{
+    double *time = nullptr;
+    double *altitude = nullptr;
+    double *velocity = nullptr;
+    double *airDensity = nullptr;
+    double *heatRate = nullptr;
+    double *surfaceTemperature = nullptr;
+    double *shieldMass = nullptr;
+    size_t capacity = 0;
+    size_t interval = 1; // record every Nth step
+    size_t count = 0;    // rows written
+    size_t dropped = 0;  // rows that did not fit
+};
+
+// Step an already configured vessel until ground contact or maxTime, or
+// with stopAtApex until it starts falling after burnout
+ScenarioResult RunVessel(Vessel &vessel,
+                         double deltaTime,
+                         double maxTime,
+                         TelemetryColumns *telemetry = nullptr,
+                         bool stopAtApex = false);
+
+ScenarioResult RunLaunchScenario(OrbitalBody *body,
+                                 const LaunchScenario &scenario,
+                                 TelemetryColumns *telemetry = nullptr);
+
+ScenarioResult RunReentryScenario(OrbitalBody *body,
+                                  const ReentryScenario &scenario,
+                                  TelemetryColumns *telemetry = nullptr);
@@ -0,0 +1,458 @@
+#include "ShardedSweep.h"
+#include <Atmosphere.h>
+#include <OrbitalBody.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+    struct SpecFileHeader
+    {
+        char magic[8] = {'P', 'S', 'I', 'M', 'S', 'W', 'P', '1'};
+    };
+
+    struct ResultFileHeader
+    {
+        char magic[8] = {'P', 'S', 'I', 'M', 'S', 'W', 'R', '1'};
+        uint64_t specHash = 0;
+        uint64_t block = 0;
+    };
+
+    uint64_t SplitMix64(uint64_t x)
+    {
+        x += 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    // FNV-1a; SweepSpec is all 8-byte fields, so it has no padding
+    uint64_t HashBytes(const void *data, size_t size)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (size_t i = 0; i < size; ++i)
+            hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+        return hash;
+    }
+
+    bool WriteFileAtomically(const std::string &path, const std::string &bytes)
+    {
+        std::string temporary = path + ".tmp." + std::to_string(::getpid());
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file.write(bytes.data(), bytes.size()))
+                return false;
+        }
+        return std::rename(temporary.c_str(), path.c_str()) == 0;
+    }
+
+    bool Exists(const std::string &path)
+    {
+        struct stat info;
+        return ::stat(path.c_str(), &info) == 0;
+    }
+}
+
+// ==============================
+// Samples and aggregates
+// ==============================
+ReentryScenario SweepSample(const SweepSpec &spec, uint64_t index)
+{
+    uint64_t state = SplitMix64(spec.seed ^ SplitMix64(index));
+    auto uniform = [&](double low, double high)
+    {
+        state = SplitMix64(state);
+        return low + (high - low) * double(state >> 11) * 0x1.0p-53;
+    };
+
+    ReentryScenario scenario;
+    scenario.velocity = uniform(spec.velocityMin, spec.velocityMax);
+    scenario.shieldMassKg = uniform(spec.shieldMassMin, spec.shieldMassMax);
+    scenario.dryMassKg = uniform(spec.dryMassMin, spec.dryMassMax);
+    scenario.chuteArea = uniform(spec.chuteAreaMin, spec.chuteAreaMax);
+    return scenario;
+}
+
+SweepAggregate RunSweepBlock(OrbitalBody *body, const SweepSpec &spec, uint64_t block,
+                             const std::function<bool()> &keepGoing)
+{
+    SweepAggregate aggregate;
+    uint64_t first = block * spec.blockSize;
+    uint64_t last = std::min(spec.sampleCount, first + spec.blockSize);
+    for (uint64_t index = first; index < last; ++index)
+    {
+        if (keepGoing && !keepGoing())
+            break;
+        aggregate.Add(RunReentryScenario(body, SweepSample(spec, index)));
+    }
+    return aggregate;
+}
+
+void SweepAggregate::Add(const ScenarioResult &result)
+{
+    ++samples;
+    ++outcomes[int(result.outcome)];
+    steps += uint64_t(result.steps);
+    impactSpeedSum += result.impactSpeed;
+    impactSpeedSquares += result.impactSpeed * result.impactSpeed;
+    impactSpeedMax = std::max(impactSpeedMax, result.impactSpeed);
+    peakHeatSum += result.peakHeatRate;
+    peakHeatMax = std::max(peakHeatMax, result.peakHeatRate);
+    peakDecelerationMax = std::max(peakDecelerationMax, result.peakDeceleration);
+    shieldRemainingSum += result.shieldRemainingKg;
+}
+
+void SweepAggregate::Merge(const SweepAggregate &block)
+{
+    samples += block.samples;
+    for (int i = 0; i < 4; ++i)
+        outcomes[i] += block.outcomes[i];
+    steps += block.steps;
+    impactSpeedSum += block.impactSpeedSum;
+    impactSpeedSquares += block.impactSpeedSquares;
+    impactSpeedMax = std::max(impactSpeedMax, block.impactSpeedMax);
+    peakHeatSum += block.peakHeatSum;
+    peakHeatMax = std::max(peakHeatMax, block.peakHeatMax);
+    peakDecelerationMax = std::max(peakDecelerationMax, block.peakDecelerationMax);
+    shieldRemainingSum += block.shieldRemainingSum;
+}
+
+std::string SweepAggregate::Format() const
+{
+    std::ostringstream out;
+    double n = std::max<double>(1.0, double(samples));
+    double meanSpeed = impactSpeedSum / n;
+    out << samples << " samples: " << outcomes[int(ScenarioOutcome::LandedSafely)] << " landed, "
+        << outcomes[int(ScenarioOutcome::Crashed)] << " crashed, " << outcomes[int(ScenarioOutcome::BurnedUp)]
+        << " burned up, " << outcomes[int(ScenarioOutcome::InFlight)] << " in flight\n"
+        << std::setprecision(17) << "    impact speed mean " << meanSpeed << " m/s, sd "
+        << std::sqrt(std::max(0.0, impactSpeedSquares / n - meanSpeed * meanSpeed)) << ", max " << impactSpeedMax
+        << "\n    peak heat mean " << peakHeatSum / n << " W/m², max " << peakHeatMax
+        << "\n    shield left mean " << shieldRemainingSum / n << " kg, " << steps << " steps";
+    return out.str();
+}
+
+// ==============================
+// Sweep directory
+// ==============================
+ShardedSweep::ShardedSweep(const std::string &directory, double staleSeconds)
+    : directory(directory),
+      staleSeconds(staleSeconds),
+      specHash(0)
+{
+    char name[256] = {};
+    ::gethostname(name, sizeof(name) - 1);
+    host = name;
+}
+
+bool ShardedSweep::Create(const SweepSpec &newSpec)
+{
+    if (newSpec.blockSize == 0)
+        return false;
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    std::string path = directory + "/sweep.spec";
+    if (Exists(path))
+    {
+        // Resume only the same sweep, and give failed blocks another try
+        if (!Open() || HashBytes(&newSpec, sizeof(newSpec)) != specHash)
+            return false;
+        for (uint64_t block = 0; block < GetBlockCount(); ++block)
+            ::unlink(BlockPath(block, "failed").c_str());
+        return true;
+    }
+
+    std::string bytes(sizeof(SpecFileHeader) + sizeof(SweepSpec), '\0');
+    SpecFileHeader header;
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + sizeof(header), &newSpec, sizeof(newSpec));
+    if (!WriteFileAtomically(path, bytes))
+        return false;
+
+    spec = newSpec;
+    specHash = HashBytes(&spec, sizeof(spec));
+    return true;
+}
+
+bool ShardedSweep::Open()
+{
+    std::ifstream file(directory + "/sweep.spec", std::ios::binary);
+    SpecFileHeader header;
+    SweepSpec loaded;
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, SpecFileHeader().magic, sizeof(header.magic)) != 0 ||
+        !file.read(reinterpret_cast<char *>(&loaded), sizeof(loaded)) || loaded.blockSize == 0)
+        return false;
+
+    spec = loaded;
+    specHash = HashBytes(&spec, sizeof(spec));
+    return true;
+}
+
+size_t ShardedSweep::GetBlockCount() const
+{
+    return spec.blockSize ? size_t((spec.sampleCount + spec.blockSize - 1) / spec.blockSize) : 0;
+}
+
+std::string ShardedSweep::BlockPath(uint64_t block, const char *extension) const
+{
+    char name[64];
+    std::snprintf(name, sizeof(name), "/block-%06llu.%s", static_cast<unsigned long long>(block), extension);
+    return directory + name;
+}
+
+bool ShardedSweep::HasResult(uint64_t block) const
+{
+    return Exists(BlockPath(block, "result"));
+}
+
+std::string ShardedSweep::ClaimOwner() const
+{
+    return host + " " + std::to_string(::getpid());
+}
+
+bool ShardedSweep::TryClaim(uint64_t block)
+{
+    std::string claim = BlockPath(block, "claim");
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        int fd = ::open(claim.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0644);
+        if (fd >= 0)
+        {
+            std::string owner = ClaimOwner() + "\n";
+            bool written = ::write(fd, owner.data(), owner.size()) == ssize_t(owner.size());
+            ::close(fd);
+            // The block may have finished between our check and the claim
+            if (!written || HasResult(block))
+            {
+                ::unlink(claim.c_str());
+                return false;
+            }
+            return true;
+        }
+        if (errno != EEXIST)
+            return false;
+
+        // Take over a stale claim: only one worker wins the rename
+        struct stat info;
+        if (::stat(claim.c_str(), &info) != 0 || std::difftime(std::time(nullptr), info.st_mtime) < staleSeconds ||
+            HasResult(block))
+            return false;
+        std::string moved = claim + "." + host + "." + std::to_string(::getpid()) + ".stale";
+        if (std::rename(claim.c_str(), moved.c_str()) != 0)
+            return false;
+        ::unlink(moved.c_str());
+    }
+    return false;
+}
+
+// Heartbeat: bumps the claim's mtime if this process still owns it
+bool ShardedSweep::RenewClaim(uint64_t block) const
+{
+    std::string claim = BlockPath(block, "claim");
+    std::ifstream file(claim);
+    std::string line;
+    if (!std::getline(file, line) || line != ClaimOwner())
+        return false;
+    return ::utimensat(AT_FDCWD, claim.c_str(), nullptr, 0) == 0;
+}
+
+bool ShardedSweep::WriteResult(uint64_t block, const SweepAggregate &aggregate) const
+{
+    ResultFileHeader header;
+    header.specHash = specHash;
+    header.block = block;
+    std::string bytes(sizeof(header) + sizeof(aggregate), '\0');
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + sizeof(header), &aggregate, sizeof(aggregate));
+    return WriteFileAtomically(BlockPath(block, "result"), bytes);
+}
+
+bool ShardedSweep::ReadResult(uint64_t block, SweepAggregate &aggregate) const
+{
+    std::ifstream file(BlockPath(block, "result"), std::ios::binary);
+    ResultFileHeader header;
+    return file.read(reinterpret_cast<char *>(&header), sizeof(header)) &&
+           std::memcmp(header.magic, ResultFileHeader().magic, sizeof(header.magic)) == 0 &&
+           header.specHash == specHash && header.block == block &&
+           file.read(reinterpret_cast<char *>(&aggregate), sizeof(aggregate));
+}
+
+bool ShardedSweep::HasClaimableBlock() const
+{
+    for (uint64_t block = 0; block < GetBlockCount(); ++block)
+    {
+        if (HasResult(block) || Exists(BlockPath(block, "failed")))
+            continue;
+        struct stat info;
+        if (::stat(BlockPath(block, "claim").c_str(), &info) != 0 ||
+            std::difftime(std::time(nullptr), info.st_mtime) >= staleSeconds)
+            return true;
+    }
+    return false;
+}
+
+// ==============================
+// Worker
+// ==============================
+int ShardedSweep::Work(int maxBlocks, const std::function<void(uint64_t block)> &onClaim)
+{
+    Atmosphere atmosphere(spec.seaLevelPressure, spec.seaLevelTemp, spec.lapseRate, spec.molarMass);
+    OrbitalBody body(spec.bodyMassKg, spec.bodyRadius, &atmosphere);
+    body.SetOblateness(spec.j2);
+    body.SetRotation(spec.rotationRate);
+
+    using Clock = std::chrono::steady_clock;
+    const auto renewInterval = std::chrono::duration<double>(staleSeconds / 4.0);
+
+    int done = 0;
+    for (uint64_t block = 0; block < GetBlockCount() && (maxBlocks < 0 || done < maxBlocks); ++block)
+    {
+        if (HasResult(block) || Exists(BlockPath(block, "failed")) || !TryClaim(block))
+            continue;
+        if (onClaim)
+            onClaim(block);
+
+        Clock::time_point renewed = Clock::now();
+        bool owned = true;
+        auto heartbeat = [&]()
+        {
+            if (Clock::now() - renewed < renewInterval)
+                return true;
+            renewed = Clock::now();
+            owned = RenewClaim(block);
+            return owned;
+        };
+        SweepAggregate aggregate = RunSweepBlock(&body, spec, block, heartbeat);
+        if (!owned)
+            continue; // taken over as stale; the new owner finishes it
+
+        bool written = WriteResult(block, aggregate);
+        ::unlink(BlockPath(block, "claim").c_str());
+        if (!written)
+            return -1;
+        ++done;
+    }
+    return done;
+}
+
+// ==============================
+// Coordinator
+// ==============================
+std::vector<uint64_t> ShardedSweep::ReleaseClaims(int pid)
+{
+    std::vector<uint64_t> released;
+    std::string owner = host + " " + std::to_string(pid);
+    for (uint64_t block = 0; block < GetBlockCount(); ++block)
+    {
+        std::string claim = BlockPath(block, "claim");
+        std::ifstream file(claim);
+        std::string line;
+        if (!std::getline(file, line) || line != owner || HasResult(block))
+            continue;
+        ::unlink(claim.c_str());
+        released.push_back(block);
+    }
+    return released;
+}
+
+bool ShardedSweep::RunLocal(const std::vector<std::string> &command, int workerCount, int maxAttempts)
+{
+    if (command.empty() || workerCount < 1)
+        return false;
+
+    std::vector<std::string> arguments = command;
+    arguments.push_back(directory);
+    std::vector<char *> argv;
+    for (std::string &argument : arguments)
+        argv.push_back(argument.data());
+    argv.push_back(nullptr);
+
+    std::map<int, bool> live;
+    std::map<uint64_t, int> attempts;
+    int idleFailures = 0; // failures holding no claim, e.g. a bad command
+    auto spawn = [&]()
+    {
+        int pid = ::fork();
+        if (pid == 0)
+        {
+            ::execv(argv[0], argv.data());
+            ::_exit(127);
+        }
+        if (pid > 0)
+        {
+            live[pid] = true;
+            ++progress.workersStarted;
+        }
+        return pid > 0;
+    };
+
+    progress = SweepProgress();
+    while (int(live.size()) < workerCount && HasClaimableBlock() && spawn())
+        ;
+
+    while (!live.empty())
+    {
+        int status = 0;
+        int pid = ::waitpid(-1, &status, 0);
+        if (pid < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (!live.erase(pid))
+            continue;
+
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            ++progress.workerFailures;
+            std::vector<uint64_t> released = ReleaseClaims(pid);
+            if (released.empty())
+                ++idleFailures;
+            for (uint64_t block : released)
+                if (++attempts[block] >= maxAttempts)
+                    WriteFileAtomically(BlockPath(block, "failed"), std::to_string(attempts[block]) + "\n");
+        }
+
+        while (int(live.size()) < workerCount && idleFailures < maxAttempts * workerCount && HasClaimableBlock() && spawn())
+            ;
+    }
+
+    for (uint64_t block = 0; block < GetBlockCount(); ++block)
+    {
+        progress.completed += HasResult(block);
+        progress.failed += Exists(BlockPath(block, "failed"));
+    }
+    progress.blocks = GetBlockCount();
+    return progress.completed == progress.blocks;
+}
+
+bool ShardedSweep::Merge(SweepAggregate &total) const
+{
+    total = SweepAggregate();
+    for (uint64_t block = 0; block < GetBlockCount(); ++block)
+    {
+        SweepAggregate aggregate;
+        if (!ReadResult(block, aggregate))
+            return false;
+        total.Merge(aggregate);
+    }
+    return true;
+}
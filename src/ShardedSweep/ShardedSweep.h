@@ -0,0 +1,124 @@
+#pragma once
+#include <Scenario.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class OrbitalBody;
+
+// Everything a worker process needs to rebuild the sweep: the body and the
+// sample space. Plain data, stored as-is in the sweep directory.
+struct SweepSpec
+{
+    uint64_t sampleCount = 4096;
+    uint64_t blockSize = 128; // samples per block; fixes the merge order
+    uint64_t seed = 1;
+
+    // Monte Carlo ranges, uniform per sample
+    double velocityMin = -7500.0, velocityMax = -300.0;  // m/s
+    double shieldMassMin = 0.0, shieldMassMax = 400.0;   // kg
+    double dryMassMin = 2000.0, dryMassMax = 8000.0;     // kg
+    double chuteAreaMin = 0.0, chuteAreaMax = 0.0;       // m²
+
+    // Body
+    double bodyMassKg = 5.972e24;
+    double bodyRadius = 6.371e6; // m
+    double seaLevelPressure = 101325.0, seaLevelTemp = 288.15, lapseRate = 0.0065, molarMass = 0.0289644;
+    double j2 = 0.0;
+    double rotationRate = 0.0; // rad/s
+};
+
+// Per-block aggregate; blocks are always combined in index order, so the
+// totals are bit-identical however blocks were spread across processes
+struct SweepAggregate
+{
+    uint64_t samples = 0;
+    uint64_t outcomes[4] = {}; // by ScenarioOutcome
+    uint64_t steps = 0;
+    double impactSpeedSum = 0.0;
+    double impactSpeedSquares = 0.0;
+    double impactSpeedMax = 0.0;
+    double peakHeatSum = 0.0;
+    double peakHeatMax = 0.0;
+    double peakDecelerationMax = 0.0;
+    double shieldRemainingSum = 0.0;
+
+    void Add(const ScenarioResult &result);
+    void Merge(const SweepAggregate &block);
+    std::string Format() const;
+};
+
+// Sample `index` of the sweep, from a counter-based generator so any
+// process can produce any sample
+ReentryScenario SweepSample(const SweepSpec &spec, uint64_t index);
+// keepGoing runs between samples; returning false abandons the block and
+// leaves a partial aggregate
+SweepAggregate RunSweepBlock(OrbitalBody *body, const SweepSpec &spec, uint64_t block,
+                             const std::function<bool()> &keepGoing = nullptr);
+
+struct SweepProgress
+{
+    size_t blocks = 0;
+    size_t completed = 0;
+    size_t failed = 0;   // attempts exhausted
+    int workerFailures = 0;
+    int workersStarted = 0;
+};
+
+// Sweep split into fixed index blocks that independent worker processes
+// claim through a shared directory, on one machine or several sharing a
+// filesystem. A claim is a file created with O_EXCL naming its host and
+// pid; a finished block is a result file written via rename, which doubles
+// as its checkpoint, so a rerun only does the missing blocks. Claims left
+// by a dead local worker are released by the coordinator and the block is
+// retried; claims older than `staleSeconds` without a result (a lost node)
+// may be taken over by any worker. A working worker renews its claim's
+// mtime every quarter of `staleSeconds`, so a long block is never mistaken
+// for a lost one, and drops the block if its claim was taken over anyway.
+class ShardedSweep
+{
+public:
+    explicit ShardedSweep(const std::string &directory, double staleSeconds = 300.0);
+
+    // Coordinator: writes the spec, or keeps the existing directory and its
+    // results when the spec matches (resume); false on a different spec.
+    // Resuming clears blocks marked failed so they are tried again.
+    bool Create(const SweepSpec &spec);
+    // Worker: reads the spec written by Create
+    bool Open();
+
+    // Claim and run blocks until none are left or maxBlocks are done.
+    // onClaim runs after each claim, before the block is simulated.
+    int Work(int maxBlocks = -1, const std::function<void(uint64_t block)> &onClaim = nullptr);
+
+    // Fork/exec `workerCount` copies of `command` (argv; the directory is
+    // appended) and respawn after failures until every block has a result
+    // or has failed `maxAttempts` times
+    bool RunLocal(const std::vector<std::string> &command, int workerCount, int maxAttempts);
+
+    // Combines every block in index order; false if any is missing
+    bool Merge(SweepAggregate &total) const;
+
+    const SweepSpec &GetSpec() const { return spec; }
+    size_t GetBlockCount() const;
+    const SweepProgress &GetProgress() const { return progress; }
+
+private:
+    std::string BlockPath(uint64_t block, const char *extension) const;
+    bool HasResult(uint64_t block) const;
+    bool TryClaim(uint64_t block);
+    bool RenewClaim(uint64_t block) const; // false once another worker owns it
+    std::string ClaimOwner() const;
+    bool WriteResult(uint64_t block, const SweepAggregate &aggregate) const;
+    bool ReadResult(uint64_t block, SweepAggregate &aggregate) const;
+    std::vector<uint64_t> ReleaseClaims(int pid); // this host's claims without results
+    bool HasClaimableBlock() const;
+
+    std::string directory;
+    double staleSeconds;
+    SweepSpec spec;
+    uint64_t specHash;
+    std::string host;
+    SweepProgress progress;
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <physicssim.h>
+
+// Wire format for the local simulation service. Native byte order: the
+// socket never leaves the machine. Every message starts with a header;
+// payload structs are the C API's so embedders and clients share one layout.
+
+constexpr uint32_t serviceRequestMagic = 0x51525350;  // "PSRQ"
+constexpr uint32_t serviceResponseMagic = 0x53525350; // "PSRS"
+
+enum class ServiceMessageType : uint32_t
+{
+    RunReentry = 1, // payload: ps_reentry_scenario
+    GetStats = 2,   // no payload
+    Shutdown = 3    // no payload
+};
+
+enum ServiceRequestFlags : uint32_t
+{
+    ServiceStreamTrajectory = 1 // append trajectory samples to the summary
+};
+
+struct ServiceRequestHeader
+{
+    uint32_t magic = serviceRequestMagic;
+    uint32_t type = 0;
+    uint64_t requestId = 0;
+    uint32_t flags = 0;
+    uint32_t sampleInterval = 10; // steps between trajectory samples
+};
+
+struct ServiceResponseHeader
+{
+    uint32_t magic = serviceResponseMagic;
+    uint32_t type = 0;
+    uint64_t requestId = 0;
+    int32_t status = 0; // ps_status
+    uint32_t sampleCount = 0;
+};
+
+// RunReentry response: header, ps_run_summary, then sampleCount of these
+struct ServiceTrajectorySample
+{
+    float time;
+    float altitude;
+    float velocity;
+    float heatRate;
+};
+
+// GetStats response: header, then this
+struct ServiceStats
+{
+    uint64_t requests = 0;
+    uint64_t batches = 0;
+    uint64_t queueDepth = 0;
+    double meanBatchSize = 0.0;
+    double p50LatencyMicros = 0.0;
+    double p99LatencyMicros = 0.0;
+};
@@ -0,0 +1,499 @@
+#include "SimulationService.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    bool ReadFully(int fd, void *buffer, size_t size)
+    {
+        char *out = static_cast<char *>(buffer);
+        while (size > 0)
+        {
+            ssize_t n = ::recv(fd, out, size, 0);
+            if (n <= 0)
+                return false;
+            out += n;
+            size -= n;
+        }
+        return true;
+    }
+
+    bool WriteFully(int fd, const void *buffer, size_t size)
+    {
+        const char *in = static_cast<const char *>(buffer);
+        while (size > 0)
+        {
+            ssize_t n = ::send(fd, in, size, 0);
+            if (n <= 0)
+                return false;
+            in += n;
+            size -= n;
+        }
+        return true;
+    }
+
+    bool MakeAddress(const std::string &path, sockaddr_un &address)
+    {
+        if (path.size() >= sizeof(address.sun_path))
+            return false;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        return true;
+    }
+
+    double Percentile(std::vector<double> values, double fraction)
+    {
+        if (values.empty())
+            return 0.0;
+        size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+}
+
+// ==============================
+// Server
+// ==============================
+SimulationService::SimulationService(ps_body *body, const ServiceSettings &settings)
+    : body(body),
+      settings(settings),
+      listenFd(-1),
+      stopping(false),
+      activeReaders(0),
+      requestCount(0),
+      batchCount(0),
+      latencyCursor(0),
+      queueDepthGauge(0)
+{
+    MetricsRegistry &registry = MetricsRegistry::Global();
+    requestMetric = registry.AddCounter("physicssim_service_requests_total", "Reentry requests answered by the service.");
+    batchMetric = registry.AddCounter("physicssim_service_batches_total", "Request batches run by service workers.");
+    latencyMetric = registry.AddHistogram("physicssim_service_latency_seconds", "Request latency from receipt to response.",
+                                          MetricsRegistry::ExponentialBuckets(1e-5, 2.0, 20));
+}
+
+SimulationService::~SimulationService()
+{
+    Stop();
+}
+
+bool SimulationService::Start()
+{
+    // A client hanging up mid-response must not kill the daemon
+    std::signal(SIGPIPE, SIG_IGN);
+
+    sockaddr_un address;
+    if (!MakeAddress(settings.socketPath, address))
+        return false;
+
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0)
+        return false;
+
+    ::unlink(settings.socketPath.c_str());
+    if (::bind(listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+        ::listen(listenFd, 128) != 0)
+    {
+        ::close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+
+    int workerCount = settings.workerCount > 0
+                          ? settings.workerCount
+                          : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int i = 0; i < workerCount; ++i)
+        workers.emplace_back(&SimulationService::WorkerLoop, this);
+    acceptThread = std::thread(&SimulationService::AcceptLoop, this);
+
+    queueDepthGauge = MetricsRegistry::Global().AddGauge("physicssim_service_queue_depth", "Requests waiting for a worker.", [this]()
+                                                         {
+                                                             std::lock_guard<std::mutex> lock(queueMutex);
+                                                             return double(queue.size()); });
+    return true;
+}
+
+void SimulationService::Wait()
+{
+    std::unique_lock<std::mutex> lock(queueMutex);
+    stopped.wait(lock, [&]
+                 { return stopping.load(); });
+}
+
+void SimulationService::RequestStop()
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueReady.notify_all();
+    stopped.notify_all();
+
+    // Wakes the blocked accept()
+    if (listenFd >= 0)
+        ::shutdown(listenFd, SHUT_RDWR);
+}
+
+void SimulationService::Stop()
+{
+    RequestStop();
+
+    MetricsRegistry::Global().RemoveGauge(queueDepthGauge);
+    queueDepthGauge = 0;
+
+    if (acceptThread.joinable())
+        acceptThread.join();
+    for (std::thread &worker : workers)
+        worker.join();
+    workers.clear();
+
+    if (listenFd >= 0)
+    {
+        ::close(listenFd);
+        listenFd = -1;
+        ::unlink(settings.socketPath.c_str());
+    }
+
+    // Unblock readers, then wait for them to drop their connections
+    std::unique_lock<std::mutex> lock(connectionsMutex);
+    for (const std::shared_ptr<Connection> &connection : connections)
+        ::shutdown(connection->fd, SHUT_RDWR);
+    readersDone.wait(lock, [&]
+                     { return activeReaders == 0; });
+}
+
+SimulationService::Connection::~Connection()
+{
+    ::close(fd);
+}
+
+void SimulationService::AcceptLoop()
+{
+    while (true)
+    {
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return; // listening socket shut down
+        }
+
+        auto connection = std::make_shared<Connection>();
+        connection->fd = fd;
+
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        if (stopping)
+            return; // connection closes with the last reference
+        connections.push_back(connection);
+        ++activeReaders;
+        std::thread(&SimulationService::ReadLoop, this, connection).detach();
+    }
+}
+
+void SimulationService::ReadLoop(std::shared_ptr<Connection> connection)
+{
+    ServiceRequestHeader header;
+    while (ReadFully(connection->fd, &header, sizeof(header)) && header.magic == serviceRequestMagic)
+    {
+        auto type = static_cast<ServiceMessageType>(header.type);
+        if (type == ServiceMessageType::RunReentry)
+        {
+            PendingRequest request{connection, header, {}, std::chrono::steady_clock::now()};
+            if (!ReadFully(connection->fd, &request.scenario, sizeof(request.scenario)))
+                break;
+
+            // Turned away here, so one bad request cannot fail the batch it
+            // would have joined or hold a worker for an unbounded run
+            if (!Admit(request.scenario))
+            {
+                Respond(request, PS_ERROR_INVALID_ARGUMENT, ps_run_summary{}, {});
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                queue.push_back(std::move(request));
+            }
+            queueReady.notify_one();
+        }
+        else if (type == ServiceMessageType::GetStats || type == ServiceMessageType::Shutdown)
+        {
+            ServiceResponseHeader response;
+            response.type = header.type;
+            response.requestId = header.requestId;
+            ServiceStats stats = GetStats();
+
+            std::lock_guard<std::mutex> lock(connection->writeMutex);
+            WriteFully(connection->fd, &response, sizeof(response));
+            if (type == ServiceMessageType::GetStats)
+                WriteFully(connection->fd, &stats, sizeof(stats));
+            else
+                RequestStop();
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    connections.erase(std::remove(connections.begin(), connections.end(), connection), connections.end());
+    if (--activeReaders == 0)
+        readersDone.notify_all();
+}
+
+bool SimulationService::Admit(const ps_reentry_scenario &scenario) const
+{
+    double deltaTime = scenario.delta_time;
+    double maxTime = scenario.max_time;
+    return std::isfinite(deltaTime) && deltaTime > 0.0 &&
+           std::isfinite(maxTime) && maxTime >= 0.0 &&
+           maxTime / deltaTime <= settings.maxStepsPerRequest;
+}
+
+void SimulationService::WorkerLoop()
+{
+    std::vector<PendingRequest> batch;
+    std::vector<double> columns; // trajectory scratch, reused across batches
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [&]
+                            { return stopping || !queue.empty(); });
+            if (queue.empty())
+                return; // stopping
+
+            // Under load the queue fills while workers are busy and batches
+            // form on their own; the optional window trades latency for size.
+            if (settings.batchWindowMicros > 0 && queue.size() < settings.maxBatchSize)
+                queueReady.wait_for(lock, std::chrono::microseconds(settings.batchWindowMicros), [&]
+                                    { return stopping || queue.size() >= settings.maxBatchSize; });
+
+            size_t take = std::min(queue.size(), settings.maxBatchSize);
+            for (size_t i = 0; i < take; ++i)
+            {
+                batch.push_back(std::move(queue.front()));
+                queue.pop_front();
+            }
+        }
+
+        RunBatch(batch, columns);
+        batch.clear();
+    }
+}
+
+void SimulationService::RunBatch(std::vector<PendingRequest> &batch, std::vector<double> &columns)
+{
+    const size_t count = batch.size();
+    const size_t capacity = settings.maxTrajectorySamples;
+
+    std::vector<ps_reentry_scenario> scenarios(count);
+    std::vector<ps_run_summary> summaries(count);
+    std::vector<ps_telemetry_columns> telemetry(count);
+
+    // Only streaming requests get columns; the buffer only ever grows
+    size_t streamCount = 0;
+    for (const PendingRequest &request : batch)
+        if (request.header.flags & ServiceStreamTrajectory)
+            ++streamCount;
+    if (columns.size() < streamCount * capacity * 4)
+        columns.resize(streamCount * capacity * 4);
+
+    size_t streamIndex = 0;
+    bool anyStream = false;
+    for (size_t i = 0; i < count; ++i)
+    {
+        scenarios[i] = batch[i].scenario;
+        telemetry[i] = ps_telemetry_columns{};
+        if (batch[i].header.flags & ServiceStreamTrajectory)
+        {
+            double *base = columns.data() + streamIndex++ * capacity * 4;
+            telemetry[i].time = base;
+            telemetry[i].altitude = base + capacity;
+            telemetry[i].velocity = base + 2 * capacity;
+            telemetry[i].heat_rate = base + 3 * capacity;
+            telemetry[i].capacity = capacity;
+            telemetry[i].interval = batch[i].header.sampleInterval;
+            anyStream = true;
+        }
+    }
+
+    // Requests are already spread across workers; one thread per batch
+    ps_status batchStatus = ps_run_reentry_batch(body, scenarios.data(), count, summaries.data(),
+                                                 anyStream ? telemetry.data() : nullptr, 1);
+
+    // Counted before any reply so a client's next GetStats already sees it
+    batchMetric.Add();
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        ++batchCount;
+    }
+
+    std::vector<ServiceTrajectorySample> samples;
+    for (size_t i = 0; i < count; ++i)
+    {
+        bool stream = batch[i].header.flags & ServiceStreamTrajectory;
+        int32_t status = batchStatus < 0 ? batchStatus
+                         : (stream && telemetry[i].dropped > 0) ? PS_TELEMETRY_TRUNCATED
+                                                                 : PS_OK;
+
+        samples.clear();
+        if (stream)
+            for (size_t row = 0; row < telemetry[i].count; ++row)
+                samples.push_back({float(telemetry[i].time[row]), float(telemetry[i].altitude[row]),
+                                   float(telemetry[i].velocity[row]), float(telemetry[i].heat_rate[row])});
+        Respond(batch[i], status, summaries[i], samples);
+    }
+}
+
+void SimulationService::Respond(PendingRequest &request, int32_t status, const ps_run_summary &summary,
+                                const std::vector<ServiceTrajectorySample> &samples)
+{
+    ServiceResponseHeader response;
+    response.type = request.header.type;
+    response.requestId = request.header.requestId;
+    response.status = status;
+    response.sampleCount = static_cast<uint32_t>(samples.size());
+
+    // Counted before the write so a client's next GetStats already sees it
+    RecordLatency(request.received);
+
+    std::lock_guard<std::mutex> lock(request.connection->writeMutex);
+    int fd = request.connection->fd;
+    WriteFully(fd, &response, sizeof(response)) &&
+        WriteFully(fd, &summary, sizeof(summary)) &&
+        WriteFully(fd, samples.data(), samples.size() * sizeof(ServiceTrajectorySample));
+}
+
+void SimulationService::RecordLatency(std::chrono::steady_clock::time_point received)
+{
+    double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - received).count();
+    requestMetric.Add();
+    latencyMetric.Observe(micros * 1e-6);
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    ++requestCount;
+    if (latencies.size() < settings.latencyWindow)
+        latencies.push_back(micros);
+    else
+        latencies[latencyCursor] = micros;
+    latencyCursor = (latencyCursor + 1) % settings.latencyWindow;
+}
+
+ServiceStats SimulationService::GetStats() const
+{
+    ServiceStats stats;
+    std::vector<double> window;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.requests = requestCount;
+        stats.batches = batchCount;
+        window = latencies;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stats.queueDepth = queue.size();
+    }
+
+    stats.meanBatchSize = stats.batches ? double(stats.requests) / stats.batches : 0.0;
+    stats.p50LatencyMicros = Percentile(window, 0.50);
+    stats.p99LatencyMicros = Percentile(window, 0.99);
+    return stats;
+}
+
+// ==============================
+// Client
+// ==============================
+SimulationClient::~SimulationClient()
+{
+    Close();
+}
+
+bool SimulationClient::Connect(const std::string &socketPath)
+{
+    Close();
+
+    sockaddr_un address;
+    if (!MakeAddress(socketPath, address))
+        return false;
+
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return false;
+    if (::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void SimulationClient::Close()
+{
+    if (fd >= 0)
+        ::close(fd);
+    fd = -1;
+}
+
+bool SimulationClient::Send(const ServiceRequestHeader &header, const void *payload, size_t size)
+{
+    return fd >= 0 && WriteFully(fd, &header, sizeof(header)) && (size == 0 || WriteFully(fd, payload, size));
+}
+
+bool SimulationClient::ReadHeader(ServiceResponseHeader &header)
+{
+    return ReadFully(fd, &header, sizeof(header)) && header.magic == serviceResponseMagic;
+}
+
+bool SimulationClient::RunReentry(const ps_reentry_scenario &scenario,
+                                  ps_run_summary &summary,
+                                  std::vector<ServiceTrajectorySample> *trajectory,
+                                  uint32_t sampleInterval)
+{
+    ServiceRequestHeader header;
+    header.type = static_cast<uint32_t>(ServiceMessageType::RunReentry);
+    header.requestId = nextRequestId++;
+    header.flags = trajectory ? ServiceStreamTrajectory : 0;
+    header.sampleInterval = sampleInterval;
+
+    ServiceResponseHeader response;
+    if (!Send(header, &scenario, sizeof(scenario)) || !ReadHeader(response) ||
+        !ReadFully(fd, &summary, sizeof(summary)))
+        return false;
+
+    std::vector<ServiceTrajectorySample> samples(response.sampleCount);
+    if (!ReadFully(fd, samples.data(), samples.size() * sizeof(ServiceTrajectorySample)))
+        return false;
+    if (trajectory)
+        trajectory->swap(samples);
+
+    return response.status >= 0;
+}
+
+bool SimulationClient::GetStats(ServiceStats &stats)
+{
+    ServiceRequestHeader header;
+    header.type = static_cast<uint32_t>(ServiceMessageType::GetStats);
+    header.requestId = nextRequestId++;
+
+    ServiceResponseHeader response;
+    return Send(header, nullptr, 0) && ReadHeader(response) && ReadFully(fd, &stats, sizeof(stats));
+}
+
+bool SimulationClient::RequestShutdown()
+{
+    ServiceRequestHeader header;
+    header.type = static_cast<uint32_t>(ServiceMessageType::Shutdown);
+    header.requestId = nextRequestId++;
+
+    ServiceResponseHeader response;
+    return Send(header, nullptr, 0) && ReadHeader(response);
+}
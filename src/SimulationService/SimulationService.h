@@ -0,0 +1,125 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <MetricsRegistry.h>
+#include <ServiceProtocol.h>
+
+struct ServiceSettings
+{
+    std::string socketPath = "/tmp/physicssim.sock";
+    int workerCount = 0;          // 0 = hardware concurrency
+    size_t maxBatchSize = 64;     // requests per batch
+    int batchWindowMicros = 0;    // extra wait to fill a batch; 0 = take what is queued
+    size_t maxTrajectorySamples = 4096;
+    double maxStepsPerRequest = 1e6; // max_time / delta_time; larger requests are rejected
+    size_t latencyWindow = 65536; // most recent requests kept for percentiles
+};
+
+// Long-running daemon answering reentry what-ifs over a Unix domain socket.
+// Connections are read on their own threads; requests from all of them go
+// into one queue that workers drain in batches, so bursts of small queries
+// share wakeups and batch runs instead of paying per-process startup.
+class SimulationService
+{
+public:
+    SimulationService(ps_body *body, const ServiceSettings &settings = ServiceSettings());
+    ~SimulationService();
+
+    bool Start();
+    void Wait(); // until Stop() or a Shutdown request
+    void Stop();
+
+    ServiceStats GetStats() const;
+
+private:
+    struct Connection
+    {
+        ~Connection(); // closes fd once no pending response needs it
+
+        int fd = -1;
+        std::mutex writeMutex; // one response on the wire at a time
+    };
+
+    struct PendingRequest
+    {
+        std::shared_ptr<Connection> connection;
+        ServiceRequestHeader header;
+        ps_reentry_scenario scenario;
+        std::chrono::steady_clock::time_point received;
+    };
+
+    void AcceptLoop();
+    void ReadLoop(std::shared_ptr<Connection> connection);
+    void WorkerLoop();
+    bool Admit(const ps_reentry_scenario &scenario) const;
+    void RunBatch(std::vector<PendingRequest> &batch, std::vector<double> &columns);
+    void Respond(PendingRequest &request, int32_t status, const ps_run_summary &summary,
+                 const std::vector<ServiceTrajectorySample> &samples);
+    void RecordLatency(std::chrono::steady_clock::time_point received);
+    void RequestStop();
+
+    ps_body *body;
+    ServiceSettings settings;
+    int listenFd;
+    std::atomic<bool> stopping; // set under queueMutex so waiters cannot miss it
+
+    mutable std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::condition_variable stopped;
+    std::deque<PendingRequest> queue;
+
+    std::mutex connectionsMutex;
+    std::condition_variable readersDone;
+    std::vector<std::shared_ptr<Connection>> connections;
+    int activeReaders;
+
+    std::thread acceptThread;
+    std::vector<std::thread> workers;
+
+    mutable std::mutex statsMutex;
+    uint64_t requestCount;
+    uint64_t batchCount;
+    std::vector<double> latencies; // ring buffer, µs
+    size_t latencyCursor;
+
+    // Mirrored into MetricsRegistry::Global() for the exporter
+    MetricCounter requestMetric;
+    MetricCounter batchMetric;
+    MetricHistogram latencyMetric;
+    int queueDepthGauge;
+};
+
+// Blocking client for one connection
+class SimulationClient
+{
+public:
+    SimulationClient() = default;
+    ~SimulationClient();
+    SimulationClient(const SimulationClient &) = delete;
+    SimulationClient &operator=(const SimulationClient &) = delete;
+
+    bool Connect(const std::string &socketPath);
+    void Close();
+
+    // trajectory may be null; when given, samples are streamed back
+    bool RunReentry(const ps_reentry_scenario &scenario,
+                    ps_run_summary &summary,
+                    std::vector<ServiceTrajectorySample> *trajectory = nullptr,
+                    uint32_t sampleInterval = 10);
+    bool GetStats(ServiceStats &stats);
+    bool RequestShutdown();
+
+private:
+    bool Send(const ServiceRequestHeader &header, const void *payload, size_t size);
+    bool ReadHeader(ServiceResponseHeader &header);
+
+    int fd = -1;
+    uint64_t nextRequestId = 1;
+};
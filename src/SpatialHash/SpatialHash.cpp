@@ -0,0 +1,172 @@
+#include "SpatialHash.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialHash::SpatialHash(double cellSizeMeters)
+    : cellSize(cellSizeMeters),
+      inverseCellSize(1.0 / cellSizeMeters) {}
+
+int64_t SpatialHash::CellCoord(double value) const
+{
+    return static_cast<int64_t>(std::floor(value * inverseCellSize));
+}
+
+uint64_t SpatialHash::CellKey(int64_t ix, int64_t iy, int64_t iz)
+{
+    // 21 bits per axis, offset so negative coordinates pack cleanly
+    constexpr int64_t offset = 1 << 20;
+    constexpr uint64_t mask = (1u << 21) - 1;
+    return ((static_cast<uint64_t>(ix + offset) & mask) << 42) |
+           ((static_cast<uint64_t>(iy + offset) & mask) << 21) |
+           (static_cast<uint64_t>(iz + offset) & mask);
+}
+
+void SpatialHash::Build(const std::vector<Vector3> &newPoints)
+{
+    points = newPoints;
+    cells.clear();
+    inserted.clear();
+
+    std::vector<std::pair<uint64_t, int>> keyed;
+    keyed.reserve(points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        const Vector3 &p = points[i];
+        keyed.emplace_back(CellKey(CellCoord(p.x), CellCoord(p.y), CellCoord(p.z)), static_cast<int>(i));
+    }
+    std::sort(keyed.begin(), keyed.end());
+
+    sortedIndices.resize(keyed.size());
+    cells.reserve(keyed.size());
+    for (size_t i = 0; i < keyed.size();)
+    {
+        size_t end = i;
+        while (end < keyed.size() && keyed[end].first == keyed[i].first)
+        {
+            sortedIndices[end] = keyed[end].second;
+            ++end;
+        }
+        cells[keyed[i].first] = {static_cast<int>(i), static_cast<int>(end)};
+        i = end;
+    }
+}
+
+int SpatialHash::Insert(const Vector3 &point)
+{
+    int index = static_cast<int>(points.size());
+    points.push_back(point);
+    inserted[CellKey(CellCoord(point.x), CellCoord(point.y), CellCoord(point.z))].push_back(index);
+    return index;
+}
+
+void SpatialHash::QueryBox(const Vector3 &minCorner, const Vector3 &maxCorner, std::vector<int> &out) const
+{
+    out.clear();
+    if (points.empty())
+        return;
+
+    int64_t x0 = CellCoord(minCorner.x), x1 = CellCoord(maxCorner.x);
+    int64_t y0 = CellCoord(minCorner.y), y1 = CellCoord(maxCorner.y);
+    int64_t z0 = CellCoord(minCorner.z), z1 = CellCoord(maxCorner.z);
+
+    auto inside = [&](const Vector3 &p)
+    {
+        return p.x >= minCorner.x && p.x <= maxCorner.x &&
+               p.y >= minCorner.y && p.y <= maxCorner.y &&
+               p.z >= minCorner.z && p.z <= maxCorner.z;
+    };
+
+    // Large boxes: walking every occupied cell is cheaper than every covered cell
+    double coveredCells = double(x1 - x0 + 1) * double(y1 - y0 + 1) * double(z1 - z0 + 1);
+    if (coveredCells > static_cast<double>(cells.size() + inserted.size()))
+    {
+        for (const auto &cell : cells)
+            for (int i = cell.second.first; i < cell.second.second; ++i)
+                if (inside(points[sortedIndices[i]]))
+                    out.push_back(sortedIndices[i]);
+        for (const auto &cell : inserted)
+            for (int i : cell.second)
+                if (inside(points[i]))
+                    out.push_back(i);
+        return;
+    }
+
+    for (int64_t ix = x0; ix <= x1; ++ix)
+        for (int64_t iy = y0; iy <= y1; ++iy)
+            for (int64_t iz = z0; iz <= z1; ++iz)
+            {
+                uint64_t key = CellKey(ix, iy, iz);
+                auto it = cells.find(key);
+                if (it != cells.end())
+                    for (int i = it->second.first; i < it->second.second; ++i)
+                        if (inside(points[sortedIndices[i]]))
+                            out.push_back(sortedIndices[i]);
+                auto added = inserted.find(key);
+                if (added != inserted.end())
+                    for (int i : added->second)
+                        if (inside(points[i]))
+                            out.push_back(i);
+            }
+}
+
+void SpatialHash::QueryRadius(const Vector3 &center, double radius, std::vector<int> &out) const
+{
+    Vector3 extent(radius, radius, radius);
+    QueryBox(center - extent, center + extent, out);
+
+    double radiusSquared = radius * radius;
+    out.erase(std::remove_if(out.begin(), out.end(),
+                             [&](int i)
+                             {
+                                 Vector3 d = points[i] - center;
+                                 return d.Dot(d) > radiusSquared;
+                             }),
+              out.end());
+}
+
+size_t SpatialHash::FindDensestCell(Vector3 &cellCenter) const
+{
+    size_t best = 0;
+    auto consider = [&](uint64_t key, int representative)
+    {
+        size_t count = 0;
+        auto it = cells.find(key);
+        if (it != cells.end())
+            count += it->second.second - it->second.first;
+        auto added = inserted.find(key);
+        if (added != inserted.end())
+            count += added->second.size();
+        if (count <= best)
+            return;
+        best = count;
+        const Vector3 &p = points[representative];
+        cellCenter = Vector3((CellCoord(p.x) + 0.5) * cellSize,
+                             (CellCoord(p.y) + 0.5) * cellSize,
+                             (CellCoord(p.z) + 0.5) * cellSize);
+    };
+
+    for (const auto &cell : cells)
+        consider(cell.first, sortedIndices[cell.second.first]);
+    for (const auto &cell : inserted)
+        consider(cell.first, cell.second.front());
+    return best;
+}
+
+size_t SpatialHash::GetPointCount() const
+{
+    return points.size();
+}
+
+size_t SpatialHash::GetOccupiedCellCount() const
+{
+    size_t count = cells.size();
+    for (const auto &cell : inserted)
+        if (!cells.count(cell.first))
+            ++count;
+    return count;
+}
+
+double SpatialHash::GetCellSize() const
+{
+    return cellSize;
+}
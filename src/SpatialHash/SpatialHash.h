@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <Vector3.h>
+
+// Uniform-grid spatial hash over a snapshot of points.
+// Build() is O(n log n) (one sort of cell keys); queries only visit the
+// cells overlapping the search volume, so proximity work stays near-linear
+// in the number of points instead of quadratic. Insert() adds one point in
+// O(1) for sets that only grow, without re-sorting the snapshot.
+class SpatialHash
+{
+public:
+    explicit SpatialHash(double cellSizeMeters = 100.0);
+
+    // Re-index the given points. Indices returned by queries refer to this array.
+    void Build(const std::vector<Vector3> &points);
+
+    // Append one point; its index is the point count before the call
+    int Insert(const Vector3 &point);
+
+    // All points within `radius` of `center` (inclusive)
+    void QueryRadius(const Vector3 &center, double radius, std::vector<int> &out) const;
+
+    // All points inside the axis-aligned box [minCorner, maxCorner]
+    void QueryBox(const Vector3 &minCorner, const Vector3 &maxCorner, std::vector<int> &out) const;
+
+    // Point count of the most populated cell (0 if empty), and its centre
+    size_t FindDensestCell(Vector3 &cellCenter) const;
+
+    size_t GetPointCount() const;
+    size_t GetOccupiedCellCount() const;
+    double GetCellSize() const;
+
+private:
+    int64_t CellCoord(double value) const;
+    static uint64_t CellKey(int64_t ix, int64_t iy, int64_t iz);
+
+    double cellSize;        // m
+    double inverseCellSize; // 1/m
+    std::vector<Vector3> points;
+    std::vector<int> sortedIndices;                            // point indices grouped by cell
+    std::unordered_map<uint64_t, std::pair<int, int>> cells; // key -> [begin, end) in sortedIndices
+    std::unordered_map<uint64_t, std::vector<int>> inserted; // key -> points added since Build
+};
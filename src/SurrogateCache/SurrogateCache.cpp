@@ -0,0 +1,389 @@
+#include "SurrogateCache.h"
+#include <Scenario.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    // Fixed bounds keep the per-query fit on the stack
+    constexpr size_t maxParameters = 16;
+    constexpr size_t maxOutputs = 16;
+
+    struct SurrogateFileHeader
+    {
+        char magic[8] = {'P', 'S', 'I', 'M', 'S', 'U', 'R', '1'};
+        uint32_t parameterCount = 0;
+        uint32_t outputCount = 0;
+        uint64_t sampleCount = 0;
+    };
+
+    // NaN or infinite parameters have no cell: floor(NaN) converted to an
+    // integer is undefined
+    bool AllFinite(const double *values, size_t count)
+    {
+        return std::all_of(values, values + count, [](double value) { return std::isfinite(value); });
+    }
+}
+
+const char *ToString(SurrogateSource source)
+{
+    switch (source)
+    {
+    case SurrogateSource::Exact:
+        return "exact";
+    case SurrogateSource::Predicted:
+        return "predicted";
+    case SurrogateSource::Simulated:
+        return "simulated";
+    }
+    return "unknown";
+}
+
+SurrogateCache::SurrogateCache(size_t parameterCount, size_t outputCount, const SurrogateSettings &settings)
+    : parameterCount(parameterCount),
+      outputCount(outputCount),
+      settings(settings),
+      sampleCount(0)
+{
+    this->settings.cellSizes.resize(parameterCount, 1.0);
+    this->settings.outputTolerances.resize(outputCount, INFINITY);
+    this->settings.relativeTolerances.resize(outputCount, 0.0);
+}
+
+void SurrogateCache::CellOf(const double *point, int64_t *cell) const
+{
+    for (size_t d = 0; d < parameterCount; ++d)
+        cell[d] = int64_t(std::floor(point[d] / settings.cellSizes[d]));
+}
+
+uint64_t SurrogateCache::HashCell(const int64_t *cell, size_t dimensions)
+{
+    // splitmix64 over the coordinates
+    uint64_t hash = 0x9e3779b97f4a7c15ull;
+    for (size_t d = 0; d < dimensions; ++d)
+    {
+        hash ^= uint64_t(cell[d]) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+        hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+        hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+        hash ^= hash >> 31;
+    }
+    return hash;
+}
+
+SurrogateAnswer SurrogateCache::Predict(const std::vector<double> &query) const
+{
+    SurrogateAnswer answer;
+    answer.outputs.assign(outputCount, 0.0);
+    answer.uncertainty.assign(outputCount, INFINITY);
+    if (query.size() != parameterCount || !AllFinite(query.data(), query.size()))
+        return answer;
+
+    // === Gather samples from the (2r + 1)^d surrounding cells ===
+    const int radius = settings.neighbourRadius;
+    const double cutoff = radius + 1.0; // cell units; drops hash collisions from far away
+    int64_t center[maxParameters], cell[maxParameters];
+    if (parameterCount > maxParameters || outputCount > maxOutputs)
+        return answer;
+    CellOf(query.data(), center);
+
+    std::vector<double> weights;
+    std::vector<uint32_t> neighbours;
+    int64_t offsets[maxParameters];
+    std::fill(offsets, offsets + parameterCount, -radius);
+    for (bool more = true; more;)
+    {
+        for (size_t d = 0; d < parameterCount; ++d)
+            cell[d] = center[d] + offsets[d];
+
+        auto found = cells.find(HashCell(cell, parameterCount));
+        if (found != cells.end())
+            for (uint32_t sample : found->second)
+            {
+                const double *p = &parameters[size_t(sample) * parameterCount];
+                double distance2 = 0.0;
+                for (size_t d = 0; d < parameterCount; ++d)
+                {
+                    double delta = (p[d] - query[d]) / settings.cellSizes[d];
+                    distance2 += delta * delta;
+                }
+                if (distance2 == 0.0)
+                {
+                    // Stored sample with these exact parameters
+                    answer.outputs.assign(&outputs[size_t(sample) * outputCount],
+                                          &outputs[size_t(sample) * outputCount] + outputCount);
+                    answer.uncertainty.assign(outputCount, 0.0);
+                    answer.source = SurrogateSource::Exact;
+                    answer.neighbours = 1;
+                    return answer;
+                }
+                if (distance2 <= cutoff * cutoff)
+                {
+                    neighbours.push_back(sample);
+                    weights.push_back(1.0 / (1.0 + distance2));
+                }
+            }
+
+        // Next offset, odometer style
+        more = false;
+        for (size_t d = 0; d < parameterCount && !more; ++d)
+        {
+            if (++offsets[d] <= radius)
+                more = true;
+            else
+                offsets[d] = -radius;
+        }
+    }
+
+    const size_t terms = parameterCount + 1;
+    // At least one sample more than fitted terms, or there is no residual
+    // left to estimate the uncertainty from
+    const size_t required = std::max(settings.minNeighbours > 0 ? size_t(settings.minNeighbours) : 2 * terms,
+                                     terms + 1);
+    answer.neighbours = int(neighbours.size());
+    if (neighbours.size() < required)
+        return answer;
+
+    // === Weighted least squares: y = c0 + sum c_d x_d, x in cell units around the query ===
+    double normal[maxParameters + 1][maxParameters + 1] = {};
+    double rhs[maxParameters + 1][maxOutputs] = {}; // [term][output]
+    double basis[maxParameters + 1];
+    basis[0] = 1.0;
+    for (size_t i = 0; i < neighbours.size(); ++i)
+    {
+        const double *p = &parameters[size_t(neighbours[i]) * parameterCount];
+        const double *y = &outputs[size_t(neighbours[i]) * outputCount];
+        for (size_t d = 0; d < parameterCount; ++d)
+            basis[d + 1] = (p[d] - query[d]) / settings.cellSizes[d];
+        for (size_t a = 0; a < terms; ++a)
+        {
+            for (size_t b = 0; b <= a; ++b)
+                normal[a][b] += weights[i] * basis[a] * basis[b];
+            for (size_t k = 0; k < outputCount; ++k)
+                rhs[a][k] += weights[i] * basis[a] * y[k];
+        }
+    }
+    for (size_t a = 1; a < terms; ++a)
+        normal[a][a] += settings.ridge;
+
+    // Cholesky in place (lower triangle)
+    for (size_t a = 0; a < terms; ++a)
+    {
+        for (size_t b = 0; b <= a; ++b)
+        {
+            double sum = normal[a][b];
+            for (size_t c = 0; c < b; ++c)
+                sum -= normal[a][c] * normal[b][c];
+            if (a == b)
+            {
+                if (sum <= 0.0)
+                    return answer;
+                normal[a][a] = std::sqrt(sum);
+            }
+            else
+                normal[a][b] = sum / normal[b][b];
+        }
+    }
+
+    // Leverage of each sample, h = w b^T (X^T W X)^-1 b. Dividing a residual
+    // by 1 - h gives its leave-one-out residual: the error the fit would
+    // make at that sample without it, which also picks up curvature the
+    // linear model misses rather than just the scatter around it.
+    constexpr double maxLeverage = 0.95;
+    std::vector<double> looScale(neighbours.size());
+    double weightSum = 0.0;
+    for (size_t i = 0; i < neighbours.size(); ++i)
+    {
+        const double *p = &parameters[size_t(neighbours[i]) * parameterCount];
+        double z[maxParameters + 1];
+        z[0] = 1.0;
+        for (size_t d = 0; d < parameterCount; ++d)
+            z[d + 1] = (p[d] - query[d]) / settings.cellSizes[d];
+        double zz = 0.0;
+        for (size_t a = 0; a < terms; ++a)
+        {
+            for (size_t c = 0; c < a; ++c)
+                z[a] -= normal[a][c] * z[c];
+            z[a] /= normal[a][a];
+            zz += z[a] * z[a];
+        }
+        looScale[i] = 1.0 / (1.0 - std::min(weights[i] * zz, maxLeverage));
+        weightSum += weights[i];
+    }
+
+    // Same for the query itself, basis (1, 0, ...): 1 at the weighted
+    // centroid of the neighbours, growing as the query moves toward the
+    // edge of the samples and the fit extrapolates
+    double e[maxParameters + 1] = {1.0};
+    double queryLeverage = 0.0;
+    for (size_t a = 0; a < terms; ++a)
+    {
+        for (size_t c = 0; c < a; ++c)
+            e[a] -= normal[a][c] * e[c];
+        e[a] /= normal[a][a];
+        queryLeverage += e[a] * e[a];
+    }
+    const double extrapolation = std::sqrt(std::max(1.0, weightSum * queryLeverage));
+
+    // A spread estimated from a handful of residuals is itself uncertain;
+    // widen it the way a t quantile widens a normal one at low counts
+    const double fewSamples = std::sqrt(double(neighbours.size()) / double(neighbours.size() - terms));
+
+    double coefficients[maxParameters + 1];
+    for (size_t k = 0; k < outputCount; ++k)
+    {
+        for (size_t a = 0; a < terms; ++a)
+        {
+            double sum = rhs[a][k];
+            for (size_t c = 0; c < a; ++c)
+                sum -= normal[a][c] * coefficients[c];
+            coefficients[a] = sum / normal[a][a];
+        }
+        for (size_t a = terms; a-- > 0;)
+        {
+            double sum = coefficients[a];
+            for (size_t c = a + 1; c < terms; ++c)
+                sum -= normal[c][a] * coefficients[c];
+            coefficients[a] = sum / normal[a][a];
+        }
+
+        // The intercept is the estimate at the query; the uncertainty is the
+        // weighted RMS of the leave-one-out residuals, widened when the query
+        // sits off-centre
+        double residual2 = 0.0;
+        for (size_t i = 0; i < neighbours.size(); ++i)
+        {
+            const double *p = &parameters[size_t(neighbours[i]) * parameterCount];
+            double fitted = coefficients[0];
+            for (size_t d = 0; d < parameterCount; ++d)
+                fitted += coefficients[d + 1] * (p[d] - query[d]) / settings.cellSizes[d];
+            double delta = (outputs[size_t(neighbours[i]) * outputCount + k] - fitted) * looScale[i];
+            residual2 += weights[i] * delta * delta;
+        }
+        answer.outputs[k] = coefficients[0];
+        answer.uncertainty[k] = std::sqrt(residual2 / weightSum) * extrapolation * fewSamples;
+    }
+    return answer;
+}
+
+SurrogateAnswer SurrogateCache::Query(const std::vector<double> &query,
+                                      const std::function<std::vector<double>(const std::vector<double> &)> &simulate)
+{
+    SurrogateAnswer answer = Predict(query);
+
+    bool confident = true;
+    for (size_t k = 0; k < outputCount; ++k)
+        confident = confident && answer.uncertainty[k] <= settings.outputTolerances[k] +
+                                                          settings.relativeTolerances[k] * std::abs(answer.outputs[k]);
+    if (confident)
+        return answer;
+
+    answer.outputs = simulate(query);
+    if (answer.outputs.size() != outputCount)
+        return answer;
+    Insert(query, answer.outputs);
+    answer.uncertainty.assign(outputCount, 0.0);
+    answer.source = SurrogateSource::Simulated;
+    return answer;
+}
+
+void SurrogateCache::Insert(const std::vector<double> &point, const std::vector<double> &values)
+{
+    if (point.size() != parameterCount || values.size() != outputCount || !AllFinite(point.data(), point.size()))
+        return;
+
+    int64_t cell[maxParameters];
+    if (parameterCount > maxParameters || outputCount > maxOutputs)
+        return;
+    CellOf(point.data(), cell);
+    cells[HashCell(cell, parameterCount)].push_back(uint32_t(sampleCount));
+    parameters.insert(parameters.end(), point.begin(), point.end());
+    outputs.insert(outputs.end(), values.begin(), values.end());
+    ++sampleCount;
+}
+
+bool SurrogateCache::Save(const std::string &path) const
+{
+    SurrogateFileHeader header;
+    header.parameterCount = uint32_t(parameterCount);
+    header.outputCount = uint32_t(outputCount);
+    header.sampleCount = sampleCount;
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(parameters.data()), parameters.size() * sizeof(double));
+    file.write(reinterpret_cast<const char *>(outputs.data()), outputs.size() * sizeof(double));
+    return bool(file);
+}
+
+bool SurrogateCache::Load(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    const uint64_t fileSize = file ? uint64_t(file.tellg()) : 0;
+    file.seekg(0);
+    SurrogateFileHeader header;
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, SurrogateFileHeader().magic, sizeof(header.magic)) != 0 ||
+        header.parameterCount != parameterCount || header.outputCount != outputCount)
+        return false;
+
+    // The samples must fit in the rest of the file before anything is sized
+    // from the header's count; dividing keeps a corrupt count from overflowing
+    const uint64_t sampleBytes = (parameterCount + outputCount) * sizeof(double);
+    if (header.sampleCount > 0 && (sampleBytes == 0 || header.sampleCount > (fileSize - sizeof(header)) / sampleBytes))
+        return false;
+
+    std::vector<double> loadedParameters(header.sampleCount * parameterCount);
+    std::vector<double> loadedOutputs(header.sampleCount * outputCount);
+    if (!file.read(reinterpret_cast<char *>(loadedParameters.data()), loadedParameters.size() * sizeof(double)) ||
+        !file.read(reinterpret_cast<char *>(loadedOutputs.data()), loadedOutputs.size() * sizeof(double)) ||
+        !AllFinite(loadedParameters.data(), loadedParameters.size()))
+        return false;
+
+    // Rebuild the grid; the cell sizes may differ from the ones saved with
+    parameters.clear();
+    outputs.clear();
+    cells.clear();
+    sampleCount = 0;
+    for (size_t i = 0; i < header.sampleCount; ++i)
+        Insert(std::vector<double>(&loadedParameters[i * parameterCount], &loadedParameters[(i + 1) * parameterCount]),
+               std::vector<double>(&loadedOutputs[i * outputCount], &loadedOutputs[(i + 1) * outputCount]));
+    return true;
+}
+
+// ==============================
+// Reentry screening
+// ==============================
+std::vector<double> ReentrySurrogateParameters(const ReentryScenario &scenario)
+{
+    return {scenario.velocity, scenario.shieldMassKg, scenario.dryMassKg, scenario.chuteArea};
+}
+
+std::vector<double> ReentrySurrogateOutputs(const ScenarioResult &result)
+{
+    return {result.outcome == ScenarioOutcome::LandedSafely ? 1.0 : 0.0,
+            result.outcome == ScenarioOutcome::BurnedUp ? 1.0 : 0.0,
+            result.impactSpeed,
+            result.peakHeatRate,
+            result.shieldRemainingKg};
+}
+
+ReentryScenario ReentryScenarioFromParameters(const std::vector<double> &parameters)
+{
+    ReentryScenario scenario;
+    scenario.velocity = parameters[0];
+    scenario.shieldMassKg = parameters[1];
+    scenario.dryMassKg = parameters[2];
+    scenario.chuteArea = parameters[3];
+    return scenario;
+}
+
+SurrogateSettings ReentrySurrogateSettings()
+{
+    SurrogateSettings settings;
+    settings.cellSizes = {500.0, 50.0, 1000.0, 50.0};      // m/s, kg, kg, m²
+    settings.outputTolerances = {0.1, 0.1, 3.0, 0.0, 5.0}; // -, -, m/s, W/m², kg
+    settings.relativeTolerances = {0.0, 0.0, 0.0, 0.05, 0.0};
+    return settings;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ReentryScenario;
+struct ScenarioResult;
+
+struct SurrogateSettings
+{
+    std::vector<double> cellSizes;         // per parameter: quantization and distance unit
+    std::vector<double> outputTolerances;  // per output: acceptable uncertainty, absolute part
+    std::vector<double> relativeTolerances; // per output: plus this fraction of the prediction
+    int neighbourRadius = 1;  // cells searched around the query's cell in every dimension
+    int minNeighbours = 0;    // fewer samples nearby means unknown territory; 0 = 2 (parameters + 1), never below parameters + 2
+    double ridge = 1e-6;      // regularizes slopes along dimensions the samples do not span
+};
+
+enum class SurrogateSource
+{
+    Exact,     // a stored sample with the same parameters
+    Predicted, // interpolated within tolerance
+    Simulated  // uncertainty too high; fell back to the simulator
+};
+
+const char *ToString(SurrogateSource source);
+
+struct SurrogateAnswer
+{
+    std::vector<double> outputs;
+    std::vector<double> uncertainty; // per output, same units; infinite when unknown
+    SurrogateSource source = SurrogateSource::Predicted;
+    int neighbours = 0;
+};
+
+// Outcome cache over a continuous parameter space. Samples are bucketed by
+// quantized parameters in a hash grid; a query fits a distance-weighted
+// linear model to the samples in the surrounding cells and reports its
+// leave-one-out residual as the uncertainty, so it is confident where outputs
+// are locally smooth and well sampled and defers near outcome cliffs and at
+// the edge of the samples. Answers that exceed a tolerance are simulated and
+// folded back in.
+class SurrogateCache
+{
+public:
+    SurrogateCache(size_t parameterCount, size_t outputCount, const SurrogateSettings &settings);
+
+    // Interpolated answer only; never simulates. Non-finite parameters get
+    // no answer (infinite uncertainty), and Insert and Load refuse them.
+    SurrogateAnswer Predict(const std::vector<double> &parameters) const;
+
+    // Predict, or run simulate() and insert its outputs when any output's
+    // uncertainty exceeds its tolerance
+    SurrogateAnswer Query(const std::vector<double> &parameters,
+                          const std::function<std::vector<double>(const std::vector<double> &)> &simulate);
+
+    void Insert(const std::vector<double> &parameters, const std::vector<double> &outputs);
+
+    bool Save(const std::string &path) const;
+    bool Load(const std::string &path); // must match this cache's dimensions
+
+    size_t GetSampleCount() const { return sampleCount; }
+    size_t GetCellCount() const { return cells.size(); }
+
+private:
+    void CellOf(const double *parameters, int64_t *cell) const;
+    static uint64_t HashCell(const int64_t *cell, size_t dimensions);
+
+    size_t parameterCount;
+    size_t outputCount;
+    SurrogateSettings settings;
+
+    std::vector<double> parameters; // [sample][parameter]
+    std::vector<double> outputs;    // [sample][output]
+    size_t sampleCount;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells; // cell hash -> samples
+};
+
+// === Reentry screening ===
+// Parameters: entry velocity, shield mass, dry mass, parachute area.
+// Outputs: landed safely (0/1), burned up (0/1), impact speed, peak heat
+// rate, shield remaining.
+std::vector<double> ReentrySurrogateParameters(const ReentryScenario &scenario);
+std::vector<double> ReentrySurrogateOutputs(const ScenarioResult &result);
+ReentryScenario ReentryScenarioFromParameters(const std::vector<double> &parameters);
+SurrogateSettings ReentrySurrogateSettings();
+constexpr size_t reentrySurrogateParameterCount = 4;
+constexpr size_t reentrySurrogateOutputCount = 5;
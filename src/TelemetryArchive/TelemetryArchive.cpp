@@ -0,0 +1,355 @@
+#include "TelemetryArchive.h"
+#include <Scenario.h>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    constexpr char fileMagic[8] = {'P', 'S', 'I', 'M', 'T', 'L', 'A', '1'};
+    constexpr uint32_t recordMagic = 0x314e5552; // "RUN1"
+
+    // Largest |value / quantum| a quantized channel accepts: 2^53, past
+    // which a double no longer holds every integer and q * quantum drifts
+    constexpr double maxQuantizedMagnitude = 0x1p53;
+    // Encoder-side bound on a second difference of such values (|q - 2p + o|
+    // <= 4 * 2^53); larger ones are corrupt and would overflow the decode
+    constexpr int64_t maxQuantizedDelta = int64_t(1) << 55;
+
+    // ==============================
+    // Byte-level helpers
+    // ==============================
+    template <typename T>
+    void Put(std::vector<uint8_t> &out, T value)
+    {
+        uint8_t bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    bool Read(std::ifstream &in, T &value)
+    {
+        return bool(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+    }
+
+    void PutVarint(std::vector<uint8_t> &out, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(uint8_t(value) | 0x80);
+            value >>= 7;
+        }
+        out.push_back(uint8_t(value));
+    }
+
+    uint64_t ZigZag(int64_t value) { return (uint64_t(value) << 1) ^ uint64_t(value >> 63); }
+    int64_t UnZigZag(uint64_t value) { return int64_t(value >> 1) ^ -int64_t(value & 1); }
+
+    // Linear extrapolation of the previous two values
+    double Predict(const double *values, size_t i)
+    {
+        if (i == 0)
+            return 0.0;
+        if (i == 1)
+            return values[0];
+        return 2.0 * values[i - 1] - values[i - 2];
+    }
+
+    // ==============================
+    // Lossless: XOR against the prediction
+    // ==============================
+    void EncodeXor(const double *values, size_t count, std::vector<uint8_t> &out)
+    {
+        size_t controlStart = out.size();
+        out.resize(controlStart + count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint64_t residual = std::bit_cast<uint64_t>(values[i]) ^ std::bit_cast<uint64_t>(Predict(values, i));
+            if (residual == 0)
+            {
+                out[controlStart + i] = 0;
+                continue;
+            }
+            int trailing = std::countr_zero(residual) / 8;
+            int length = 8 - trailing - std::countl_zero(residual) / 8;
+            out[controlStart + i] = uint8_t(trailing << 4 | length);
+            residual >>= 8 * trailing;
+            for (int b = 0; b < length; ++b, residual >>= 8)
+                out.push_back(uint8_t(residual));
+        }
+    }
+
+    bool DecodeXor(const uint8_t *data, size_t size, double *values, size_t count)
+    {
+        if (size < count)
+            return false;
+        const uint8_t *control = data;
+        const uint8_t *payload = data + count;
+        const uint8_t *end = data + size;
+        for (size_t i = 0; i < count; ++i)
+        {
+            int trailing = control[i] >> 4;
+            int length = control[i] & 0x0f;
+            if (payload + length > end || trailing + length > 8)
+                return false;
+
+            uint64_t residual = 0;
+            for (int b = length - 1; b >= 0; --b)
+                residual = residual << 8 | payload[b];
+            payload += length;
+            residual <<= 8 * trailing;
+            values[i] = std::bit_cast<double>(std::bit_cast<uint64_t>(Predict(values, i)) ^ residual);
+        }
+        return payload == end;
+    }
+
+    // ==============================
+    // Quantized: second differences of integer multiples, as varints
+    // ==============================
+    bool EncodeQuantized(const double *values, size_t count, double quantum, std::vector<uint8_t> &out)
+    {
+        int64_t previous = 0, older = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            double scaled = values[i] / quantum;
+            if (!(std::abs(scaled) < maxQuantizedMagnitude))
+                return false;
+            int64_t q = std::llround(scaled);
+            PutVarint(out, ZigZag(q - 2 * previous + older));
+            older = previous;
+            previous = q;
+        }
+        return true;
+    }
+
+    bool DecodeQuantized(const uint8_t *data, size_t size, double quantum, double *values, size_t count)
+    {
+        const uint8_t *end = data + size;
+        int64_t previous = 0, older = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint64_t encoded = 0;
+            for (int shift = 0;; shift += 7)
+            {
+                if (data == end || shift > 63)
+                    return false;
+                uint8_t byte = *data++;
+                encoded |= uint64_t(byte & 0x7f) << shift;
+                if (!(byte & 0x80))
+                    break;
+            }
+            // previous and older stay within 2^53, so nothing below overflows
+            int64_t delta = UnZigZag(encoded);
+            if (delta > maxQuantizedDelta || delta < -maxQuantizedDelta)
+                return false;
+            int64_t q = delta + 2 * previous - older;
+            if (!(std::abs(double(q)) <= maxQuantizedMagnitude))
+                return false;
+            values[i] = double(q) * quantum;
+            older = previous;
+            previous = q;
+        }
+        return data == end;
+    }
+}
+
+std::vector<ArchiveChannel> TelemetryColumnsChannels()
+{
+    return {
+        {"time", 1e-6},                // s
+        {"altitude", 1e-3},            // m
+        {"velocity", 1e-4},            // m/s
+        {"air density", 0.0},          // kg/m³
+        {"heat rate", 1e-2},           // W/m²
+        {"surface temperature", 1e-3}, // K
+        {"shield mass", 1e-6}};        // kg
+}
+
+// ==============================
+// Writer
+// ==============================
+TelemetryArchiveWriter::TelemetryArchiveWriter()
+    : rawBytes(0),
+      encodedBytes(0)
+{
+}
+
+bool TelemetryArchiveWriter::Open(const std::string &path, const std::vector<ArchiveChannel> &archiveChannels)
+{
+    file.close();
+    file.clear();
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+    channels = archiveChannels;
+
+    buffer.assign(fileMagic, fileMagic + sizeof(fileMagic));
+    Put(buffer, uint32_t(channels.size()));
+    for (const ArchiveChannel &channel : channels)
+    {
+        Put(buffer, uint16_t(channel.name.size()));
+        buffer.insert(buffer.end(), channel.name.begin(), channel.name.end());
+        Put(buffer, channel.quantum);
+    }
+    file.write(reinterpret_cast<const char *>(buffer.data()), buffer.size());
+    rawBytes = 0;
+    encodedBytes = buffer.size();
+    return bool(file);
+}
+
+bool TelemetryArchiveWriter::Append(uint64_t runId, const std::vector<const double *> &columns, size_t rowCount)
+{
+    if (!file.is_open() || columns.size() != channels.size())
+        return false;
+
+    // Record header with a directory of block sizes, patched once encoded
+    buffer.clear();
+    Put(buffer, recordMagic);
+    Put(buffer, uint32_t(channels.size()));
+    Put(buffer, runId);
+    Put(buffer, uint64_t(rowCount));
+    size_t directory = buffer.size();
+    buffer.resize(directory + channels.size() * sizeof(uint64_t));
+
+    for (size_t c = 0; c < channels.size(); ++c)
+    {
+        size_t blockStart = buffer.size();
+        if (channels[c].quantum > 0.0)
+        {
+            if (!EncodeQuantized(columns[c], rowCount, channels[c].quantum, buffer))
+                return false;
+        }
+        else
+            EncodeXor(columns[c], rowCount, buffer);
+
+        uint64_t blockSize = buffer.size() - blockStart;
+        std::memcpy(&buffer[directory + c * sizeof(uint64_t)], &blockSize, sizeof(blockSize));
+    }
+
+    file.write(reinterpret_cast<const char *>(buffer.data()), buffer.size());
+    rawBytes += uint64_t(rowCount) * channels.size() * sizeof(double);
+    encodedBytes += buffer.size();
+    return bool(file);
+}
+
+bool TelemetryArchiveWriter::Append(uint64_t runId, const TelemetryColumns &telemetry)
+{
+    return Append(runId,
+                  {telemetry.time, telemetry.altitude, telemetry.velocity, telemetry.airDensity,
+                   telemetry.heatRate, telemetry.surfaceTemperature, telemetry.shieldMass},
+                  telemetry.count);
+}
+
+bool TelemetryArchiveWriter::Close()
+{
+    if (!file.is_open())
+        return false;
+    file.close();
+    return !file.fail();
+}
+
+// ==============================
+// Reader
+// ==============================
+TelemetryArchiveReader::TelemetryArchiveReader()
+    : fileSize(0),
+      nextRecord(0),
+      runId(0),
+      rowCount(0)
+{
+}
+
+bool TelemetryArchiveReader::Open(const std::string &path)
+{
+    file.close();
+    file.clear();
+    file.open(path, std::ios::binary | std::ios::ate);
+    fileSize = file ? uint64_t(file.tellg()) : 0;
+    file.seekg(0);
+    char magic[sizeof(fileMagic)];
+    uint32_t channelCount = 0;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, fileMagic, sizeof(magic)) != 0 ||
+        !Read(file, channelCount))
+        return false;
+
+    channels.clear();
+    for (uint32_t c = 0; c < channelCount; ++c)
+    {
+        uint16_t nameLength = 0;
+        ArchiveChannel channel;
+        if (!Read(file, nameLength))
+            return false;
+        channel.name.resize(nameLength);
+        if (!file.read(channel.name.data(), nameLength) || !Read(file, channel.quantum))
+            return false;
+        channels.push_back(channel);
+    }
+
+    nextRecord = uint64_t(file.tellg());
+    blockOffsets.clear();
+    blockSizes.clear();
+    rowCount = 0;
+    return true;
+}
+
+int TelemetryArchiveReader::FindChannel(const std::string &name) const
+{
+    for (size_t c = 0; c < channels.size(); ++c)
+        if (channels[c].name == name)
+            return int(c);
+    return -1;
+}
+
+bool TelemetryArchiveReader::NextRun()
+{
+    file.clear();
+    file.seekg(std::streamoff(nextRecord));
+    blockOffsets.clear(); // no current run until this one checks out
+    rowCount = 0;
+
+    uint32_t magic = 0, channelCount = 0;
+    uint64_t rows = 0;
+    if (!Read(file, magic) || magic != recordMagic || !Read(file, channelCount) ||
+        channelCount != channels.size() || !Read(file, runId) || !Read(file, rows))
+        return false;
+
+    blockSizes.resize(channelCount);
+    if (!file.read(reinterpret_cast<char *>(blockSizes.data()), channelCount * sizeof(uint64_t)))
+        return false;
+
+    // Both encodings spend at least a byte per value, and every block must
+    // lie inside the file, which also bounds the buffers sized from it
+    uint64_t offset = uint64_t(file.tellg());
+    blockOffsets.resize(channelCount);
+    for (uint32_t c = 0; c < channelCount; ++c)
+    {
+        if (blockSizes[c] < rows || blockSizes[c] > fileSize - offset)
+        {
+            blockOffsets.clear();
+            return false;
+        }
+        blockOffsets[c] = offset;
+        offset += blockSizes[c];
+    }
+    nextRecord = offset;
+    rowCount = size_t(rows);
+    return true;
+}
+
+bool TelemetryArchiveReader::ReadChannel(int channel, std::vector<double> &values)
+{
+    if (channel < 0 || size_t(channel) >= blockOffsets.size())
+        return false;
+
+    buffer.resize(blockSizes[channel]);
+    file.clear();
+    file.seekg(std::streamoff(blockOffsets[channel]));
+    if (!file.read(reinterpret_cast<char *>(buffer.data()), buffer.size()))
+        return false;
+
+    values.resize(rowCount);
+    double quantum = channels[channel].quantum;
+    return quantum > 0.0 ? DecodeQuantized(buffer.data(), buffer.size(), quantum, values.data(), rowCount)
+                         : DecodeXor(buffer.data(), buffer.size(), values.data(), rowCount);
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+struct TelemetryColumns;
+
+struct ArchiveChannel
+{
+    std::string name;
+    // 0 = lossless (XOR against a linear prediction); otherwise values are
+    // rounded to multiples of quantum, so the error is at most quantum / 2
+    double quantum = 0.0;
+};
+
+// Channels of a Scenario TelemetryColumns buffer, in column order. Quanta
+// are far below the CSV's 2 decimals; density is kept lossless because it
+// spans seven decades.
+std::vector<ArchiveChannel> TelemetryColumnsChannels();
+
+// Append-only archive of per-step telemetry, one record per run. Every
+// channel of a run is its own independently decodable block, listed in the
+// record's directory, so readers seek straight to the channels they want.
+//
+// Lossless channels: each double is XORed with a linear extrapolation of the
+// previous two, and only the nonzero middle bytes of the XOR are stored, one
+// control byte per value saying how many and where.
+// Quantized channels: integer multiples of the quantum, second differences,
+// zigzag and LEB128 varints, so a smooth channel costs about a byte a sample.
+class TelemetryArchiveWriter
+{
+public:
+    TelemetryArchiveWriter();
+
+    bool Open(const std::string &path, const std::vector<ArchiveChannel> &channels);
+    // columns[c] holds rowCount values of channel c
+    bool Append(uint64_t runId, const std::vector<const double *> &columns, size_t rowCount);
+    // Writer must have been opened with TelemetryColumnsChannels()
+    bool Append(uint64_t runId, const TelemetryColumns &telemetry);
+    bool Close();
+
+    uint64_t GetRawBytes() const { return rawBytes; }         // 8 bytes per value appended
+    uint64_t GetEncodedBytes() const { return encodedBytes; } // file size so far
+
+private:
+    std::ofstream file;
+    std::vector<ArchiveChannel> channels;
+    std::vector<uint8_t> buffer;
+    uint64_t rawBytes;
+    uint64_t encodedBytes;
+};
+
+// Streaming reader: NextRun() reads only a record's directory, and
+// ReadChannel() decodes one block, seeking past the others.
+class TelemetryArchiveReader
+{
+public:
+    TelemetryArchiveReader();
+
+    bool Open(const std::string &path);
+
+    const std::vector<ArchiveChannel> &GetChannels() const { return channels; }
+    int FindChannel(const std::string &name) const; // -1 if absent
+
+    // Advances to the next run; false at the end of the archive
+    bool NextRun();
+    uint64_t GetRunId() const { return runId; }
+    size_t GetRowCount() const { return rowCount; }
+
+    // Decodes one channel of the current run into values (resized)
+    bool ReadChannel(int channel, std::vector<double> &values);
+
+private:
+    std::ifstream file;
+    std::vector<ArchiveChannel> channels;
+    std::vector<uint64_t> blockOffsets; // file offsets of the current run's blocks
+    std::vector<uint64_t> blockSizes;
+    std::vector<uint8_t> buffer;
+    uint64_t fileSize;
+    uint64_t nextRecord; // file offset of the record after the current one
+    uint64_t runId;
+    size_t rowCount;
+};
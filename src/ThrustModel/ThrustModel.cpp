@@ -19,6 +19,21 @@ double ThrustModel::GetThrottle() const
     return currentThrottle;
 }
 
+double ThrustModel::GetMaxThrust() const
+{
+    return maxThrustNewton;
+}
+
+double ThrustModel::GetVacuumISP() const
+{
+    return specificImpulseVacuum;
+}
+
+double ThrustModel::GetSeaLevelISP() const
+{
+    return specificImpulseSeaLevel;
+}
+
 double ThrustModel::ComputeCurrentISP(double ambientPressurePascal) const
 {
     // Define sea-level pressure for scaling
@@ -14,6 +14,11 @@ public:
     // Get current throttle
     double GetThrottle() const;
 
+    // Engine ratings
+    double GetMaxThrust() const;
+    double GetVacuumISP() const;
+    double GetSeaLevelISP() const;
+
     // Returns the current thrust in Newtons based on ambient pressure
     double ComputeThrust(double ambientPressurePascal) const;
 
@@ -1,61 +1,73 @@
 #pragma once
 #include <cmath>
 #include <algorithm>
+#include <FastMath.h>
 
-struct Vector3
+// Real is double for the reference physics; float for reduced-precision ensembles
+template <typename Real>
+struct Vector3T
 {
-    double x, y, z;
+    Real x, y, z;
 
-    Vector3() : x(0), y(0), z(0) {}
-    Vector3(double x, double y, double z) : x(x), y(y), z(z) {}
+    Vector3T() : x(0), y(0), z(0) {}
+    Vector3T(Real x, Real y, Real z) : x(x), y(y), z(z) {}
 
-    double Length() const
+    Real Length() const
     {
         return std::sqrt(x * x + y * y + z * z);
     }
 
-    Vector3 Normalized() const
+    Vector3T Normalized() const
     {
-        double len = Length();
-        return (len > 0.0) ? Vector3(x / len, y / len, z / len) : Vector3(0, 0, 0);
+        Real len = Length();
+        return (len > Real(0)) ? Vector3T(x / len, y / len, z / len) : Vector3T(0, 0, 0);
     }
 
-    double Dot(const Vector3 &other) const
+    Real Dot(const Vector3T &other) const
     {
         return x * other.x + y * other.y + z * other.z;
     }
 
-    Vector3 Cross(const Vector3 &other) const
+    Vector3T Cross(const Vector3T &other) const
     {
-        return Vector3(
+        return Vector3T(
             y * other.z - z * other.y,
             z * other.x - x * other.z,
             x * other.y - y * other.x);
     }
 
-    Vector3 operator*(double scalar) const
+    Vector3T operator*(Real scalar) const
     {
-        return Vector3(x * scalar, y * scalar, z * scalar);
+        return Vector3T(x * scalar, y * scalar, z * scalar);
     }
 
-    Vector3 operator+(const Vector3 &other) const
+    Vector3T operator+(const Vector3T &other) const
     {
-        return Vector3(x + other.x, y + other.y, z + other.z);
+        return Vector3T(x + other.x, y + other.y, z + other.z);
     }
 
-    Vector3 operator-(const Vector3 &other) const
+    Vector3T operator-(const Vector3T &other) const
     {
-        return Vector3(x - other.x, y - other.y, z - other.z);
+        return Vector3T(x - other.x, y - other.y, z - other.z);
     }
 
-    double AngleBetween(const Vector3 &other) const
+    Real AngleBetween(const Vector3T &other) const
     {
-        double dot = Dot(other);
-        double lenProduct = Length() * other.Length();
-        if (lenProduct == 0.0)
-            return 0.0;
+        Real dot = Dot(other);
+        Real lenProduct = Length() * other.Length();
+        if (lenProduct == Real(0))
+            return Real(0);
 
-        double clamped = std::clamp(dot / lenProduct, -1.0, 1.0);
-        return std::acos(clamped);
+        Real clamped = std::clamp(dot / lenProduct, Real(-1), Real(1));
+        return FastMath::Acos(clamped);
+    }
+
+    template <typename Other>
+    Vector3T<Other> As() const
+    {
+        return Vector3T<Other>(Other(x), Other(y), Other(z));
     }
 };
+
+using Vector3 = Vector3T<double>;
+using Vector3f = Vector3T<float>;
@@ -1,5 +1,22 @@
 #include "Vessel.h"
+#include <AtmospherePerturbation.h>
+#include <EventBus.h>
+#include <FastMath.h>
 #include <OrbitalBody.h>
+#include <atomic>
+
+namespace
+{
+    std::atomic<uint64_t> nextVesselId(1);
+
+    constexpr double heatCapacityPerArea = 2000.0; // J/(m²·K), heat load to surface temperature
+
+    // Steps of at most `step` covering `span`; 0 = one step
+    int SubstepCount(double span, double step)
+    {
+        return (step > 0.0 && step < span) ? int(std::ceil(span / step - 1e-9)) : 1;
+    }
+}
 
 Vessel::Vessel(double startingAltitude,
                double startingVelocity,
@@ -11,6 +28,7 @@ Vessel::Vessel(double startingAltitude,
                const ThrustModel &engineModel)
     : altitudeMeters(startingAltitude),
       angleOfAttackRadians(0.0),
+      components(nullptr),
       crossSectionArea(crossSectionArea),
       currentHeatRate(0.0),
       dragCoefficient(dragCoefficient),
@@ -22,15 +40,23 @@ Vessel::Vessel(double startingAltitude,
       hasCrashed(false),
       hasDirectionalAerodynamics(true),
       hasLandedSafely(false),
-      heatShield(nullptr),
+      heatShield(),
+      id(nextVesselId++),
       initialFuelMassKg(fuelMassKg),
       lastAirDensity(0.0),
       lastDragAcceleration(0.0),
       lastDragForce(0.0),
       lastLiftForce(0.0),
       lastLiftVector(0.0, 0.0, 0.0),
+      latitudeDegrees(0.0),
+      longitudeDegrees(0.0),
+      missionTimeSeconds(0.0),
       orientationVector(0.0, 1.0, 0.0),
+      parachute(),
+      parachuteDeployed(false),
       parentBody(parentBody),
+      perturbation(nullptr),
+      perturbationProfile(0),
       positionVector(0.0, 0.0, 0.0),
       surfaceTemperature(0.0),
       totalHeatLoad(0.0),
@@ -42,32 +68,423 @@ Vessel::Vessel(double startingAltitude,
 // ==============================
 // Update per time step
 // ==============================
+const char *ToString(IntegrationMethod method)
+{
+    switch (method)
+    {
+    case IntegrationMethod::SemiImplicitEuler:
+        return "semi-implicit Euler";
+    case IntegrationMethod::ExplicitEuler:
+        return "explicit Euler";
+    case IntegrationMethod::Heun:
+        return "Heun";
+    case IntegrationMethod::RungeKutta4:
+        return "RK4";
+    case IntegrationMethod::MultiRate:
+        return "multi-rate";
+    }
+    return "unknown";
+}
+
 void Vessel::Update(double deltaTime)
+{
+    double startFuel = fuelMassKg;
+    double startVelocity = velocityMetersPerSecond;
+    bool shieldIntact = HasHeatShield() && !IsHeatShieldDepleted();
+
+    if (integrationMethod == IntegrationMethod::SemiImplicitEuler)
+        StepSequential(deltaTime);
+    else if (integrationMethod == IntegrationMethod::MultiRate)
+        StepMultiRate(deltaTime);
+    else
+        StepRates(deltaTime);
+
+    positionVector = Vector3(0.0, parentBody->GetRadius() + altitudeMeters, 0.0);
+    missionTimeSeconds += deltaTime;
+
+    // === Events, stamped with the end of the step that crossed them ===
+    if (startFuel > 0.0 && fuelMassKg <= 0.0)
+        PublishEvent(SimEventType::Burnout);
+    // Only for powered flights: drag overshoot can flip an unpowered
+    // capsule's velocity without it having climbed
+    if (initialFuelMassKg > 0.0 && startVelocity > 0.0 && velocityMetersPerSecond <= 0.0 && altitudeMeters > 0.0)
+        PublishEvent(SimEventType::Apex);
+    if (shieldIntact && IsHeatShieldDepleted())
+        PublishEvent(SimEventType::ShieldDepleted);
+
+    ComputeFlightPathAngle();
+    EvaluateReentryOutcome();
+}
+
+void Vessel::PublishEvent(SimEventType type) const
+{
+    EventBus &bus = EventBus::Global();
+    if (!bus.IsActive())
+        return;
+
+    SimEvent event;
+    event.type = type;
+    event.vesselId = id;
+    event.missionTime = missionTimeSeconds;
+    event.altitude = altitudeMeters;
+    event.velocity = velocityMetersPerSecond;
+    bus.Publish(event);
+}
+
+// Forces applied one after another, each seeing the velocity left by the
+// previous one; altitude advances with the updated velocity
+void Vessel::StepSequential(double deltaTime)
 {
     double altitude = altitudeMeters;
-    double gravity = parentBody->ComputeGravitationalAcceleration(altitude);
+    double gravity = ComputeGravity();
     double pressure = parentBody->ComputeAtmosphericPressure(altitude);
 
     ApplyThrust(deltaTime, pressure);
     ComputeVelocityVector();
     ComputeAngleOfAttack();
-    ApplyDrag(deltaTime);
+
+    // Lift has no vertical component on a vertical trajectory; explicit
+    ComputeDragAcceleration(); // density and drag diagnostics for the step
     ApplyLift(deltaTime);
-    ApplyParachuteDrag(deltaTime);
+
+    // === Drag, parachute and gravity, in closed form ===
+    UpdateParachuteDeployment();
+    velocityMetersPerSecond = QuadraticDragStep(velocityMetersPerSecond, gravity, ComputeQuadraticDragFactor(), deltaTime);
+
     ApplyReentryHeating(deltaTime);
     ApplyHeatShield(deltaTime);
     ApplyRadiativeCooling(deltaTime);
 
-    // === Gravity ===
-    velocityMetersPerSecond -= gravity * deltaTime;
-
     // === Update Altitude ===
     altitudeMeters += velocityMetersPerSecond * deltaTime;
+}
+
+// k in |drag + chute deceleration| = k v², from the current diagnostics
+double Vessel::ComputeQuadraticDragFactor() const
+{
+    double speed = std::abs(velocityMetersPerSecond);
+    if (speed <= 0.0)
+        return 0.0;
+    return (lastDragAcceleration + std::abs(ComputeParachuteAcceleration())) / (speed * speed);
+}
+
+// The sequential update split by subsystem, each on its own clock:
+// translation sub-steps the update and records where it went, then thermal
+// replays that trajectory on its own steps. Diagnostics describe the last
+// sub-step of each. Thermal does not feed back into
+// the flight (the shield is not part of the vessel's mass), so one pass in
+// this order meets both at the end of the step.
+void Vessel::StepMultiRate(double deltaTime)
+{
+    double startTime = missionTimeSeconds;
+
+    trajectorySamples.clear();
+    trajectorySamples.push_back({startTime, altitudeMeters, std::abs(velocityMetersPerSecond)});
+
+    double fixedStep = deltaTime / SubstepCount(deltaTime, multiRate.translationStep);
+    double elapsed = 0.0;
+    while (deltaTime - elapsed > 1e-12 * deltaTime)
+    {
+        double step = std::min(fixedStep, deltaTime - elapsed);
+
+        // Shrink so the velocity moves less than the tolerance at the
+        // start-of-step acceleration: fine through peak deceleration and
+        // powered flight, coarse at terminal velocity
+        if (multiRate.translationTolerance > 0.0)
+        {
+            double acceleration = std::abs(ComputeRates().velocity);
+            double limit = multiRate.translationTolerance / std::max(acceleration, 1e-300);
+            if (limit < step)
+                step = std::max(limit, std::min(multiRate.minStep, deltaTime - elapsed));
+        }
+
+        StepTranslation(step);
+        elapsed += step;
+        missionTimeSeconds = startTime + elapsed;
+        trajectorySamples.push_back({missionTimeSeconds, altitudeMeters, std::abs(velocityMetersPerSecond)});
+    }
+
+    missionTimeSeconds = startTime;
+    StepThermal(deltaTime);
+    missionTimeSeconds = startTime; // advanced by Update
+}
+
+// One translation step, with engine and chute sub-stepped inside it along
+// the altitude extrapolated from the start of the step
+void Vessel::StepTranslation(double deltaTime)
+{
+    double gravity = ComputeGravity();
+    double startAltitude = altitudeMeters;
+    double startVelocity = velocityMetersPerSecond;
+
+    // === Engine: mass and pressure follow the burn within the step ===
+    int engineSteps = SubstepCount(deltaTime, multiRate.engineStep);
+    double engineStep = deltaTime / engineSteps;
+    for (int i = 0; i < engineSteps && fuelMassKg > 0.0; ++i)
+    {
+        double altitude = startAltitude + startVelocity * (i + 0.5) * engineStep;
+        ApplyThrust(engineStep, parentBody->ComputeAtmosphericPressure(altitude));
+    }
+
+    ComputeVelocityVector();
+    ComputeAngleOfAttack();
+    ComputeDragAcceleration(); // density and drag diagnostics for the step
+    ApplyLift(deltaTime);
+
+    // === Chute: deploy trigger checked at its own resolution ===
+    double deployOffset = 0.0; // s into the step
+    const Parachute *chute = Chute();
+    if (chute && !parachuteDeployed)
+    {
+        int chuteSteps = SubstepCount(deltaTime, multiRate.chuteStep);
+        double chuteStep = deltaTime / chuteSteps;
+        deployOffset = deltaTime;
+        for (int i = 0; i < chuteSteps; ++i)
+        {
+            double offset = i * chuteStep;
+            if (chute->ShouldDeploy(startAltitude + velocityMetersPerSecond * offset, GetMass()))
+            {
+                deployOffset = offset;
+                break;
+            }
+        }
+        // Open from here on; the part of the step before the trigger flies without it
+        if (deployOffset < deltaTime)
+        {
+            parachuteDeployed = true;
+            PublishEvent(SimEventType::ParachuteDeployed);
+        }
+    }
+
+    // === Drag, parachute and gravity, in closed form either side of deploy ===
+    double speed = std::abs(velocityMetersPerSecond);
+    double bodyFactor = speed > 0.0 ? lastDragAcceleration / (speed * speed) : 0.0;
+    double fullFactor = ComputeQuadraticDragFactor();
+    double beforeDeploy = QuadraticDragStep(velocityMetersPerSecond, gravity, bodyFactor, deployOffset);
+    velocityMetersPerSecond = QuadraticDragStep(beforeDeploy, gravity, fullFactor, deltaTime - deployOffset);
+
+    altitudeMeters += beforeDeploy * deployOffset + velocityMetersPerSecond * (deltaTime - deployOffset);
+}
+
+// Heating, ablation and cooling across the whole update, on steps of their
+// own, reading altitude and speed interpolated from the translation samples
+void Vessel::StepThermal(double deltaTime)
+{
+    double startTime = missionTimeSeconds;
+    double fixedStep = deltaTime / SubstepCount(deltaTime, multiRate.thermalStep);
+
+    size_t segment = 0; // times only move forward
+    auto heatRateAt = [&](double time)
+    {
+        while (segment + 2 < trajectorySamples.size() && trajectorySamples[segment + 1].time < time)
+            ++segment;
+        const TrajectorySample &a = trajectorySamples[segment];
+        const TrajectorySample &b = trajectorySamples[segment + 1];
+        double fraction = std::clamp((time - a.time) / (b.time - a.time), 0.0, 1.0);
+        double altitude = a.altitude + (b.altitude - a.altitude) * fraction;
+        double speed = a.speed + (b.speed - a.speed) * fraction;
+        return ComputeHeatRate(ComputeAirDensity(altitude, time), speed);
+    };
+
+    double elapsed = 0.0;
+    while (deltaTime - elapsed > 1e-12 * deltaTime)
+    {
+        double step = std::min(fixedStep, deltaTime - elapsed);
+
+        // Shrink so the temperature moves less than the tolerance at the
+        // start-of-step rate; the radiative term is the stiff one (∝ T⁴)
+        if (multiRate.thermalTolerance > 0.0)
+        {
+            double loadRate = std::abs(heatRateAt(startTime + elapsed) - ComputeRadiatedPower());
+            double limit = multiRate.thermalTolerance * heatCapacityPerArea / std::max(loadRate, 1e-300);
+            if (limit < step)
+                step = std::max(limit, std::min(multiRate.minStep, deltaTime - elapsed));
+        }
+
+        currentHeatRate = heatRateAt(startTime + elapsed + 0.5 * step);
+        totalHeatLoad += currentHeatRate * step;
+        ApplyHeatShield(step);
+        ApplyRadiativeCooling(step);
+        elapsed += step;
+    }
+    ComputeRadiatedPower(); // surface temperature for the final heat load
+}
+
+// Explicit Runge-Kutta family on the integrated state. Parachute deployment
+// is decided once per step, on the start-of-step state.
+void Vessel::StepRates(double deltaTime)
+{
+    UpdateParachuteDeployment();
+
+    double startTime = missionTimeSeconds;
+    VesselRates k1 = ComputeRates();
+
+    // Diagnostics (density, drag, heat rate, lift) describe the start of the
+    // step, as in the sequential update
+    double startDensity = lastAirDensity;
+    double startDragForce = lastDragForce;
+    double startDragAcceleration = lastDragAcceleration;
+    double startHeatRate = currentHeatRate;
+    double startLiftForce = lastLiftForce;
+    Vector3 startLiftVector = lastLiftVector;
+
+    // Burnout inside the step: integrate up to it and restart unpowered, so
+    // the thrust cut-off does not cost the method its order
+    double burnTime = (k1.fuelMass < 0.0) ? fuelMassKg / -k1.fuelMass : INFINITY;
+    if (burnTime < deltaTime)
+    {
+        IntegrateRates(k1, burnTime);
+        fuelMassKg = 0.0;
+        IntegrateRates(ComputeRates(), deltaTime - burnTime);
+    }
+    else
+        IntegrateRates(k1, deltaTime);
+    missionTimeSeconds = startTime; // advanced by Update
+
+    lastAirDensity = startDensity;
+    lastDragForce = startDragForce;
+    lastDragAcceleration = startDragAcceleration;
+    currentHeatRate = startHeatRate;
+    lastLiftForce = startLiftForce;
+    lastLiftVector = startLiftVector;
+    ComputeRadiatedPower();
+}
+
+// One explicit Runge-Kutta step from the current state, given its rates
+void Vessel::IntegrateRates(const VesselRates &k1, double deltaTime)
+{
+    VesselState start = GetState();
+
+    auto stage = [&](const VesselRates &rates, double fraction)
+    {
+        LoadIntegratedState(Advance(start, rates, fraction * deltaTime));
+        return ComputeRates();
+    };
+
+    VesselRates total = k1;
+    switch (integrationMethod)
+    {
+    case IntegrationMethod::Heun:
+    {
+        VesselRates k2 = stage(k1, 1.0);
+        total = Combine({{k1, 0.5}, {k2, 0.5}});
+        break;
+    }
+    case IntegrationMethod::RungeKutta4:
+    {
+        VesselRates k2 = stage(k1, 0.5);
+        VesselRates k3 = stage(k2, 0.5);
+        VesselRates k4 = stage(k3, 1.0);
+        total = Combine({{k1, 1.0 / 6.0}, {k2, 1.0 / 3.0}, {k3, 1.0 / 3.0}, {k4, 1.0 / 6.0}});
+        break;
+    }
+    default:
+        break;
+    }
+
+    LoadIntegratedState(Advance(start, total, deltaTime));
+}
+
+// Time derivatives at the current state. Updates the same diagnostics as
+// the sequential step (density, drag, lift, heat rate) but leaves the state.
+VesselRates Vessel::ComputeRates()
+{
+    double gravity = ComputeGravity();
+    double pressure = parentBody->ComputeAtmosphericPressure(altitudeMeters);
+
+    VesselRates rates;
+    rates.altitude = velocityMetersPerSecond;
+
+    double fuelFlowRate = 0.0;
+    double acceleration = ComputeThrustAcceleration(pressure, fuelFlowRate);
+    rates.fuelMass = -fuelFlowRate;
+
+    ComputeVelocityVector();
+    ComputeAngleOfAttack();
+    acceleration += ComputeDragAcceleration();
+    acceleration += ComputeLiftAcceleration();
+    acceleration += ComputeParachuteAcceleration();
+    rates.velocity = acceleration - gravity;
+
+    ComputeHeatRate();
+    rates.totalHeatLoad = currentHeatRate - ComputeRadiatedPower();
+
+    const HeatShield *shield = Shield();
+    double ablationRate = (shield && !shield->IsDepleted()) ? shield->GetAblationRate(currentHeatRate) : 0.0;
+    rates.heatShieldMass = -ablationRate;
+    rates.ablatedMass = ablationRate;
+    return rates;
+}
+
+VesselRates Vessel::Combine(std::initializer_list<std::pair<VesselRates, double>> terms)
+{
+    VesselRates sum{};
+    for (const auto &[rates, weight] : terms)
+    {
+        sum.altitude += weight * rates.altitude;
+        sum.velocity += weight * rates.velocity;
+        sum.fuelMass += weight * rates.fuelMass;
+        sum.totalHeatLoad += weight * rates.totalHeatLoad;
+        sum.heatShieldMass += weight * rates.heatShieldMass;
+        sum.ablatedMass += weight * rates.ablatedMass;
+    }
+    return sum;
+}
+
+VesselState Vessel::Advance(const VesselState &state, const VesselRates &rates, double deltaTime)
+{
+    VesselState next = state;
+    next.altitude += rates.altitude * deltaTime;
+    next.velocity += rates.velocity * deltaTime;
+    next.fuelMass = std::max(0.0, state.fuelMass + rates.fuelMass * deltaTime);
+    next.totalHeatLoad = std::max(0.0, state.totalHeatLoad + rates.totalHeatLoad * deltaTime);
+    next.heatShieldMass += rates.heatShieldMass * deltaTime;
+    next.ablatedMass += rates.ablatedMass * deltaTime;
+    next.missionTime += deltaTime;
+
+    // Ablation stops when the shield is gone
+    if (next.heatShieldMass < 0.0)
+    {
+        next.ablatedMass += next.heatShieldMass;
+        next.heatShieldMass = 0.0;
+    }
+    return next;
+}
+
+VesselState Vessel::GetState() const
+{
+    VesselState state;
+    state.altitude = altitudeMeters;
+    state.velocity = velocityMetersPerSecond;
+    state.fuelMass = fuelMassKg;
+    state.totalHeatLoad = totalHeatLoad;
+    state.heatShieldMass = GetHeatShieldMass();
+    state.ablatedMass = GetAblatedMass();
+    state.missionTime = missionTimeSeconds;
+    state.parachuteDeployed = parachuteDeployed;
+    return state;
+}
+
+void Vessel::SetState(const VesselState &state)
+{
+    LoadIntegratedState(state);
+    parachuteDeployed = Chute() && state.parachuteDeployed;
 
     positionVector = Vector3(0.0, parentBody->GetRadius() + altitudeMeters, 0.0);
+    hasBurnedUp = false;
+    hasCrashed = false;
+    hasLandedSafely = false;
+}
 
-    ComputeFlightPathAngle();
-    EvaluateReentryOutcome();
+void Vessel::LoadIntegratedState(const VesselState &state)
+{
+    altitudeMeters = state.altitude;
+    velocityMetersPerSecond = state.velocity;
+    fuelMassKg = std::max(0.0, state.fuelMass);
+    totalHeatLoad = std::max(0.0, state.totalHeatLoad);
+    missionTimeSeconds = state.missionTime;
+    if (HeatShield *shield = Shield())
+        shield->Restore(state.heatShieldMass, state.ablatedMass);
 }
 
 void Vessel::ApplyThrust(double deltaTime, double pressure)
@@ -75,15 +492,25 @@ void Vessel::ApplyThrust(double deltaTime, double pressure)
     if (fuelMassKg <= 0.0)
         return;
 
-    double thrust = engine.ComputeThrust(pressure);
-    double acceleration = thrust / GetMass();
+    double massFlowRate = 0.0;
+    double acceleration = ComputeThrustAcceleration(pressure, massFlowRate);
     velocityMetersPerSecond += acceleration * deltaTime;
 
-    double massFlowRate = engine.ComputeMassFlowRate(pressure);
     double fuelUsed = massFlowRate * deltaTime;
     fuelMassKg -= std::min(fuelUsed, fuelMassKg);
 }
 
+double Vessel::ComputeThrustAcceleration(double pressure, double &massFlowRate) const
+{
+    massFlowRate = 0.0;
+    if (fuelMassKg <= 0.0)
+        return 0.0;
+
+    double thrust = engine.ComputeThrust(pressure);
+    massFlowRate = engine.ComputeMassFlowRate(pressure);
+    return thrust / GetMass();
+}
+
 void Vessel::ComputeVelocityVector()
 {
     velocityVector = Vector3(0.0, velocityMetersPerSecond, 0.0); // Extend to full 3D later
@@ -97,21 +524,27 @@ void Vessel::ComputeAngleOfAttack()
         angleOfAttackRadians = 0.0;
 }
 
-void Vessel::ApplyParachuteDrag(double deltaTime)
+void Vessel::UpdateParachuteDeployment()
 {
-    if (parachute && !parachuteDeployed && parachute->ShouldDeploy(altitudeMeters, GetMass()))
+    const Parachute *chute = Chute();
+    if (chute && !parachuteDeployed && chute->ShouldDeploy(altitudeMeters, GetMass()))
     {
         parachuteDeployed = true;
-        std::cout << "🪂 Parachute deployed at " << altitudeMeters << " m\n";
+        PublishEvent(SimEventType::ParachuteDeployed);
     }
+}
 
-    if (parachuteDeployed && parentBody->GetAtmosphere())
-    {
-        double chuteDrag = parachute->ComputeDragForce(lastAirDensity, velocityMetersPerSecond, GetMass());
-        double chuteAccel = chuteDrag / GetMass();
-        double chuteDir = (velocityMetersPerSecond > 0.0) ? -1.0 : 1.0;
-        velocityMetersPerSecond += chuteDir * chuteAccel * deltaTime;
-    }
+// Signed, along the vertical; uses the density from the last drag evaluation
+double Vessel::ComputeParachuteAcceleration() const
+{
+    const Parachute *chute = Chute();
+    if (!chute || !parachuteDeployed || !parentBody->GetAtmosphere())
+        return 0.0;
+
+    double chuteDrag = chute->ComputeDragForce(lastAirDensity, velocityMetersPerSecond, GetMass());
+    double chuteAccel = chuteDrag / GetMass();
+    double chuteDir = (velocityMetersPerSecond > 0.0) ? -1.0 : 1.0;
+    return chuteDir * chuteAccel;
 }
 
 void Vessel::EvaluateReentryOutcome()
@@ -120,23 +553,25 @@ void Vessel::EvaluateReentryOutcome()
         return;
 
     double impactSpeed = std::abs(velocityMetersPerSecond);
+    bool decided = hasBurnedUp || hasCrashed || hasLandedSafely;
 
     // Burnup condition: no shield + high heat rate or temp
     if (IsHeatShieldDepleted() && (currentHeatRate > 20000.0 || surfaceTemperature > 1200.0))
     {
         hasBurnedUp = true;
+        if (!decided)
+            PublishEvent(SimEventType::BurnedUp);
         return;
     }
 
     // Crash condition: high impact speed
     if (impactSpeed > 15.0)
-    {
         hasCrashed = true;
-        return;
-    }
+    else // Otherwise, it's safe
+        hasLandedSafely = true;
 
-    // Otherwise, it's safe
-    hasLandedSafely = true;
+    if (!decided)
+        PublishEvent(SimEventType::Impact);
 }
 
 void Vessel::ComputeFlightPathAngle()
@@ -146,10 +581,11 @@ void Vessel::ComputeFlightPathAngle()
 
     double dot = vHat.Dot(rHat);             // how aligned with "up" are we?
     dot = std::clamp(dot, -1.0, 1.0);        // for safety
-    flightPathAngleRadians = std::asin(dot); // returns [-π/2, π/2]
+    flightPathAngleRadians = FastMath::Asin(dot); // returns [-π/2, π/2]
 }
 
-void Vessel::ApplyDrag(double deltaTime)
+// Signed, along the vertical; records density and drag diagnostics
+double Vessel::ComputeDragAcceleration()
 {
     lastAirDensity = 0.0;
     lastDragForce = 0.0;
@@ -158,22 +594,44 @@ void Vessel::ApplyDrag(double deltaTime)
     if (Atmosphere *atm = parentBody->GetAtmosphere())
     {
         lastAirDensity = atm->GetDensity(altitudeMeters);
-        double aoaModifier = hasDirectionalAerodynamics ? std::abs(std::cos(angleOfAttackRadians)) : 1.0;
+        double speed = std::abs(velocityMetersPerSecond);
+        double airspeed = speed;
+
+        if (perturbation)
+        {
+            PerturbationSample sample = perturbation->Sample(
+                perturbationProfile,
+                altitudeMeters,
+                latitudeDegrees,
+                longitudeDegrees,
+                missionTimeSeconds);
+
+            lastAirDensity *= sample.densityFactor;
+            airspeed = std::sqrt(speed * speed +
+                                 sample.windEast * sample.windEast +
+                                 sample.windNorth * sample.windNorth);
+        }
+
+        double aoaModifier = hasDirectionalAerodynamics ? std::abs(FastMath::Cos(angleOfAttackRadians)) : 1.0;
         double effectiveCd = dragCoefficient * aoaModifier;
 
-        lastDragForce = atm->ComputeDragForce(
-            altitudeMeters,
-            velocityMetersPerSecond,
-            effectiveCd,
-            crossSectionArea);
+        // Vertical component of the drag on the wind-relative airflow
+        lastDragForce = 0.5 * lastAirDensity * airspeed * speed * effectiveCd * crossSectionArea;
 
         lastDragAcceleration = lastDragForce / GetMass();
         double dragDirection = (velocityMetersPerSecond > 0.0) ? -1.0 : 1.0;
-        velocityMetersPerSecond += dragDirection * lastDragAcceleration * deltaTime;
+        return dragDirection * lastDragAcceleration;
     }
+    return 0.0;
 }
 
 void Vessel::ApplyLift(double deltaTime)
+{
+    velocityMetersPerSecond += ComputeLiftAcceleration() * deltaTime;
+}
+
+// Vertical component of the lift acceleration; records lift diagnostics
+double Vessel::ComputeLiftAcceleration()
 {
     lastLiftForce = 0.0;
     lastLiftVector = Vector3(0.0, 0.0, 0.0);
@@ -184,7 +642,7 @@ void Vessel::ApplyLift(double deltaTime)
         double rho = lastAirDensity;
         double v = velocityVector.Length();
 
-        double cl = 2.0 * M_PI * std::sin(angleOfAttackRadians);
+        double cl = 2.0 * M_PI * FastMath::Sin(angleOfAttackRadians);
         cl = std::clamp(cl, -1.5, 1.5);
 
         double liftForceMagnitude = 0.5 * rho * v * v * cl * crossSectionArea;
@@ -201,62 +659,155 @@ void Vessel::ApplyLift(double deltaTime)
 
         lastLiftVector = liftDir * liftForceMagnitude;
 
-        velocityMetersPerSecond += (lastLiftVector.y / GetMass()) * deltaTime;
+        return lastLiftVector.y / GetMass();
     }
+    return 0.0;
 }
 
 void Vessel::ApplyReentryHeating(double deltaTime)
+{
+    ComputeHeatRate();
+    totalHeatLoad += currentHeatRate * deltaTime;
+}
+
+void Vessel::ComputeHeatRate()
 {
     if (!parentBody->GetAtmosphere())
     {
         currentHeatRate = 0.0;
         return;
     }
+    currentHeatRate = ComputeHeatRate(lastAirDensity, std::abs(velocityMetersPerSecond));
+}
 
-    double rho = lastAirDensity;
-    double velocity = std::abs(velocityMetersPerSecond);
+// W/m² at the current angle of attack
+double Vessel::ComputeHeatRate(double airDensity, double speed) const
+{
     constexpr double heatTransferCoefficient = 1.83e-4;
+    double heatRate = heatTransferCoefficient * airDensity * speed * speed * speed;
 
-    currentHeatRate = heatTransferCoefficient * rho * velocity * velocity * velocity;
+    double aoaModifier = hasDirectionalAerodynamics ? std::abs(FastMath::Cos(angleOfAttackRadians)) : 1.0;
+    return heatRate * aoaModifier;
+}
 
-    double aoaModifier = hasDirectionalAerodynamics ? std::abs(std::cos(angleOfAttackRadians)) : 1.0;
-    currentHeatRate *= aoaModifier;
+// As ComputeDragAcceleration sees it, at any altitude and time
+double Vessel::ComputeAirDensity(double altitude, double time) const
+{
+    Atmosphere *atm = parentBody->GetAtmosphere();
+    if (!atm)
+        return 0.0;
 
-    totalHeatLoad += currentHeatRate * deltaTime;
+    double density = atm->GetDensity(altitude);
+    if (perturbation)
+        density *= perturbation->Sample(perturbationProfile, altitude, latitudeDegrees, longitudeDegrees, time).densityFactor;
+    return density;
 }
 
-void Vessel::AttachParachute(Parachute *p)
+bool Vessel::AttachParachute(ComponentArena &arena, ParachuteHandle chute)
 {
-    parachute = p;
+    if (!UseArena(arena))
+        return false;
+    parachute = chute;
     parachuteDeployed = false;
+    return true;
+}
+
+void Vessel::DeployParachute()
+{
+    if (Chute())
+        parachuteDeployed = true;
 }
 
 void Vessel::ApplyHeatShield(double deltaTime)
 {
-    if (heatShield && !heatShield->IsDepleted())
-        heatShield->AbsorbHeat(currentHeatRate, deltaTime);
+    HeatShield *shield = Shield();
+    if (shield && !shield->IsDepleted())
+        shield->AbsorbHeat(currentHeatRate, deltaTime);
 }
 
 void Vessel::ApplyRadiativeCooling(double deltaTime)
+{
+    double radiatedPower = ComputeRadiatedPower();
+    totalHeatLoad = std::max(0.0, totalHeatLoad - radiatedPower * deltaTime);
+}
+
+// W/m²; also updates the surface temperature from the stored heat load
+double Vessel::ComputeRadiatedPower()
 {
     constexpr double emissivity = 0.85;
     constexpr double stefanBoltzmann = 5.670374419e-8;
-    constexpr double heatCapacityPerArea = 2000.0;
 
-    surfaceTemperature = std::pow(
-        std::max(0.0, totalHeatLoad) / heatCapacityPerArea,
-        1.0);
+    surfaceTemperature = std::max(0.0, totalHeatLoad) / heatCapacityPerArea;
 
-    double radiatedPower = emissivity * stefanBoltzmann * std::pow(surfaceTemperature, 4.0);
-    totalHeatLoad = std::max(0.0, totalHeatLoad - radiatedPower * deltaTime);
+    double temperature2 = surfaceTemperature * surfaceTemperature;
+    double temperature4 = FastMath::IsFast() ? temperature2 * temperature2 : std::pow(surfaceTemperature, 4.0);
+    return emissivity * stefanBoltzmann * temperature4;
+}
+
+// Downward, at the vessel's site and mission time
+double Vessel::ComputeGravity() const
+{
+    return parentBody->ComputeGravitationalAcceleration(altitudeMeters, latitudeDegrees,
+                                                        longitudeDegrees, missionTimeSeconds);
 }
 
 // ==============================
 // Attach heat shield
 // ==============================
-void Vessel::AttachHeatShield(HeatShield *shield)
+bool Vessel::AttachHeatShield(ComponentArena &arena, HeatShieldHandle shield)
 {
+    if (!UseArena(arena))
+        return false;
     heatShield = shield;
+    return true;
+}
+
+const HeatShield *Vessel::GetHeatShield() const
+{
+    return Shield();
+}
+
+void Vessel::CopyComponentsTo(ComponentArena &arena)
+{
+    HeatShieldHandle shieldCopy;
+    ParachuteHandle chuteCopy;
+    if (const HeatShield *shield = Shield())
+        shieldCopy = arena.CreateHeatShield(*shield);
+    if (const Parachute *chute = Chute())
+        chuteCopy = arena.CreateParachute(*chute);
+
+    components = &arena;
+    heatShield = shieldCopy;
+    parachute = chuteCopy;
+}
+
+// Switching arenas is only allowed once nothing live is attached from the
+// old one; handles from different arenas cannot be mixed on one vessel
+bool Vessel::UseArena(ComponentArena &arena)
+{
+    if (components == &arena)
+        return true;
+    if (Shield() || Chute())
+        return false;
+    components = &arena;
+    heatShield = HeatShieldHandle();
+    parachute = ParachuteHandle();
+    return true;
+}
+
+HeatShield *Vessel::Shield()
+{
+    return components ? components->Get(heatShield) : nullptr;
+}
+
+const HeatShield *Vessel::Shield() const
+{
+    return components ? components->Get(heatShield) : nullptr;
+}
+
+const Parachute *Vessel::Chute() const
+{
+    return components ? components->Get(parachute) : nullptr;
 }
 
 // ==============================
@@ -272,13 +823,33 @@ void Vessel::SetOrientationVector(const Vector3 &orientation)
     orientationVector = orientation.Normalized();
 }
 
+void Vessel::SetSite(double latitudeDeg, double longitudeDeg)
+{
+    latitudeDegrees = latitudeDeg;
+    longitudeDegrees = longitudeDeg;
+}
+
+void Vessel::SetAtmospherePerturbation(const AtmospherePerturbation *field,
+                                       int profile,
+                                       double latitudeDeg,
+                                       double longitudeDeg)
+{
+    perturbation = field;
+    perturbationProfile = profile;
+    latitudeDegrees = latitudeDeg;
+    longitudeDegrees = longitudeDeg;
+}
+
 // ==============================
 // Getters
 // ==============================
 double Vessel::GetAltitude() const { return altitudeMeters; }
+double Vessel::GetMissionTime() const { return missionTimeSeconds; }
 double Vessel::GetVelocity() const { return velocityMetersPerSecond; }
 double Vessel::GetMass() const { return dryMassKg + fuelMassKg; }
 double Vessel::GetFuelMass() const { return fuelMassKg; }
+double Vessel::GetDragCoefficient() const { return dragCoefficient; }
+double Vessel::GetCrossSectionArea() const { return crossSectionArea; }
 bool Vessel::IsParachuteDeployed() const
 {
     return parachuteDeployed;
@@ -289,23 +860,32 @@ double Vessel::GetFuelPercent() const
         return 0.0;
     return (fuelMassKg / initialFuelMassKg) * 100.0;
 }
+double Vessel::GetInitialFuelMass() const { return initialFuelMassKg; }
 double Vessel::GetHeatRate() const { return currentHeatRate; }
 double Vessel::GetTotalHeatLoad() const { return totalHeatLoad; }
 double Vessel::GetHeatShieldMass() const
 {
-    return heatShield ? heatShield->GetRemainingMass() : 0.0;
+    const HeatShield *shield = Shield();
+    return shield ? shield->GetRemainingMass() : 0.0;
 }
 double Vessel::GetAblatedMass() const
 {
-    return heatShield ? heatShield->GetTotalAblatedMass() : 0.0;
+    const HeatShield *shield = Shield();
+    return shield ? shield->GetTotalAblatedMass() : 0.0;
 }
 double Vessel::GetHeatShieldSurfaceTemp() const
 {
-    return heatShield ? heatShield->GetSurfaceTemperature() : 0.0;
+    const HeatShield *shield = Shield();
+    return shield ? shield->GetSurfaceTemperature() : 0.0;
 }
 bool Vessel::IsHeatShieldDepleted() const
 {
-    return heatShield ? heatShield->IsDepleted() : true;
+    const HeatShield *shield = Shield();
+    return shield ? shield->IsDepleted() : true;
+}
+bool Vessel::HasHeatShield() const
+{
+    return Shield() != nullptr;
 }
 double Vessel::GetAngleOfAttackDegrees() const
 {
@@ -341,3 +921,13 @@ bool Vessel::HasLandedSafely() const
 {
     return hasLandedSafely;
 }
+
+const ThrustModel &Vessel::GetEngine() const
+{
+    return engine;
+}
+
+OrbitalBody *Vessel::GetParentBody() const
+{
+    return parentBody;
+}
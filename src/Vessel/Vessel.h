@@ -1,12 +1,71 @@
 #pragma once
 
-#include <iostream>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+#include <ComponentPool.h>
 #include <HeatShield.h>
 #include <ThrustModel.h>
 #include <Vector3.h>
 #include <Parachute.h>
 
 class OrbitalBody; // forward declare to avoid circular include
+class AtmospherePerturbation;
+enum class SimEventType : uint8_t;
+
+// Integrated state of a vessel, for checkpoint/restore (e.g. time slices)
+struct VesselState
+{
+    double altitude = 0.0;      // m
+    double velocity = 0.0;      // m/s
+    double fuelMass = 0.0;      // kg
+    double totalHeatLoad = 0.0; // J/m²
+    double heatShieldMass = 0.0;
+    double ablatedMass = 0.0;
+    double missionTime = 0.0; // s
+    bool parachuteDeployed = false;
+};
+
+// Time derivatives of the integrated part of VesselState
+struct VesselRates
+{
+    double altitude = 0.0; // m/s
+    double velocity = 0.0; // m/s²
+    double fuelMass = 0.0; // kg/s
+    double totalHeatLoad = 0.0;
+    double heatShieldMass = 0.0;
+    double ablatedMass = 0.0;
+};
+
+enum class IntegrationMethod
+{
+    SemiImplicitEuler, // forces applied in sequence (default)
+    ExplicitEuler,
+    Heun,        // 2nd order
+    RungeKutta4, // 4th order
+    MultiRate    // subsystems on their own steps, see MultiRateSettings
+};
+
+// Per-subsystem step sizes for IntegrationMethod::MultiRate; 0 = the step
+// passed to Update. Translation sub-steps the update, engine and chute
+// nest inside each translation step, and thermal spans the whole update
+// reading altitude and speed interpolated from the translation steps.
+// All of them meet again at the end of every Update.
+struct MultiRateSettings
+{
+    double translationStep = 0.0; // s, drag, lift, gravity, altitude
+    double engineStep = 0.0;      // s, thrust and fuel burn
+    double chuteStep = 0.0;       // s, resolution of the deploy trigger
+    double thermalStep = 0.0;     // s, heating, ablation, radiative cooling
+    // Translation and thermal steps also shrink to keep the change in
+    // velocity and surface temperature per step under these (0 = fixed)
+    double translationTolerance = 0.0; // m/s
+    double thermalTolerance = 0.0;     // K
+    double minStep = 1e-4;             // s, floor for the shrunk steps
+};
+
+const char *ToString(IntegrationMethod method);
 
 class Vessel
 {
@@ -20,17 +79,36 @@ public:
            OrbitalBody *parentBody,
            const ThrustModel &engineModel);
 
+    // Publishes deploy, burnout, apex, shield depletion, impact and burnup
+    // to EventBus::Global() as they happen
     void Update(double deltaTime);
 
+    VesselState GetState() const;
+    void SetState(const VesselState &state); // clears any reentry outcome
+    VesselRates ComputeRates();
+
+    void SetIntegrationMethod(IntegrationMethod method) { integrationMethod = method; }
+    IntegrationMethod GetIntegrationMethod() const { return integrationMethod; }
+    void SetMultiRateSettings(const MultiRateSettings &settings) { multiRate = settings; }
+    const MultiRateSettings &GetMultiRateSettings() const { return multiRate; }
+
     void ApplyThrust(double deltaTime, double pressure);
 
     void SetThrottle(double throttle);
 
+    // Tags this vessel's events; unique per constructed vessel unless set
+    uint64_t GetId() const { return id; }
+    void SetId(uint64_t vesselId) { id = vesselId; }
+
     double GetAltitude() const;
+    double GetMissionTime() const;
     double GetVelocity() const;
     double GetMass() const;
     double GetFuelMass() const;
     double GetFuelPercent() const;
+    double GetInitialFuelMass() const;
+    double GetDragCoefficient() const;
+    double GetCrossSectionArea() const;
 
     double GetLastAirDensity() const { return lastAirDensity; }
     double GetLastDragForce() const { return lastDragForce; }
@@ -40,34 +118,88 @@ public:
     double GetHeatShieldSurfaceTemp() const;
     double GetAblatedMass() const;
     bool IsHeatShieldDepleted() const;
+    bool HasHeatShield() const;
     double GetAngleOfAttackDegrees() const;
     void ComputeVelocityVector();
     void ComputeAngleOfAttack();
     void EvaluateReentryOutcome();
-    void ApplyDrag(double deltaTime);
     void ApplyLift(double deltaTime);
     void ApplyReentryHeating(double deltaTime);
     void ApplyHeatShield(double deltaTime);
     void ApplyRadiativeCooling(double deltaTime);
-    void AttachHeatShield(HeatShield *shield);
+    // Components live in a caller-owned arena. A vessel draws all of its
+    // components from one arena; attaching from another while a component
+    // from the first is still attached is refused and returns false.
+    bool AttachHeatShield(ComponentArena &arena, HeatShieldHandle shield);
+    const HeatShield *GetHeatShield() const;
+    // Re-home the attached components as fresh copies in `arena`
+    void CopyComponentsTo(ComponentArena &arena);
     Vector3 GetLiftVector() const;
     double GetLiftForce() const;
     void SetOrientationVector(const Vector3 &orientation);
+    // Surface site the vertical trajectory stands on, for gravity and
+    // perturbation lookups
+    void SetSite(double latitudeDeg, double longitudeDeg);
+    // Fly through one profile of a gridded wind/density dataset (nullptr = none)
+    void SetAtmospherePerturbation(const AtmospherePerturbation *field,
+                                   int profile,
+                                   double latitudeDeg,
+                                   double longitudeDeg);
     void ComputeFlightPathAngle();
     double GetFlightPathAngleDegrees() const;
     bool HasBurnedUp() const;
     bool HasCrashed() const;
     bool HasLandedSafely() const;
-    void AttachParachute(Parachute *p);
+    bool AttachParachute(ComponentArena &arena, ParachuteHandle chute);
+    void DeployParachute();
     bool IsParachuteDeployed() const;
-    void ApplyParachuteDrag(double deltaTime);
 
     double GetHeatRate() const;
     double GetTotalHeatLoad() const;
 
+    const ThrustModel &GetEngine() const;
+    OrbitalBody *GetParentBody() const;
+
 private:
+    // Translation state at a sub-step boundary, for the thermal subsystem
+    struct TrajectorySample
+    {
+        double time; // s, mission time
+        double altitude;
+        double speed;
+    };
+
+    void StepSequential(double deltaTime);
+    void StepRates(double deltaTime);
+    void StepMultiRate(double deltaTime);
+    void StepTranslation(double deltaTime);
+    void StepThermal(double deltaTime);
+    void IntegrateRates(const VesselRates &k1, double deltaTime);
+    void LoadIntegratedState(const VesselState &state);
+    static VesselRates Combine(std::initializer_list<std::pair<VesselRates, double>> terms);
+    static VesselState Advance(const VesselState &state, const VesselRates &rates, double deltaTime);
+
+    double ComputeThrustAcceleration(double pressure, double &massFlowRate) const;
+    double ComputeDragAcceleration();
+    double ComputeLiftAcceleration();
+    void UpdateParachuteDeployment();
+    double ComputeParachuteAcceleration() const;
+    double ComputeQuadraticDragFactor() const;
+    void ComputeHeatRate();
+    double ComputeHeatRate(double airDensity, double speed) const;
+    double ComputeAirDensity(double altitude, double time) const;
+    double ComputeRadiatedPower();
+    double ComputeGravity() const;
+    void PublishEvent(SimEventType type) const;
+
+    bool UseArena(ComponentArena &arena);
+    HeatShield *Shield();
+    const HeatShield *Shield() const;
+    const Parachute *Chute() const;
+
     double altitudeMeters;
     double angleOfAttackRadians;
+    ComponentArena *components; // owner of heatShield / parachute
     double crossSectionArea;
     double currentHeatRate; // W/m²
     double dragCoefficient;
@@ -79,20 +211,61 @@ private:
     bool hasCrashed = false;
     bool hasDirectionalAerodynamics; // false for sphere, true for cone/cylinder
     bool hasLandedSafely = false;
-    HeatShield *heatShield;
+    HeatShieldHandle heatShield;
+    uint64_t id;
     double initialFuelMassKg;
+    IntegrationMethod integrationMethod = IntegrationMethod::SemiImplicitEuler;
     double lastAirDensity;
     double lastDragAcceleration;
     double lastDragForce;
     double lastLiftForce;      // N
     Vector3 lastLiftVector;    // for logging or debugging
+    double latitudeDegrees;    // site, for gravity and perturbation lookups
+    double longitudeDegrees;
+    double missionTimeSeconds;
     Vector3 orientationVector; // ship’s pointing direction
-    Parachute *parachute;
+    ParachuteHandle parachute;
     bool parachuteDeployed;
     OrbitalBody *parentBody;
+    const AtmospherePerturbation *perturbation;
+    int perturbationProfile;
+    MultiRateSettings multiRate;
+    std::vector<TrajectorySample> trajectorySamples; // thermal inputs, one Update
     Vector3 positionVector;
     double surfaceTemperature; // K
     double totalHeatLoad;      // J/m²
     double velocityMetersPerSecond;
     Vector3 velocityVector; // live velocity
 };
+
+// dv/dt = -g - k v|v| with g and k frozen over the step, solved exactly:
+// tan while rising, then tanh toward terminal velocity while falling.
+// Stable and monotone at any step size, unlike explicit drag, which
+// overshoots once k |v| dt approaches 1 (an opening chute). Shared by
+// Vessel and ReentryEnsemble.
+template <typename Real>
+Real QuadraticDragStep(Real velocity, Real gravity, Real k, Real deltaTime)
+{
+    if (k <= Real(0))
+        return velocity - gravity * deltaTime;
+    if (gravity <= Real(0))
+        return velocity / (Real(1) + k * std::abs(velocity) * deltaTime) - gravity * deltaTime;
+
+    Real terminal = std::sqrt(gravity / k);
+    Real rate = std::sqrt(gravity * k); // 1/s
+    if (velocity > Real(0))
+    {
+        Real angle = std::atan(velocity / terminal);
+        Real untilApex = angle / rate;
+        if (deltaTime < untilApex)
+            return terminal * std::tan(angle - rate * deltaTime);
+        deltaTime -= untilApex;
+        velocity = Real(0);
+    }
+
+    // tanh(atanh(r) + x) by the addition formula; also covers r > 1
+    // (faster than terminal), where it is the coth branch
+    Real ratio = -velocity / terminal;
+    Real t = std::tanh(rate * deltaTime);
+    return -terminal * (ratio + t) / (Real(1) + ratio * t);
+}
@@ -0,0 +1,207 @@
+#include "World.h"
+#include <OrbitalBody.h>
+#include <cmath>
+
+World::World(OrbitalBody *body, const BreakupModel &breakup, double cellSizeMeters, unsigned seed)
+    : body(body),
+      breakup(breakup),
+      rng(seed),
+      time(0.0),
+      activeCount(0),
+      flyingIndex(cellSizeMeters),
+      impactIndex(cellSizeMeters) {}
+
+int World::AddVessel(const Vessel &vessel, double groundX, double groundZ)
+{
+    int id = static_cast<int>(objects.size());
+    bool flying = vessel.GetAltitude() > 0.0;
+    objects.push_back({vessel, id, -1, 0, groundX, groundZ, 0.0, 0.0, flying, false});
+    if (flying)
+        ++activeCount;
+    return id;
+}
+
+// ==============================
+// Stepping
+// ==============================
+void World::Step(double deltaTime)
+{
+    // Fragments appended during the sweep start flying next step
+    size_t count = objects.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        WorldObject &object = objects[i];
+        if (!object.active)
+            continue;
+
+        bool hadIntactShield = object.vessel.HasHeatShield() && !object.vessel.IsHeatShieldDepleted();
+        object.vessel.Update(deltaTime);
+
+        // Horizontal drift decays with the same quadratic drag the vessel feels
+        // vertically; implicit so large steps can't reverse the drift.
+        double speed = std::abs(object.vessel.GetVelocity());
+        double dragRate = (speed > 1.0) ? object.vessel.GetLastDragAcceleration() / speed : 0.0;
+        double decay = 1.0 / (1.0 + dragRate * deltaTime);
+        object.driftX *= decay;
+        object.driftZ *= decay;
+        object.groundX += object.driftX * deltaTime;
+        object.groundZ += object.driftZ * deltaTime;
+
+        if (object.vessel.GetAltitude() <= 0.0)
+        {
+            object.active = false;
+            --activeCount;
+            // Impacts only accumulate: index them as they land
+            impactIds.push_back(object.id);
+            impactIndex.Insert(Vector3(object.groundX, 0.0, object.groundZ));
+        }
+        else if (ShouldBreakUp(object, hadIntactShield))
+        {
+            SpawnFragments(static_cast<int>(i));
+        }
+    }
+
+    time += deltaTime;
+    RebuildFlyingIndex();
+}
+
+void World::Run(double deltaTime, double maxTime)
+{
+    while (time <= maxTime && activeCount > 0)
+        Step(deltaTime);
+}
+
+bool World::ShouldBreakUp(const WorldObject &object, bool hadIntactShield) const
+{
+    if (object.generation >= breakup.maxGenerations)
+        return false;
+
+    const Vessel &vessel = object.vessel;
+
+    // Shield just ablated away while still in the heating pulse
+    if (hadIntactShield && vessel.IsHeatShieldDepleted())
+        return true;
+
+    // Unshielded structure overheating in flight
+    return !vessel.HasHeatShield() && vessel.GetHeatRate() > breakup.burnupHeatRate;
+}
+
+void World::SpawnFragments(int parentIndex)
+{
+    // Copy what we need: push_back below may reallocate `objects`
+    WorldObject parent = objects[parentIndex];
+    objects[parentIndex].active = false;
+    objects[parentIndex].brokenUp = true;
+    --activeCount;
+
+    std::uniform_real_distribution<double> weightDist(0.5, 1.5);
+    std::uniform_real_distribution<double> cdDist(breakup.minDragCoefficient, breakup.maxDragCoefficient);
+    std::uniform_real_distribution<double> scatterDist(-breakup.scatterSpeed, breakup.scatterSpeed);
+
+    std::vector<double> weights(breakup.fragmentCount);
+    double weightSum = 0.0;
+    for (double &w : weights)
+    {
+        w = weightDist(rng);
+        weightSum += w;
+    }
+
+    double parentMass = parent.vessel.GetMass();
+    double survivingMass = parentMass * breakup.survivingMassFraction;
+    ThrustModel noEngine(0.0, 0.0, 0.0);
+
+    for (double w : weights)
+    {
+        double fragmentMass = survivingMass * w / weightSum;
+
+        // Area scales with mass^(2/3) for geometrically similar pieces
+        double area = parent.vessel.GetCrossSectionArea() * std::pow(fragmentMass / parentMass, 2.0 / 3.0);
+
+        Vessel fragment(
+            parent.vessel.GetAltitude(),
+            parent.vessel.GetVelocity() + scatterDist(rng),
+            fragmentMass,
+            0.0,
+            cdDist(rng),
+            area,
+            body,
+            noEngine);
+
+        int id = static_cast<int>(objects.size());
+        objects.push_back({fragment, id, parent.id, parent.generation + 1,
+                           parent.groundX, parent.groundZ,
+                           parent.driftX + scatterDist(rng), parent.driftZ + scatterDist(rng),
+                           true, false});
+        ++activeCount;
+    }
+}
+
+void World::RebuildFlyingIndex()
+{
+    std::vector<Vector3> positions;
+    flyingIds.clear();
+    for (const WorldObject &object : objects)
+    {
+        if (!object.active)
+            continue;
+        positions.emplace_back(object.groundX, object.vessel.GetAltitude(), object.groundZ);
+        flyingIds.push_back(object.id);
+    }
+    flyingIndex.Build(positions);
+}
+
+// ==============================
+// Queries
+// ==============================
+void World::FindNeighbours(int id, double radius, std::vector<int> &out) const
+{
+    const WorldObject &object = objects[id];
+    Vector3 center(object.groundX, object.vessel.GetAltitude(), object.groundZ);
+
+    std::vector<int> hits;
+    flyingIndex.QueryRadius(center, radius, hits);
+
+    out.clear();
+    for (int hit : hits)
+        if (flyingIds[hit] != id)
+            out.push_back(flyingIds[hit]);
+}
+
+void World::FindImpactsInFootprint(double minX, double minZ, double maxX, double maxZ,
+                                   std::vector<int> &out) const
+{
+    std::vector<int> hits;
+    impactIndex.QueryBox(Vector3(minX, 0.0, minZ), Vector3(maxX, 0.0, maxZ), hits);
+
+    out.clear();
+    for (int hit : hits)
+        out.push_back(impactIds[hit]);
+}
+
+size_t World::FindDensestImpactCell(double &groundX, double &groundZ) const
+{
+    Vector3 center;
+    size_t count = impactIndex.FindDensestCell(center);
+    groundX = center.x;
+    groundZ = center.z;
+    return count;
+}
+
+// ==============================
+// Getters
+// ==============================
+const WorldObject &World::GetObject(int id) const { return objects[id]; }
+size_t World::GetObjectCount() const { return objects.size(); }
+size_t World::GetImpactCount() const { return impactIds.size(); }
+double World::GetTime() const { return time; }
+
+size_t World::GetActiveCount() const { return activeCount; }
+
+size_t World::GetFragmentCount() const
+{
+    size_t fragments = 0;
+    for (const WorldObject &object : objects)
+        if (object.parentId >= 0)
+            ++fragments;
+    return fragments;
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <random>
+#include <vector>
+#include <SpatialHash.h>
+#include <Vessel.h>
+
+class OrbitalBody;
+
+// How a vessel comes apart when it burns up or its heat shield is exhausted
+struct BreakupModel
+{
+    int fragmentCount = 24;
+    double survivingMassFraction = 0.6; // rest is vaporized at breakup
+    double scatterSpeed = 40.0;         // m/s, max separation impulse per axis
+    double minDragCoefficient = 0.8;    // tumbling fragments
+    double maxDragCoefficient = 1.6;
+    double burnupHeatRate = 20000.0; // W/m², unshielded in-flight burnup threshold
+    int maxGenerations = 1;          // fragments of fragments allowed
+};
+
+// One simulated object: an original vessel or a breakup fragment
+struct WorldObject
+{
+    Vessel vessel;
+    int id;
+    int parentId;   // -1 for vessels added directly
+    int generation; // 0 for vessels added directly
+    double groundX; // m, horizontal offset from the entry site
+    double groundZ; // m
+    double driftX;  // m/s, horizontal velocity
+    double driftZ;  // m/s
+    bool active;    // still flying
+    bool brokenUp;  // replaced by fragments
+};
+
+// Steps many vessels against one body, spawns debris on breakup and keeps a
+// spatial index of the flying objects and of the ground impact points.
+class World
+{
+public:
+    World(OrbitalBody *body,
+          const BreakupModel &breakup = BreakupModel(),
+          double cellSizeMeters = 100.0,
+          unsigned seed = 0);
+
+    int AddVessel(const Vessel &vessel, double groundX = 0.0, double groundZ = 0.0);
+
+    void Step(double deltaTime);
+    void Run(double deltaTime, double maxTime);
+
+    // Flying objects within `radius` of object `id` (excluding itself)
+    void FindNeighbours(int id, double radius, std::vector<int> &out) const;
+
+    // Landed objects whose impact point lies in the ground rectangle
+    void FindImpactsInFootprint(double minX, double minZ, double maxX, double maxZ,
+                                std::vector<int> &out) const;
+
+    // Impact count in the most crowded index cell, and that cell's centre
+    size_t FindDensestImpactCell(double &groundX, double &groundZ) const;
+
+    const WorldObject &GetObject(int id) const;
+    size_t GetObjectCount() const;
+    size_t GetActiveCount() const;
+    size_t GetFragmentCount() const;
+    size_t GetImpactCount() const;
+    double GetTime() const;
+
+private:
+    bool ShouldBreakUp(const WorldObject &object, bool hadIntactShield) const;
+    void SpawnFragments(int parentIndex);
+    void RebuildFlyingIndex();
+
+    OrbitalBody *body;
+    BreakupModel breakup;
+    std::mt19937 rng;
+    double time;
+    size_t activeCount;
+
+    std::vector<WorldObject> objects;
+
+    SpatialHash flyingIndex;
+    std::vector<int> flyingIds; // hash point index -> object id
+    SpatialHash impactIndex;
+    std::vector<int> impactIds; // hash point index -> object id
+};
@@ -1,11 +1,46 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include <functional>
 #include <fstream>
 #include <iomanip>
+#include <sstream>
 #include <vector>
+#include <filesystem>
+#include <random>
+#include <thread>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #include "OrbitalBody/OrbitalBody.h"
 #include "Atmosphere/Atmosphere.h"
 #include "ThrustModel/ThrustModel.h"
 #include "Vessel/Vessel.h"
+#include "ComponentPool/ComponentPool.h"
+#include "World/World.h"
+#include "LaunchOptimizer/LaunchOptimizer.h"
+#include "MissionScript/MissionScript.h"
+#include "ReentryEnsemble/ReentryEnsemble.h"
+#include "AtmospherePerturbation/AtmospherePerturbation.h"
+#include "SimulationService/SimulationService.h"
+#include "Parareal/Parareal.h"
+#include "ConvergenceStudy/ConvergenceStudy.h"
+#include "FastMath/FastMath.h"
+#include "RealTimeScheduler/RealTimeScheduler.h"
+#include "ControlChannel/ControlChannel.h"
+#include "ChebyshevEphemeris/ChebyshevEphemeris.h"
+#include "TelemetryArchive/TelemetryArchive.h"
+#include "SurrogateCache/SurrogateCache.h"
+#include "MetricsRegistry/MetricsRegistry.h"
+#include "EventBus/EventBus.h"
+#include "ShardedSweep/ShardedSweep.h"
+
+// Console announcements for the vessels a demo follows
+ConsoleSink narration(std::cout, {SimEventType::ParachuteDeployed, SimEventType::Burnout, SimEventType::Apex});
 
 void SimulateLaunch(const std::string &bodyName, OrbitalBody *body)
 {
@@ -27,6 +62,7 @@ void SimulateLaunch(const std::string &bodyName, OrbitalBody *body)
         body,
         engine);
     rocket.SetThrottle(1.0);
+    narration.Follow(rocket.GetId());
 
     // === Logging Setup ===
     std::string logFileName = "flight_log_" + bodyName + ".csv";
@@ -59,18 +95,14 @@ void SimulateLaunch(const std::string &bodyName, OrbitalBody *body)
         if (altitude > maxAltitude)
             maxAltitude = altitude;
 
-        // Burnout detection
-        if (rocket.GetFuelMass() <= 0.0 && !fuelBurnedOut)
-        {
+        // Burnout and apex are announced by the vessel's events
+        if (rocket.GetFuelMass() <= 0.0)
             fuelBurnedOut = true;
-            std::cout << "🛑 Fuel exhausted at t = " << time << " seconds\n";
-        }
 
-        // Apex detection
         if (fuelBurnedOut && velocity <= 0.0 && !apexReached)
         {
             apexReached = true;
-            std::cout << "📍 Apex reached at t = " << time << " seconds\n";
+            EventBus::Global().Flush();
             std::cout << "🛰  Max Altitude: " << maxAltitude << " meters\n";
             break;
         }
@@ -95,6 +127,8 @@ void SimulateLaunch(const std::string &bodyName, OrbitalBody *body)
     }
 
     logFile.close();
+    EventBus::Global().Flush();
+    narration.Unfollow(rocket.GetId());
     std::cout << "✅ Simulation complete for " << bodyName << ".\n\n";
 }
 
@@ -118,12 +152,13 @@ void SimulateReentry(const std::string &bodyName, OrbitalBody *body)
         dummyEngine);
 
     // === Add heat shield ===
-    HeatShield shield(
+    ComponentArena components(1, 0);
+    HeatShieldHandle shield = components.CreateHeatShield(HeatShield(
         250.0, // Mass (kg)
         5.0,   // Area (m²)
         2e6    // J/kg
-    );
-    capsule.AttachHeatShield(&shield);
+        ));
+    capsule.AttachHeatShield(components, shield);
 
     // === Log Setup ===
     std::ofstream logFile("reentry_test_" + bodyName + ".csv");
@@ -224,9 +259,13 @@ void TestReentryOutcomes(OrbitalBody *planet)
         {"Crash", -300.0, 250.0, false} // but impact too fast
     };
 
+    // Components for the current test only; reset between tests
+    ComponentArena components(1, 1);
+
     for (const auto &test : tests)
     {
         std::cout << "\n🧪 Running: " << test.label << "\n";
+        components.Reset();
 
         ThrustModel dummyEngine(0.0, 0.0, 0.0);
 
@@ -241,20 +280,18 @@ void TestReentryOutcomes(OrbitalBody *planet)
             dummyEngine);
 
         if (!test.disableHeatShield)
-        {
-            HeatShield shield(test.shieldMass, 5.0, 2e6);
-            capsule.AttachHeatShield(&shield);
-        }
+            capsule.AttachHeatShield(components, components.CreateHeatShield(HeatShield(test.shieldMass, 5.0, 2e6)));
 
         capsule.SetOrientationVector(Vector3(0.0, -1.0, 0.0)); // Straight down
-        Parachute chute(
+        ParachuteHandle chute = components.CreateParachute(Parachute(
             500.0,  // Area in m²
             2.2,    // Cd — typical for round parachutes
             3000.0, // Deploy altitude
             8000.0  // Max supported mass
-        );
+            ));
 
-        capsule.AttachParachute(&chute);
+        capsule.AttachParachute(components, chute);
+        narration.Follow(capsule.GetId());
         const double deltaTime = 0.1;
         double time = 0.0;
 
@@ -264,6 +301,8 @@ void TestReentryOutcomes(OrbitalBody *planet)
             time += deltaTime;
         }
 
+        EventBus::Global().Flush();
+        narration.Unfollow(capsule.GetId());
         std::cout << "  Final altitude: " << capsule.GetAltitude() << " m\n";
         std::cout << "  Final velocity: " << capsule.GetVelocity() << " m/s\n";
         std::cout << "  Final surface temp: " << capsule.GetSurfaceTemperature() << " K\n";
@@ -279,15 +318,1777 @@ void TestReentryOutcomes(OrbitalBody *planet)
     }
 }
 
-int main()
+void SimulateDebrisField(const std::string &bodyName, OrbitalBody *body)
+{
+    std::cout << "\n☄️  Debris field simulation on " << bodyName << "...\n";
+
+    ThrustModel dummyEngine(0.0, 0.0, 0.0);
+    Vessel capsule(
+        100000.0, // Altitude: 100 km
+        -7500.0,  // Velocity: 7.5 km/s downward
+        5000.0,   // Dry mass
+        0.0,      // No fuel
+        1.25,     // Cd
+        5.0,      // Area
+        body,
+        dummyEngine);
+
+    // Undersized shield: depletes mid-pulse and the capsule breaks apart
+    ComponentArena components(1, 0);
+    capsule.AttachHeatShield(components, components.CreateHeatShield(HeatShield(5.0, 5.0, 2e6)));
+
+    BreakupModel breakup;
+    breakup.fragmentCount = 500;
+
+    World world(body, breakup, 250.0, 42);
+    world.AddVessel(capsule);
+    world.Run(0.1, 6000.0);
+
+    // Footprint extent and densest landing cell
+    double minX = 0.0, maxX = 0.0, minZ = 0.0, maxZ = 0.0;
+    for (size_t id = 0; id < world.GetObjectCount(); ++id)
+    {
+        const WorldObject &object = world.GetObject(static_cast<int>(id));
+        if (object.brokenUp)
+            continue;
+        minX = std::min(minX, object.groundX);
+        maxX = std::max(maxX, object.groundX);
+        minZ = std::min(minZ, object.groundZ);
+        maxZ = std::max(maxZ, object.groundZ);
+    }
+
+    std::vector<int> nearSite;
+    world.FindImpactsInFootprint(-100.0, -100.0, 100.0, 100.0, nearSite);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  Fragments spawned: " << world.GetFragmentCount() << "\n";
+    std::cout << "  Impacts: " << world.GetImpactCount() << " after " << world.GetTime() << " s\n";
+    std::cout << "  Footprint: x [" << minX << ", " << maxX << "] m, z [" << minZ << ", " << maxZ << "] m\n";
+    std::cout << "  Impacts within 100 m of the entry site: " << nearSite.size() << "\n";
+    double denseX = 0.0, denseZ = 0.0;
+    size_t denseCount = world.FindDensestImpactCell(denseX, denseZ);
+    std::cout << "  Densest landing cell: " << denseCount << " impacts around (" << denseX << ", " << denseZ << ") m\n";
+    std::cout << "✅ Debris field complete.\n";
+}
+
+void OptimizeLaunchProfile(const std::string &bodyName, OrbitalBody *body, LaunchObjective objective)
+{
+    const char *objectiveName = objective == LaunchObjective::MaxApexAltitude         ? "max apex altitude"
+                                : objective == LaunchObjective::MinMaxDynamicPressure ? "min max-q"
+                                                                                      : "min fuel";
+    std::cout << "\n🎯 Optimizing launch profile on " << bodyName << " for " << objectiveName << "...\n";
+
+    LaunchOptimizerSettings settings;
+    settings.objective = objective;
+    settings.targetApexAltitude = 60000.0;
+    settings.maxGenerations = 20;
+
+    LaunchOptimizer optimizer(body, LaunchVehicle(), settings);
+    LaunchOptimizationResult result = optimizer.Optimize();
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  Generations: " << result.generations
+              << ", evaluations: " << result.evaluations
+              << " (" << result.earlyTerminations << " terminated early)\n";
+    std::cout << "  Apex: " << result.bestEvaluation.apexAltitude << " m"
+              << ", max-q: " << result.bestEvaluation.maxDynamicPressure << " Pa"
+              << ", fuel used: " << result.bestEvaluation.fuelUsed << " kg\n";
+    std::cout << "  Throttle knots:";
+    for (double knot : result.bestProfile.throttleKnots)
+        std::cout << " " << std::setprecision(2) << knot;
+    std::cout << "\n✅ Optimization complete.\n";
+}
+
+MissionScript LaunchAndRecover(Vessel &vessel, double throttle)
+{
+    vessel.SetThrottle(throttle);
+    co_await WaitUntilFuelBelow(10.0);
+
+    vessel.SetThrottle(0.0);
+    co_await WaitUntilApex();
+
+    vessel.SetOrientationVector(Vector3(0.0, 1.0, 0.0)); // retrograde on the way down
+    co_await WaitUntilAltitudeBelow(3000.0);
+
+    vessel.DeployParachute();
+}
+
+void RunScriptedMissions(const std::string &bodyName, OrbitalBody *body, int vesselCount)
+{
+    std::cout << "\n📜 Running " << vesselCount << " scripted missions on " << bodyName << "...\n";
+
+    ThrustModel engine(3.0e5, 350.0, 280.0);
+    Parachute chute(
+        500.0,  // Area in m²: ~12 m/s terminal for the empty 10 t vessel
+        2.2,    // Cd
+        -1.0,   // Never auto-deploys; the script decides
+        20000.0 // Max supported mass
+    );
+    ComponentArena components(0, vesselCount);
+
+    std::vector<Vessel> vessels;
+    vessels.reserve(vesselCount); // scripts hold references
+    MissionScheduler scheduler;
+
+    for (int i = 0; i < vesselCount; ++i)
+    {
+        vessels.emplace_back(0.0, 0.0, 10000.0, 4000.0, 0.5, 1.2, body, engine);
+        vessels.back().AttachParachute(components, components.CreateParachute(chute));
+        scheduler.Add(LaunchAndRecover(vessels.back(), 0.6 + 0.4 * i / vesselCount));
+    }
+
+    const double deltaTime = 0.1;
+    double time = 0.0;
+    size_t flying = vessels.size();
+    size_t steps = 0;
+
+    while (time <= 6000.0 && flying > 0)
+    {
+        flying = 0;
+        for (Vessel &vessel : vessels)
+        {
+            if (vessel.GetAltitude() < 0.0)
+                continue;
+            vessel.Update(deltaTime);
+            ++steps;
+            ++flying;
+        }
+        time += deltaTime;
+        scheduler.Advance(time);
+    }
+
+    int safe = 0, crashed = 0, burned = 0;
+    for (const Vessel &vessel : vessels)
+    {
+        safe += vessel.HasLandedSafely() ? 1 : 0;
+        crashed += vessel.HasCrashed() ? 1 : 0;
+        burned += vessel.HasBurnedUp() ? 1 : 0;
+    }
+
+    std::cout << "  Vessel steps: " << steps
+              << ", condition checks: " << scheduler.GetConditionChecks()
+              << ", resumes: " << scheduler.GetResumes() << "\n";
+    std::cout << "  Scripts finished: " << scheduler.GetScriptCount() - scheduler.GetRunningCount()
+              << "/" << scheduler.GetScriptCount() << "\n";
+    std::cout << "  Landed safely: " << safe << ", crashed: " << crashed << ", burned up: " << burned << "\n";
+    std::cout << "✅ Scripted missions complete.\n";
+}
+
+void ValidateEnsemblePrecision(const std::string &bodyName, OrbitalBody *body, int sampleCount)
+{
+    std::cout << "\n🎲 Validating reduced-precision ensembles on " << bodyName << "...\n";
+
+    // Sweep entry speed and shield mass across the safe/crash/burnup boundaries
+    std::vector<EnsembleSample> samples;
+    for (int i = 0; i < sampleCount; ++i)
+    {
+        EnsembleSample sample;
+        sample.velocity = -300.0 - 7200.0 * ((i * 37) % sampleCount) / sampleCount;
+        sample.shieldMassKg = 250.0 * ((i * 53) % sampleCount) / sampleCount;
+        sample.chuteArea = (i % 2 == 0) ? 500.0 : 50.0;
+        samples.push_back(sample);
+    }
+
+    // Standard math keeps the drag pass scalar; fast math vectorizes it, which
+    // is where float's wider lanes pay off
+    for (FastMath::Mode mode : {FastMath::Mode::Standard, FastMath::Mode::Fast})
+    {
+        FastMath::SetMode(mode);
+        std::cout << "  " << (mode == FastMath::Mode::Fast ? "Fast" : "Standard") << " math:\n";
+        for (EnsemblePrecision precision : {EnsemblePrecision::Float, EnsemblePrecision::Mixed})
+            std::cout << ValidatePrecision(precision, body, samples).Format();
+    }
+    FastMath::SetMode(FastMath::Mode::Standard);
+
+    // The double ensemble against the scalar path it stands in for
+    std::vector<EnsembleOutcome> ensemble = RunReentryEnsemble(EnsemblePrecision::Double, body, samples, 0.1, 6000.0);
+    size_t mismatches = 0;
+    double maxHeatError = 0.0, maxImpactError = 0.0, maxShieldError = 0.0;
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        const EnsembleSample &sample = samples[i];
+        ReentryScenario scenario;
+        scenario.altitude = sample.altitude;
+        scenario.velocity = sample.velocity;
+        scenario.dryMassKg = sample.massKg;
+        scenario.dragCoefficient = sample.dragCoefficient;
+        scenario.crossSectionArea = sample.crossSectionArea;
+        scenario.shieldMassKg = sample.shieldMassKg;
+        scenario.shieldArea = sample.shieldArea;
+        scenario.ablationEnergy = sample.ablationEnergy;
+        scenario.chuteArea = sample.chuteArea;
+        scenario.chuteDragCoefficient = sample.chuteDragCoefficient;
+        scenario.chuteDeployAltitude = sample.chuteDeployAltitude;
+        scenario.chuteMaxMassKg = sample.chuteMaxMassKg;
+        scenario.deltaTime = 0.1;
+        scenario.maxTime = 6000.0;
+        ScenarioResult result = RunReentryScenario(body, scenario);
+
+        const EnsembleOutcome &outcome = ensemble[i];
+        bool sameKind = (result.outcome == ScenarioOutcome::LandedSafely && outcome.kind == EnsembleOutcomeKind::LandedSafely) ||
+                        (result.outcome == ScenarioOutcome::Crashed && outcome.kind == EnsembleOutcomeKind::Crashed) ||
+                        (result.outcome == ScenarioOutcome::BurnedUp && outcome.kind == EnsembleOutcomeKind::BurnedUp);
+        mismatches += sameKind ? 0 : 1;
+        maxHeatError = std::max(maxHeatError, std::abs(outcome.peakHeatRate - result.peakHeatRate) / result.peakHeatRate);
+        maxImpactError = std::max(maxImpactError, std::abs(outcome.impactSpeed - result.impactSpeed) / result.impactSpeed);
+        maxShieldError = std::max(maxShieldError, std::abs(outcome.shieldRemainingKg - result.shieldRemainingKg));
+    }
+
+    constexpr double relativeTolerance = 1e-6, shieldTolerance = 1e-6; // kg
+    bool agrees = mismatches == 0 && maxHeatError <= relativeTolerance && maxImpactError <= relativeTolerance &&
+                  maxShieldError <= shieldTolerance;
+    std::cout << std::scientific << std::setprecision(2)
+              << "  [double vs RunReentryScenario] " << mismatches << " outcome mismatches, peak heat rel err "
+              << maxHeatError << ", impact speed rel err " << maxImpactError << ", shield abs err "
+              << maxShieldError << " kg\n"
+              << std::defaultfloat;
+    std::cout << (agrees ? "✅ Precision validation complete.\n"
+                         : "❌ Double ensemble disagrees with the scalar reentry path.\n");
+}
+
+// Scratch file for one demo run in the shared temp directory; the process id
+// keeps concurrent runs from overwriting or deleting each other's files
+std::string DemoScratchPath(const std::string &stem, const std::string &extension)
+{
+    std::string name = "physicssim_" + stem + "_" + std::to_string(::getpid()) + extension;
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Synthetic stand-in for an offline reanalysis export: each profile gets its
+// own density wave and jet-stream strength
+std::string WritePerturbationDataset(int profileCount)
+{
+    PerturbationGridHeader header;
+    header.profileCount = profileCount;
+    header.altitudeCount = 61; // 0..120 km
+    header.altitudeStep = 2000.0;
+    header.latitudeCount = 3;
+    header.latitudeStart = -1.0;
+    header.longitudeCount = 3;
+    header.longitudeStart = -1.0;
+    header.timeCount = 11; // 0..600 s
+    header.timeStep = 60.0;
+
+    std::vector<float> values;
+    values.reserve(header.ValueCount());
+    for (uint32_t p = 0; p < header.profileCount; ++p)
+        for (uint32_t t = 0; t < header.timeCount; ++t)
+            for (uint32_t la = 0; la < header.latitudeCount; ++la)
+                for (uint32_t lo = 0; lo < header.longitudeCount; ++lo)
+                    for (uint32_t a = 0; a < header.altitudeCount; ++a)
+                    {
+                        double altitudeKm = a * header.altitudeStep / 1000.0;
+                        double jet = (20.0 + 10.0 * p) * std::exp(-std::pow((altitudeKm - 11.0) / 5.0, 2.0));
+                        double wave = 0.15 * std::sin(altitudeKm / 8.0 + p + 0.01 * t);
+                        values.push_back(float(jet + 0.5 * lo));          // east wind
+                        values.push_back(float(0.3 * jet + 0.5 * la));    // north wind
+                        values.push_back(float(1.0 + wave * (0.5 + 0.1 * p))); // density scale
+                    }
+
+    std::string path = DemoScratchPath("perturbations", ".bin");
+    AtmospherePerturbation::WriteFile(path, header, values);
+    return path;
+}
+
+void SimulatePerturbedReentries(const std::string &bodyName, OrbitalBody *body)
+{
+    std::cout << "\n🌬️  Perturbed reentries on " << bodyName << "...\n";
+
+    AtmospherePerturbation field;
+    std::string path = WritePerturbationDataset(8);
+    if (!field.Open(path))
+    {
+        std::cout << "  ⚠️  Could not map perturbation dataset.\n";
+        std::filesystem::remove(path);
+        return;
+    }
+
+    ThrustModel dummyEngine(0.0, 0.0, 0.0);
+    std::cout << std::fixed << std::setprecision(1);
+
+    // Profile -1 is the unperturbed column
+    for (int profile = -1; profile < field.GetProfileCount(); ++profile)
+    {
+        Vessel capsule(100000.0, -7500.0, 5000.0, 0.0, 1.25, 5.0, body, dummyEngine);
+        if (profile >= 0)
+            capsule.SetAtmospherePerturbation(&field, profile, 0.0, 0.0);
+
+        double peakHeatRate = 0.0;
+        while (capsule.GetMissionTime() <= 600.0 && capsule.GetAltitude() > 0.0)
+        {
+            capsule.Update(0.1);
+            peakHeatRate = std::max(peakHeatRate, capsule.GetHeatRate());
+        }
+
+        std::cout << "  Profile " << std::setw(2) << profile
+                  << ": impact " << capsule.GetMissionTime() << " s at "
+                  << std::abs(capsule.GetVelocity()) << " m/s, peak heat "
+                  << peakHeatRate / 1000.0 << " kW/m²\n";
+    }
+
+    // Crafted headers: counts whose product wraps to 258 values (3 × the
+    // counts is 2^64 + 258), a zero step and a NaN step. All must be refused.
+    std::string craftedPath = path + ".crafted";
+    int refused = 0;
+    for (int tamper = 0; tamper < 3; ++tamper)
+    {
+        PerturbationGridHeader crafted;
+        crafted.profileCount = crafted.timeCount = crafted.latitudeCount = 1;
+        crafted.longitudeCount = crafted.altitudeCount = 2;
+        if (tamper == 0)
+        {
+            crafted.profileCount = 1297680179;
+            crafted.timeCount = 4597;
+            crafted.latitudeCount = 241;
+            crafted.longitudeCount = 47;
+            crafted.altitudeCount = 91;
+        }
+        else if (tamper == 1)
+            crafted.altitudeStep = 0.0;
+        else
+            crafted.timeStep = std::nan("");
+
+        std::vector<float> payload(258, 1.0f);
+        std::ofstream file(craftedPath, std::ios::binary);
+        file.write(reinterpret_cast<const char *>(&crafted), sizeof(crafted));
+        file.write(reinterpret_cast<const char *>(payload.data()), payload.size() * sizeof(float));
+        file.close();
+        AtmospherePerturbation probe;
+        refused += !probe.Open(craftedPath);
+    }
+    std::filesystem::remove(craftedPath);
+    std::filesystem::remove(path); // the mapping stays valid until field goes away
+    std::cout << "  Crafted headers refused: " << refused << " of 3\n";
+    std::cout << (refused == 3 ? "✅ Perturbed reentries complete.\n"
+                               : "❌ A crafted perturbation header was accepted.\n");
+}
+
+void SimulateParallelInTime(const std::string &bodyName, OrbitalBody *body)
+{
+    std::cout << "\n⏱️  Parallel-in-time reentry on " << bodyName << "...\n";
+
+    // Same capsule as SimulateReentry over the hypersonic part of the entry,
+    // refined at a 100x smaller step
+    ThrustModel dummyEngine(0.0, 0.0, 0.0);
+    Vessel capsule(100000.0, -7500.0, 5000.0, 0.0, 1.25, 5.0, body, dummyEngine);
+    ComponentArena components(1, 0);
+    capsule.AttachHeatShield(components, components.CreateHeatShield(HeatShield(250.0, 5.0, 2e6)));
+
+    PararealSettings settings;
+    settings.endTime = 50.0;
+    settings.sliceCount = 16;
+    settings.fineDeltaTime = 0.001;
+    settings.coarseDeltaTime = 0.1;
+    settings.tolerance = 1e-8;
+
+    auto serialStart = std::chrono::steady_clock::now();
+    VesselState serial = PropagateSerial(capsule, capsule.GetState(), settings.endTime, settings.fineDeltaTime);
+    double serialSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - serialStart).count();
+
+    PararealResult result = RunParareal(capsule, capsule.GetState(), settings);
+
+    std::cout << std::scientific << std::setprecision(2)
+              << "  " << result.boundaries.size() - 1 << " slices, coarse sweep "
+              << result.coarseSeconds << " s\n";
+    for (const PararealIteration &iteration : result.iterations)
+        std::cout << "  Iteration " << iteration.iteration
+                  << ": defect " << iteration.maxDefect
+                  << " (slice " << iteration.worstSlice << "), "
+                  << iteration.fineSlices << " fine slices, "
+                  << iteration.seconds << " s\n";
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "  " << (result.converged ? "Converged" : "Not converged")
+              << ": " << result.finalState.altitude << " m at "
+              << std::abs(result.finalState.velocity) << " m/s (serial "
+              << serial.altitude << " m at " << std::abs(serial.velocity) << " m/s)\n"
+              << "  Wall time " << result.totalSeconds << " s vs serial " << serialSeconds
+              << " s (" << serialSeconds / result.totalSeconds << "x)\n";
+    std::cout << "✅ Parallel-in-time reentry complete.\n";
+}
+
+void StudyTimestepConvergence(const std::string &bodyName, OrbitalBody *body)
+{
+    std::cout << "\n📐 Timestep convergence study on " << bodyName << "...\n";
+
+    // Same vehicles as SimulateReentry and SimulateLaunch
+    ConvergenceSettings settings;
+    settings.tolerance = 1e-3;
+    std::cout << RunConvergenceStudy(body, ReentryScenario(), settings).Format();
+    std::cout << RunConvergenceStudy(body, LaunchScenario(), settings).Format();
+
+    std::cout << "✅ Convergence study complete.\n";
+}
+
+// Error of `value` against `reference` in units of the reference's last place
+template <typename Real>
+double UlpError(Real value, Real reference)
+{
+    Real ulp = std::nextafter(std::abs(reference), Real(INFINITY)) - std::abs(reference);
+    return std::abs(double(value) - double(reference)) / double(ulp);
+}
+
+struct FastMathCase
+{
+    const char *name;
+    void (*batch)(const double *, double *, size_t);
+    double (*reference)(double);
+    double low, high;
+    double bound;
+    bool relative;
+};
+
+void TestFastMathAccuracy(OrbitalBody *body)
+{
+    using Clock = std::chrono::steady_clock;
+    std::cout << "\n🧮 Fast math kernels vs <cmath>...\n";
+
+    constexpr size_t sampleCount = 1 << 18;
+    std::mt19937_64 rng(36);
+    std::vector<double> in(sampleCount), out(sampleCount);
+    FastMath::SetMode(FastMath::Mode::Fast);
+
+    std::vector<FastMathCase> cases = {
+        {"exp", FastMath::Exp, [](double x) { return std::exp(x); }, -700.0, 700.0, FastMath::ExpMaxRelativeError, true},
+        {"sin", FastMath::Sin, [](double x) { return std::sin(x); }, -1e5, 1e5, FastMath::SinCosMaxAbsoluteError, false},
+        {"cos", FastMath::Cos, [](double x) { return std::cos(x); }, -1e5, 1e5, FastMath::SinCosMaxAbsoluteError, false},
+        {"asin", FastMath::Asin, [](double x) { return std::asin(x); }, -1.0, 1.0, FastMath::AsinAcosMaxAbsoluteError, false},
+        {"acos", FastMath::Acos, [](double x) { return std::acos(x); }, -1.0, 1.0, FastMath::AsinAcosMaxAbsoluteError, false}};
+
+    bool allPassed = true;
+    std::cout << std::scientific << std::setprecision(2);
+    for (const FastMathCase &test : cases)
+    {
+        std::uniform_real_distribution<double> range(test.low, test.high);
+        for (double &x : in)
+            x = range(rng);
+        test.batch(in.data(), out.data(), sampleCount);
+
+        double maxError = 0.0, maxUlp = 0.0;
+        bool batchMatchesScalar = true;
+        for (size_t i = 0; i < sampleCount; ++i)
+        {
+            double reference = test.reference(in[i]);
+            double error = std::abs(out[i] - reference);
+            if (test.relative)
+                error /= std::abs(reference);
+            maxError = std::max(maxError, error);
+            maxUlp = std::max(maxUlp, UlpError(out[i], reference));
+
+            double scalar = 0.0;
+            test.batch(&in[i], &scalar, 1);
+            batchMatchesScalar = batchMatchesScalar && scalar == out[i];
+        }
+
+        bool passed = maxError <= test.bound && batchMatchesScalar;
+        allPassed = allPassed && passed;
+        std::cout << "  " << std::left << std::setw(5) << test.name << std::right
+                  << " max " << (test.relative ? "rel" : "abs") << " error " << maxError
+                  << " (bound " << test.bound << "), max " << std::fixed << std::setprecision(1)
+                  << maxUlp << " ULP" << std::scientific << std::setprecision(2)
+                  << (passed ? "  PASS" : "  FAIL") << "\n";
+    }
+
+    // Pow over |y| <= 10, scalar kernel (the batch takes one exponent)
+    {
+        std::uniform_real_distribution<double> base(-3.0, 3.0), exponent(-10.0, 10.0);
+        double maxError = 0.0, maxUlp = 0.0;
+        for (size_t i = 0; i < sampleCount; ++i)
+        {
+            double x = std::pow(10.0, base(rng)), y = exponent(rng);
+            double reference = std::pow(x, y);
+            double value = FastMath::Pow(x, y);
+            maxError = std::max(maxError, std::abs(value - reference) / reference);
+            maxUlp = std::max(maxUlp, UlpError(value, reference));
+        }
+        bool passed = maxError <= FastMath::PowMaxRelativeError;
+        allPassed = allPassed && passed;
+        std::cout << "  pow   max rel error " << maxError << " (bound " << FastMath::PowMaxRelativeError
+                  << "), max " << std::fixed << std::setprecision(1) << maxUlp << " ULP"
+                  << std::scientific << std::setprecision(2) << (passed ? "  PASS" : "  FAIL") << "\n";
+    }
+
+    // Float kernels, as used by the ensemble's float force path
+    {
+        std::vector<float> inF(sampleCount), outF(sampleCount);
+        std::uniform_real_distribution<float> range(-80.0f, 80.0f);
+        for (float &x : inF)
+            x = range(rng);
+        FastMath::Exp(inF.data(), outF.data(), sampleCount);
+
+        double maxUlp = 0.0;
+        for (size_t i = 0; i < sampleCount; ++i)
+            maxUlp = std::max(maxUlp, UlpError(outF[i], std::exp(inF[i])));
+        bool passed = maxUlp <= FastMath::FloatMaxUlpError;
+        allPassed = allPassed && passed;
+        std::cout << "  expf  max " << std::fixed << std::setprecision(1) << maxUlp << " ULP (bound "
+                  << FastMath::FloatMaxUlpError << ")" << (passed ? "  PASS" : "  FAIL") << "\n";
+    }
+
+    // Batched throughput, the same inputs in both modes; best of three runs
+    // so a busy machine does not hide the difference
+    {
+        std::uniform_real_distribution<double> range(-50.0, 50.0);
+        std::vector<double> unit(sampleCount), positive(sampleCount);
+        for (size_t i = 0; i < sampleCount; ++i)
+        {
+            in[i] = range(rng);
+            unit[i] = in[i] / 50.0;
+            positive[i] = std::abs(in[i]) + 0.01;
+        }
+
+        struct ThroughputCase
+        {
+            const char *name;
+            std::function<void()> run;
+        };
+        std::vector<ThroughputCase> kernels = {
+            {"exp", [&] { FastMath::Exp(in.data(), out.data(), sampleCount); }},
+            {"sin", [&] { FastMath::Sin(in.data(), out.data(), sampleCount); }},
+            {"asin", [&] { FastMath::Asin(unit.data(), out.data(), sampleCount); }},
+            {"pow", [&] { FastMath::Pow(positive.data(), 5.2559, out.data(), sampleCount); }}};
+
+        double totals[2] = {0.0, 0.0};
+        std::cout << std::fixed << std::setprecision(2);
+        for (const ThroughputCase &kernel : kernels)
+        {
+            double seconds[2];
+            for (FastMath::Mode mode : {FastMath::Mode::Standard, FastMath::Mode::Fast})
+            {
+                FastMath::SetMode(mode);
+                seconds[int(mode)] = INFINITY;
+                for (int attempt = 0; attempt < 3; ++attempt)
+                {
+                    Clock::time_point start = Clock::now();
+                    for (int repeat = 0; repeat < 5; ++repeat)
+                        kernel.run();
+                    seconds[int(mode)] = std::min(seconds[int(mode)], std::chrono::duration<double>(Clock::now() - start).count());
+                }
+                totals[int(mode)] += seconds[int(mode)];
+            }
+            std::cout << "  Batched " << std::left << std::setw(5) << kernel.name << std::right
+                      << ": standard " << seconds[0] * 1e9 / (5.0 * sampleCount) << " ns, fast "
+                      << seconds[1] * 1e9 / (5.0 * sampleCount) << " ns per element ("
+                      << seconds[0] / seconds[1] << "x)\n";
+        }
+        FastMath::SetMode(FastMath::Mode::Fast);
+
+        bool faster = totals[0] >= 1.5 * totals[1];
+        allPassed = allPassed && faster;
+        std::cout << "  Overall " << totals[0] / totals[1] << "x (required 1.50x)"
+                  << (faster ? "  PASS" : "  FAIL") << "\n";
+    }
+
+    // Trajectory-level effect on the reference reentry: the kernels' errors
+    // must show up, and stay far below the model's own accuracy
+    constexpr double maxReentryRelativeChange = 1e-6;
+    ScenarioResult results[2];
+    for (FastMath::Mode mode : {FastMath::Mode::Standard, FastMath::Mode::Fast})
+    {
+        FastMath::SetMode(mode);
+        ReentryScenario scenario;
+        scenario.chuteArea = 500.0;
+        results[int(mode)] = RunReentryScenario(body, scenario);
+    }
+    FastMath::SetMode(FastMath::Mode::Standard);
+
+    double impactTimeChange = std::abs(results[1].impactTime - results[0].impactTime) / results[0].impactTime;
+    double impactSpeedChange = std::abs(results[1].impactSpeed - results[0].impactSpeed) / results[0].impactSpeed;
+    double peakHeatChange = std::abs(results[1].peakHeatRate - results[0].peakHeatRate) / results[0].peakHeatRate;
+    double largestChange = std::max({impactTimeChange, impactSpeedChange, peakHeatChange});
+    bool reentryInBound = largestChange > 0.0 && largestChange <= maxReentryRelativeChange;
+    allPassed = allPassed && reentryInBound;
+    std::cout << std::scientific << std::setprecision(2)
+              << "  Reentry fast vs standard (relative): impact time Δ " << impactTimeChange
+              << ", impact speed Δ " << impactSpeedChange << ", peak heat Δ " << peakHeatChange
+              << " (nonzero, bound " << maxReentryRelativeChange << ")"
+              << (reentryInBound ? "  PASS" : "  FAIL") << "\n";
+    std::cout << std::defaultfloat;
+    std::cout << (allPassed ? "✅ Every kernel within its accuracy contract, and faster than <cmath>.\n"
+                             : "❌ Fast math contract violated.\n");
+}
+
+// Plant model for flight-software testing: the SimulateLaunch rocket stepped
+// at a fixed wall-clock rate, flying whatever throttle and orientation the
+// controller last published
+PacingStats RunPacedPlant(OrbitalBody *body, ControlChannel &channel,
+                          const PacingSettings &pacing, double durationSeconds)
+{
+    LaunchScenario vehicle;
+    ThrustModel engine(vehicle.maxThrust, vehicle.vacuumISP, vehicle.seaLevelISP);
+    Vessel rocket(0.0, 0.0, vehicle.dryMassKg, vehicle.fuelMassKg,
+                  vehicle.dragCoefficient, vehicle.crossSectionArea, body, engine);
+
+    RealTimeScheduler scheduler(pacing);
+    const double deltaTime = scheduler.GetFrameDeltaTime();
+    ControlInputs inputs;
+    long inputUpdates = 0, maxInputAge = 0;
+    bool airborne = false;
+
+    PacingStats stats = scheduler.Run([&](long frame, double)
+                                      {
+        if (channel.PollInputs(inputs))
+        {
+            ++inputUpdates;
+            maxInputAge = std::max(maxInputAge, frame - long(inputs.telemetryFrame));
+            Vector3 orientation(inputs.orientationX, inputs.orientationY, inputs.orientationZ);
+            if (orientation.Length() > 0.0)
+                rocket.SetOrientationVector(orientation);
+        }
+        double throttle = std::clamp(inputs.throttle, 0.0, 1.0);
+        rocket.SetThrottle(throttle);
+        rocket.Update(deltaTime);
+        airborne = airborne || rocket.GetAltitude() > 0.0;
+
+        double speed = rocket.GetVelocity();
+        PlantTelemetry telemetry;
+        telemetry.frame = uint64_t(frame + 1);
+        telemetry.missionTime = rocket.GetMissionTime();
+        telemetry.altitude = rocket.GetAltitude();
+        telemetry.velocity = speed;
+        telemetry.fuelMass = rocket.GetFuelMass();
+        telemetry.dynamicPressure = 0.5 * rocket.GetLastAirDensity() * speed * speed;
+        telemetry.throttle = throttle;
+
+        bool done = rocket.GetMissionTime() >= durationSeconds ||
+                    (airborne && rocket.GetAltitude() <= 0.0) ||
+                    channel.ShutdownRequested();
+        telemetry.finished = done ? 1 : 0;
+        channel.PublishTelemetry(telemetry);
+        return !done; });
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "  Plant: " << rocket.GetAltitude() / 1000.0 << " km, " << rocket.GetVelocity()
+              << " m/s, fuel " << rocket.GetFuelMass() << " kg; " << inputUpdates
+              << " input updates, oldest input " << maxInputAge << " frames behind\n";
+    return stats;
+}
+
+// Stand-in flight software: full throttle except above a dynamic pressure
+// limit, where throttle backs off proportionally
+void RunStandInController(ControlChannel &channel, double maxDynamicPressure)
+{
+    PlantTelemetry telemetry;
+    long commands = 0;
+    while (!channel.ShutdownRequested())
+    {
+        if (!channel.PollTelemetry(telemetry))
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+        if (telemetry.finished)
+            break;
+
+        double excess = (telemetry.dynamicPressure - maxDynamicPressure) / maxDynamicPressure;
+        ControlInputs inputs;
+        inputs.throttle = std::clamp(1.0 - 4.0 * excess, 0.4, 1.0);
+        inputs.telemetryFrame = telemetry.frame;
+        channel.PublishInputs(inputs);
+        ++commands;
+    }
+    std::cout << "  Controller: " << commands << " commands sent\n";
+}
+
+void SimulatePacedPlant(const std::string &bodyName, OrbitalBody *body)
+{
+    std::cout << "\n⏱  Paced plant on " << bodyName << " (100 Hz at 20x real time, max-q controller)...\n";
+
+    std::string channelName = "/physicssim-demo-" + std::to_string(::getpid());
+    ControlChannel plantSide;
+    if (!plantSide.Create(channelName))
+    {
+        std::cout << "❌ Could not create shared memory channel " << channelName << "\n";
+        return;
+    }
+
+    std::thread controller([&]()
+                           {
+        ControlChannel controllerSide;
+        if (controllerSide.Open(channelName))
+            RunStandInController(controllerSide, 20000.0); });
+
+    PacingSettings pacing;
+    pacing.rateHz = 100.0;
+    pacing.speedFactor = 20.0;
+    PacingStats stats = RunPacedPlant(body, plantSide, pacing, 20.0);
+    plantSide.RequestShutdown();
+    controller.join();
+
+    std::cout << stats.Format();
+
+    // A segment too short for the layout must be refused, not mapped
+    std::string stubName = channelName + "-stub";
+    bool stubRefused = false;
+    int fd = ::shm_open(stubName.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd >= 0)
+    {
+        if (::ftruncate(fd, 8) == 0)
+        {
+            ControlChannel probe;
+            stubRefused = !probe.Open(stubName);
+        }
+        ::close(fd);
+        ::shm_unlink(stubName.c_str());
+    }
+    std::cout << "  Undersized segment " << (stubRefused ? "refused" : "accepted") << "\n";
+    std::cout << (stubRefused ? "✅ Paced run complete.\n" : "❌ An undersized control segment was accepted.\n");
+}
+
+int RunPlant(const std::string &channelName, double rateHz, double speedFactor, double durationSeconds)
+{
+    Atmosphere earthAtmo(101325.0, 288.15, 0.0065, 0.0289644);
+    OrbitalBody earth(5.972e24, 6.371e6, &earthAtmo);
+
+    ControlChannel channel;
+    if (!channel.Create(channelName))
+    {
+        std::cerr << "Could not create shared memory channel " << channelName << "\n";
+        return 1;
+    }
+
+    PacingSettings pacing;
+    pacing.rateHz = rateHz;
+    pacing.speedFactor = speedFactor;
+    std::cout << "🛰  Plant on " << channelName << " at " << rateHz << " Hz, " << speedFactor << "x real time\n";
+    PacingStats stats = RunPacedPlant(&earth, channel, pacing, durationSeconds);
+    channel.RequestShutdown();
+    std::cout << stats.Format();
+    return stats.deadlineMisses > 0 ? 2 : 0;
+}
+
+int RunController(const std::string &channelName, double maxDynamicPressure)
+{
+    // The plant creates the channel; give it a few seconds to come up
+    ControlChannel channel;
+    for (int attempt = 0; attempt < 50 && !channel.Open(channelName); ++attempt)
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if (!channel.IsOpen())
+    {
+        std::cerr << "No plant on " << channelName << "\n";
+        return 1;
+    }
+    RunStandInController(channel, maxDynamicPressure);
+    return 0;
+}
+
+// === Ephemerides ===
+// Mission time 0 is 2026-01-01 00:00 TT; fits cover the following 30 days
+constexpr double missionEpoch = 820497600.0; // s since J2000
+constexpr double ephemerisDays = 30.0;
+
+std::string EphemerisPath(const std::string &directory, const std::string &name)
+{
+    return (std::filesystem::path(directory) / ("physicssim_" + name + ".eph")).string();
+}
+
+// Per-user cache, not a fixed name in the shared temp directory that any
+// other user could plant a file under: $XDG_CACHE_HOME/physicssim, else
+// ~/.cache/physicssim, else the working directory
+std::string EphemerisCacheDirectory()
+{
+    std::filesystem::path directory;
+    if (const char *cache = std::getenv("XDG_CACHE_HOME"); cache && *cache)
+        directory = std::filesystem::path(cache) / "physicssim";
+    else if (const char *home = std::getenv("HOME"); home && *home)
+        directory = std::filesystem::path(home) / ".cache" / "physicssim";
+    else
+        return ".";
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    return error ? "." : directory.string();
+}
+
+// Offline step: fit the analytic Sun and Moon series and write the segments
+bool FitEphemerides(const std::string &directory, double epoch, double days)
+{
+    double end = epoch + days * 86400.0;
+    ChebyshevEphemeris sun = ChebyshevEphemeris::Fit(ApproximateSunPosition, epoch, end, 8.0 * 86400.0, 10);
+    ChebyshevEphemeris moon = ChebyshevEphemeris::Fit(ApproximateMoonPosition, epoch, end, 86400.0, 12);
+
+    // Formatted apart so the fit errors' precision doesn't stick to std::cout
+    std::ostringstream line;
+    line << "🌒 Fitted " << days << " days: Sun " << sun.GetSegmentCount() << " segments (max error "
+         << std::scientific << std::setprecision(2) << sun.GetFitError() << " m), Moon "
+         << moon.GetSegmentCount() << " segments (max error " << moon.GetFitError() << " m)\n";
+    std::cout << line.str();
+    return sun.Save(EphemerisPath(directory, "sun")) && moon.Save(EphemerisPath(directory, "moon"));
+}
+
+// Startup: load the fitted segments, refitting when they are absent or do
+// not span the whole mission window
+bool LoadEphemerides(ChebyshevEphemeris &sun, ChebyshevEphemeris &moon)
+{
+    std::string directory = EphemerisCacheDirectory();
+    double missionEnd = missionEpoch + ephemerisDays * 86400.0;
+    auto loadCovering = [&]()
+    {
+        return sun.Load(EphemerisPath(directory, "sun")) && moon.Load(EphemerisPath(directory, "moon")) &&
+               sun.Covers(missionEpoch, missionEnd) && moon.Covers(missionEpoch, missionEnd);
+    };
+
+    return loadCovering() || (FitEphemerides(directory, missionEpoch, ephemerisDays) && loadCovering());
+}
+
+// Vertical gravity breakdown and its effect on the reference reentry
+void CompareGravityModels(const std::string &bodyName, OrbitalBody *body, const Atmosphere *atmosphere)
+{
+    using Clock = std::chrono::steady_clock;
+    std::cout << "\n🌍 Gravity models on " << bodyName << "...\n";
+
+    OrbitalBody pointMass(body->GetGravitationalParameter() / 6.67430e-11, body->GetRadius(),
+                          const_cast<Atmosphere *>(atmosphere));
+
+    std::cout << std::fixed << std::setprecision(6);
+    for (double latitude : {0.0, 45.0, 90.0})
+        for (double altitude : {0.0, 400000.0})
+        {
+            double simple = pointMass.ComputeGravitationalAcceleration(altitude);
+            double full = body->ComputeGravitationalAcceleration(altitude, latitude, 0.0, 0.0);
+            std::cout << "  lat " << std::setw(4) << std::setprecision(0) << latitude << "°, "
+                      << std::setw(3) << altitude / 1000.0 << " km: point mass " << std::setprecision(6)
+                      << simple << " m/s², J2 + Sun + Moon " << full << " m/s² (Δ "
+                      << std::scientific << std::setprecision(2) << full - simple << ")\n"
+                      << std::fixed;
+        }
+
+    // Per-step cost of the lookups
+    constexpr int evaluations = 200000;
+    Clock::time_point start = Clock::now();
+    double sink = 0.0;
+    for (int i = 0; i < evaluations; ++i)
+        sink += body->ComputeGravitationalAcceleration(100000.0, 28.5, -80.6, i * 0.01);
+    double nanos = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / evaluations;
+    std::cout << std::setprecision(1) << "  Full gravity evaluation: " << nanos << " ns"
+              << (sink > 0.0 ? "" : " (?)") << "\n";
+
+    ReentryScenario scenario;
+    scenario.chuteArea = 500.0;
+    ScenarioResult simple = RunReentryScenario(&pointMass, scenario);
+    ScenarioResult full = RunReentryScenario(body, scenario);
+    std::cout << std::setprecision(3) << "  Reentry impact: point mass " << simple.impactTime << " s at "
+              << simple.impactSpeed << " m/s, full " << full.impactTime << " s at " << full.impactSpeed << " m/s\n";
+
+    // A damaged ephemeris file is refused before its coefficients are sized
+    std::string path = EphemerisPath(EphemerisCacheDirectory(), "probe_" + std::to_string(::getpid()));
+    int refused = 0;
+    if (ChebyshevEphemeris::Fit(ApproximateSunPosition, missionEpoch, missionEpoch + 16.0 * 86400.0, 8.0 * 86400.0, 10).Save(path))
+    {
+        std::ifstream saved(path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(saved)), std::istreambuf_iterator<char>());
+        saved.close();
+        for (int variant = 0; variant < 2; ++variant)
+        {
+            std::string damaged = bytes;
+            if (variant == 0)
+                damaged.resize(damaged.size() - sizeof(double)); // one coefficient short
+            else
+            {
+                uint32_t huge = 0xffffffffu;
+                std::memcpy(&damaged[offsetof(EphemerisFileHeader, segmentCount)], &huge, sizeof(huge));
+            }
+            std::ofstream(path, std::ios::binary).write(damaged.data(), damaged.size());
+            ChebyshevEphemeris probe;
+            refused += !probe.Load(path);
+        }
+        std::filesystem::remove(path);
+    }
+    std::cout << "  Damaged ephemerides refused: " << refused << " of 2\n";
+    std::cout << std::defaultfloat << (refused == 2 ? "✅ Gravity comparison complete.\n"
+                                                    : "❌ A damaged ephemeris file was accepted.\n");
+}
+
+// Archive a reentry sweep, then check the error bounds and scan one channel
+void ArchiveTrajectorySweep(const std::string &bodyName, OrbitalBody *body, int runCount)
+{
+    using Clock = std::chrono::steady_clock;
+    std::cout << "\n🗜  Archiving " << runCount << " reentry trajectories on " << bodyName << "...\n";
+
+    std::vector<ArchiveChannel> channels = TelemetryColumnsChannels();
+    constexpr size_t capacity = 8192;
+    std::vector<std::vector<double>> buffers(channels.size(), std::vector<double>(capacity));
+    TelemetryColumns columns;
+    double **targets[] = {&columns.time, &columns.altitude, &columns.velocity, &columns.airDensity,
+                          &columns.heatRate, &columns.surfaceTemperature, &columns.shieldMass};
+    for (size_t c = 0; c < channels.size(); ++c)
+        *targets[c] = buffers[c].data();
+    columns.capacity = capacity;
+
+    std::string path = DemoScratchPath("sweep", ".tla");
+    TelemetryArchiveWriter writer;
+    if (!writer.Open(path, channels))
+    {
+        std::cout << "  ⚠️  Could not create " << path << "\n";
+        return;
+    }
+
+    // Originals kept only to verify the decode below
+    std::vector<std::vector<std::vector<double>>> originals;
+    uint64_t csvBytes = 0;
+    double encodeSeconds = 0.0;
+    char field[64];
+    for (int run = 0; run < runCount; ++run)
+    {
+        ReentryScenario scenario;
+        scenario.velocity = -300.0 - 7200.0 * run / std::max(1, runCount - 1);
+        scenario.shieldMassKg = 150.0 + 100.0 * (run % 3);
+        RunReentryScenario(body, scenario, &columns);
+
+        Clock::time_point start = Clock::now();
+        writer.Append(uint64_t(run), columns);
+        encodeSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+        originals.emplace_back();
+        for (size_t c = 0; c < channels.size(); ++c)
+        {
+            originals.back().emplace_back(buffers[c].begin(), buffers[c].begin() + columns.count);
+            for (size_t i = 0; i < columns.count; ++i)
+                csvBytes += std::snprintf(field, sizeof(field), "%.2f,", buffers[c][i]);
+        }
+    }
+    writer.Close();
+
+    // === Full decode against the originals ===
+    TelemetryArchiveReader reader;
+    std::vector<double> maxError(channels.size(), 0.0);
+    std::vector<double> values;
+    bool decoded = reader.Open(path);
+    for (int run = 0; decoded && reader.NextRun(); ++run)
+        for (size_t c = 0; c < channels.size(); ++c)
+        {
+            decoded = decoded && reader.ReadChannel(int(c), values) && values.size() == originals[run][c].size();
+            for (size_t i = 0; decoded && i < values.size(); ++i)
+                maxError[c] = std::max(maxError[c], std::abs(values[i] - originals[run][c][i]));
+        }
+
+    // === Channel-selective scan ===
+    reader.Open(path);
+    int altitudeChannel = reader.FindChannel("altitude");
+    Clock::time_point start = Clock::now();
+    uint64_t scanned = 0;
+    double highest = 0.0;
+    while (reader.NextRun() && reader.ReadChannel(altitudeChannel, values))
+    {
+        scanned += values.size();
+        for (double altitude : values)
+            highest = std::max(highest, altitude);
+    }
+    double scanSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    bool withinBounds = decoded;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  Raw doubles: " << writer.GetRawBytes() / 1e6 << " MB, CSV (2 decimals): " << csvBytes / 1e6
+              << " MB, archive: " << writer.GetEncodedBytes() / 1e6 << " MB ("
+              << double(writer.GetRawBytes()) / writer.GetEncodedBytes() << "x vs raw, "
+              << double(csvBytes) / writer.GetEncodedBytes() << "x vs CSV)\n";
+    std::cout << "  Encode: " << writer.GetRawBytes() / 1e6 / encodeSeconds << " MB/s of raw telemetry\n";
+    for (size_t c = 0; c < channels.size(); ++c)
+    {
+        double bound = channels[c].quantum > 0.0 ? 0.5 * channels[c].quantum * (1.0 + 1e-9) + 1e-9 : 0.0;
+        bool ok = maxError[c] <= bound;
+        withinBounds = withinBounds && ok;
+        std::cout << "    " << std::left << std::setw(20) << channels[c].name << std::right << std::scientific
+                  << std::setprecision(2) << " max error " << maxError[c]
+                  << (channels[c].quantum > 0.0 ? " (quantum " : " (lossless") << std::defaultfloat;
+        if (channels[c].quantum > 0.0)
+            std::cout << channels[c].quantum;
+        std::cout << ")" << (ok ? "" : "  ❌") << "\n"
+                  << std::fixed;
+    }
+    std::cout << std::setprecision(1) << "  Altitude-only scan: " << scanned << " samples in "
+              << scanSeconds * 1000.0 << " ms (" << scanned * sizeof(double) / 1e6 / scanSeconds
+              << " MB/s decoded), highest " << highest << " m\n";
+
+    // === Corrupt copies: each must read as an error, not throw ===
+    std::ifstream original(path, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(original)), std::istreambuf_iterator<char>());
+    original.close();
+    size_t record = 12; // file magic and channel count, then each channel's name and quantum
+    for (const ArchiveChannel &channel : channels)
+        record += 10 + channel.name.size();
+    const size_t rowsField = record + 16, firstBlock = record + 24 + 8 * channels.size();
+
+    std::string corruptPath = path + ".corrupt";
+    int refused = 0;
+    for (int corruption = 0; corruption < 3; ++corruption)
+    {
+        std::vector<char> damaged = bytes;
+        if (corruption == 0)
+            damaged.resize(damaged.size() / 2); // truncated mid-archive
+        else if (corruption == 1)
+        {
+            uint64_t rows = uint64_t(1) << 62; // first run claims 2^62 rows
+            std::memcpy(&damaged[rowsField], &rows, sizeof(rows));
+        }
+        else
+            for (size_t i = firstBlock; i + 10 <= firstBlock + 200; i += 10) // huge varints in "time"
+            {
+                std::memset(&damaged[i], 0xff, 9);
+                damaged[i + 9] = 0x01;
+            }
+        std::ofstream(corruptPath, std::ios::binary).write(damaged.data(), damaged.size());
+
+        int runsRead = 0;
+        bool failed = false;
+        try
+        {
+            TelemetryArchiveReader corrupt;
+            corrupt.Open(corruptPath);
+            while (!failed && corrupt.NextRun())
+            {
+                for (size_t c = 0; c < channels.size(); ++c)
+                    failed = failed || !corrupt.ReadChannel(int(c), values);
+                runsRead += !failed;
+            }
+        }
+        catch (const std::exception &)
+        {
+            runsRead = runCount; // threw instead of refusing
+        }
+        refused += runsRead < runCount;
+    }
+    std::filesystem::remove(corruptPath);
+    withinBounds = withinBounds && refused == 3;
+    std::cout << "  Corrupt archives read as errors: " << refused << " of 3\n";
+
+    std::cout << (withinBounds ? "✅ Archive round trip within bounds.\n" : "❌ Archive round trip out of bounds.\n");
+    std::filesystem::remove(path);
+}
+
+void ScreenWhatIfScenarios(const std::string &bodyName, OrbitalBody *body, int queryCount)
+{
+    using Clock = std::chrono::steady_clock;
+    std::cout << "\n🔮 Screening " << queryCount << " what-if reentries on " << bodyName << " through a surrogate cache...\n";
+
+    SurrogateCache cache(reentrySurrogateParameterCount, reentrySurrogateOutputCount, ReentrySurrogateSettings());
+    double simulateSeconds = 0.0;
+    auto simulate = [&](const std::vector<double> &parameters)
+    {
+        Clock::time_point start = Clock::now();
+        ScenarioResult result = RunReentryScenario(body, ReentryScenarioFromParameters(parameters));
+        simulateSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+        return ReentrySurrogateOutputs(result);
+    };
+
+    // No parachute: its deploy message would flood the console
+    std::mt19937 rng(40);
+    std::uniform_real_distribution<double> velocity(-7500.0, -300.0), shield(0.0, 400.0), dryMass(2000.0, 8000.0);
+    auto draw = [&]() { return std::vector<double>{velocity(rng), shield(rng), dryMass(rng), 0.0}; };
+
+    int counts[3] = {};
+    double screenSeconds = 0.0;
+    std::vector<std::vector<double>> predictedQueries;
+    std::vector<SurrogateAnswer> predictedAnswers;
+    for (int i = 0; i < queryCount; ++i)
+    {
+        std::vector<double> query = draw();
+        Clock::time_point start = Clock::now();
+        SurrogateAnswer answer = cache.Query(query, simulate);
+        if (answer.source != SurrogateSource::Simulated)
+            screenSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+        ++counts[int(answer.source)];
+        if (answer.source == SurrogateSource::Predicted && predictedQueries.size() < 200)
+        {
+            predictedQueries.push_back(query);
+            predictedAnswers.push_back(answer);
+        }
+    }
+    int screened = counts[int(SurrogateSource::Exact)] + counts[int(SurrogateSource::Predicted)];
+
+    // === Surrogate answers against the simulator ===
+    // Outcome flags count as wrong when rounding disagrees; the rest report
+    // the worst error and how often it exceeded the claimed uncertainty
+    const char *names[] = {"landed", "burned up", "impact speed", "peak heat", "shield left"};
+    std::vector<double> worst(reentrySurrogateOutputCount, 0.0);
+    std::vector<int> outside(reentrySurrogateOutputCount, 0);
+    int wrongOutcome = 0;
+    for (size_t i = 0; i < predictedQueries.size(); ++i)
+    {
+        std::vector<double> truth = ReentrySurrogateOutputs(
+            RunReentryScenario(body, ReentryScenarioFromParameters(predictedQueries[i])));
+        const SurrogateAnswer &answer = predictedAnswers[i];
+        bool outcomeWrong = false;
+        for (size_t k = 0; k < truth.size(); ++k)
+        {
+            double error = std::abs(answer.outputs[k] - truth[k]);
+            worst[k] = std::max(worst[k], error);
+            outside[k] += error > 3.0 * answer.uncertainty[k] + 1e-9;
+            if (k < 2)
+                outcomeWrong = outcomeWrong || std::round(answer.outputs[k]) != truth[k];
+        }
+        wrongOutcome += outcomeWrong;
+    }
+
+    // === Persistence ===
+    std::string path = DemoScratchPath("surrogate", ".bin");
+    SurrogateCache reloaded(reentrySurrogateParameterCount, reentrySurrogateOutputCount, ReentrySurrogateSettings());
+    bool persisted = cache.Save(path) && reloaded.Load(path) && reloaded.GetSampleCount() == cache.GetSampleCount();
+    for (size_t i = 0; persisted && i < predictedQueries.size(); ++i)
+        persisted = reloaded.Predict(predictedQueries[i]).outputs == cache.Predict(predictedQueries[i]).outputs;
+
+    // === Hostile input: a huge sample count, a NaN parameter ===
+    int refused = 0;
+    {
+        std::ifstream saved(path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(saved)), std::istreambuf_iterator<char>());
+        constexpr size_t sampleCountField = 16, firstParameter = 24; // after the magic and both counts
+        for (int variant = 0; variant < 2 && bytes.size() >= firstParameter + sizeof(double); ++variant)
+        {
+            std::string damaged = bytes;
+            if (variant == 0)
+            {
+                uint64_t huge = uint64_t(1) << 60;
+                std::memcpy(&damaged[sampleCountField], &huge, sizeof(huge));
+            }
+            else
+            {
+                double nan = NAN;
+                std::memcpy(&damaged[firstParameter], &nan, sizeof(nan));
+            }
+            std::ofstream(path, std::ios::binary).write(damaged.data(), damaged.size());
+            SurrogateCache probe(reentrySurrogateParameterCount, reentrySurrogateOutputCount, ReentrySurrogateSettings());
+            refused += !probe.Load(path);
+        }
+    }
+    std::filesystem::remove(path);
+    std::vector<double> nanQuery = predictedQueries.empty() ? std::vector<double>(reentrySurrogateParameterCount, 0.0)
+                                                            : predictedQueries.front();
+    nanQuery[0] = NAN;
+    size_t samplesBefore = cache.GetSampleCount();
+    cache.Insert(nanQuery, std::vector<double>(reentrySurrogateOutputCount, 0.0));
+    refused += cache.GetSampleCount() == samplesBefore;
+    refused += std::isinf(cache.Predict(nanQuery).uncertainty[0]);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  " << counts[int(SurrogateSource::Exact)] << " exact, " << counts[int(SurrogateSource::Predicted)]
+              << " predicted, " << counts[int(SurrogateSource::Simulated)] << " simulated; "
+              << cache.GetSampleCount() << " samples in " << cache.GetCellCount() << " cells\n";
+    std::cout << "  Cache answers: " << screenSeconds * 1e6 / std::max(1, screened)
+              << " µs each, simulations " << simulateSeconds * 1e3 / std::max(1, counts[int(SurrogateSource::Simulated)])
+              << " ms each\n";
+    std::cout << "  Checked " << predictedQueries.size() << " predictions against the simulator, "
+              << wrongOutcome << " with the wrong outcome\n";
+    for (size_t k = 2; k < reentrySurrogateOutputCount; ++k)
+        std::cout << "    " << std::left << std::setw(13) << names[k] << std::right << " worst error "
+                  << std::setprecision(2) << worst[k] << ", " << outside[k] << " beyond 3x the stated uncertainty\n";
+    std::cout << "  Refused " << refused << " of 4 corrupt files and non-finite parameters\n";
+    std::cout << (!persisted      ? "❌ Surrogate cache changed across save/load.\n"
+                  : refused != 4 ? "❌ Surrogate cache accepted a corrupt file or non-finite parameters.\n"
+                                 : "✅ Surrogate cache survives a save/load round trip.\n");
+}
+
+void MonitorSweep(const std::string &bodyName, OrbitalBody *body, int trajectoryCount)
+{
+    using Clock = std::chrono::steady_clock;
+    int threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::cout << "\n📈 Sweeping " << trajectoryCount << " reentries on " << bodyName << " across " << threadCount
+              << " threads with live metrics...\n";
+
+    // The registry is process-wide and earlier demos report into it too, so
+    // the sweep's own counts are differences against this baseline
+    MetricsRegistry &registry = MetricsRegistry::Global();
+    const char *outcomeLabels[] = {"in_flight", "landed_safely", "crashed", "burned_up"};
+    auto readSweepCounters = [&]()
+    {
+        std::vector<uint64_t> values = {registry.ReadCounter("physicssim_steps_total")};
+        for (const char *label : outcomeLabels)
+            values.push_back(registry.ReadCounter(std::string("physicssim_trajectories_total{outcome=\"") + label + "\"}"));
+        return values;
+    };
+    std::vector<uint64_t> before = readSweepCounters();
+    std::atomic<int> next(0);
+    int gauge = registry.AddGauge("physicssim_sweep_remaining", "Trajectories of the current sweep not yet started.", [&]()
+                                  { return double(std::max(0, trajectoryCount - next.load())); });
+
+    std::string path = DemoScratchPath("metrics", ".prom");
+    MetricsExporter exporter(registry, path, 0.05);
+    if (!exporter.Start())
+    {
+        std::cout << "  ⚠️  Could not write " << path << "\n";
+        registry.RemoveGauge(gauge);
+        return;
+    }
+
+    Clock::time_point start = Clock::now();
+    auto worker = [&]()
+    {
+        for (int i = next++; i < trajectoryCount; i = next++)
+        {
+            ReentryScenario scenario;
+            scenario.velocity = -300.0 - 7200.0 * (i % 97) / 96.0;
+            scenario.shieldMassKg = 5.0 * (i % 61);
+            scenario.dryMassKg = 2000.0 + 60.0 * (i % 101);
+            RunReentryScenario(body, scenario);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < threadCount; ++t)
+        threads.emplace_back(worker);
+    worker();
+    for (std::thread &thread : threads)
+        thread.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    registry.RemoveGauge(gauge);
+    exporter.Stop();
+    std::vector<uint64_t> after = readSweepCounters();
+    uint64_t steps = after[0] - before[0];
+    uint64_t trajectories = 0;
+    for (size_t i = 1; i < after.size(); ++i)
+        trajectories += after[i] - before[i];
+
+    // === Cost of one trajectory's updates ===
+    MetricCounter counter = registry.AddCounter("physicssim_overhead_probe_total", "Updates made by the overhead probe.");
+    MetricHistogram histogram = registry.AddHistogram("physicssim_overhead_probe_seconds", "Values observed by the overhead probe.",
+                                                      MetricsRegistry::ExponentialBuckets(1e-5, 2.0, 22));
+    constexpr int probeCount = 1000000;
+    Clock::time_point probeStart = Clock::now();
+    for (int i = 0; i < probeCount; ++i)
+    {
+        counter.Add(100);
+        counter.Add();
+        histogram.Observe(1e-4 * (i & 1023));
+    }
+    double probeNanos = std::chrono::duration<double, std::nano>(Clock::now() - probeStart).count() / probeCount;
+    double trajectoryNanos = seconds * 1e9 * threadCount / trajectoryCount;
+
+    // === Short-lived threads hand their shards back ===
+    constexpr int shortThreads = 64;
+    MetricsRegistry scratch;
+    MetricCounter exits = scratch.AddCounter("physicssim_probe_threads_total", "Short-lived probe threads.");
+    for (int t = 0; t < shortThreads; ++t)
+        std::thread([&]()
+                    { exits.Add(); })
+            .join();
+    bool shardsReused = scratch.GetShardCount() == 1 &&
+                        scratch.ReadCounter("physicssim_probe_threads_total") == uint64_t(shortThreads);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  " << steps << " steps in " << seconds * 1000.0 << " ms (" << steps / seconds / 1e6
+              << " M steps/s), " << exporter.GetWriteCount() << " snapshots written to " << path << "\n";
+    std::cout << std::setprecision(4) << "  Metric updates per trajectory: " << probeNanos << " ns, "
+              << 100.0 * probeNanos / trajectoryNanos << " % of a trajectory's wall time\n";
+
+    std::cout << "  This sweep:";
+    for (size_t i = 0; i < std::size(outcomeLabels); ++i)
+        std::cout << " " << outcomeLabels[i] << " " << after[i + 1] - before[i + 1] << (i + 1 < std::size(outcomeLabels) ? "," : "\n");
+    std::cout << "  Process totals in the final snapshot: " << after[0] << " steps\n";
+    std::filesystem::remove(path);
+
+    std::cout << (trajectories == uint64_t(trajectoryCount)
+                      ? "✅ Sweep counters account for every trajectory.\n"
+                      : "❌ Sweep counters do not add up to the trajectory count.\n");
+    std::cout << (shardsReused
+                      ? "✅ " + std::to_string(shortThreads) + " short-lived threads shared one recycled shard, counts kept.\n"
+                      : "❌ Shards of exited threads were not recycled.\n");
+}
+
+void PublishSweepEvents(const std::string &bodyName, OrbitalBody *body, const StatsSink &stats, int trajectoryCount)
+{
+    int threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::cout << "\n📣 Sweeping " << trajectoryCount << " thin-shield reentries on " << bodyName << " across "
+              << threadCount << " threads through the event bus...\n";
+
+    EventBus &events = EventBus::Global();
+    events.Flush();
+    uint64_t before[simEventTypeCount];
+    for (int i = 0; i < simEventTypeCount; ++i)
+        before[i] = stats.GetCount(SimEventType(i));
+    uint64_t droppedBefore = events.GetDroppedCount();
+
+    // Impacts, burnups and shield depletions go to the file and
+    // statistics sinks; nothing here is followed on the console
+    std::atomic<int> next(0);
+    auto worker = [&]()
+    {
+        for (int i = next++; i < trajectoryCount; i = next++)
+        {
+            ReentryScenario scenario;
+            scenario.velocity = -3000.0 - 4500.0 * (i % 89) / 88.0;
+            scenario.shieldMassKg = 2.0 * (i % 53);
+            RunReentryScenario(body, scenario);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < threadCount; ++t)
+        threads.emplace_back(worker);
+    worker();
+    for (std::thread &thread : threads)
+        thread.join();
+    events.Flush();
+
+    uint64_t impacts = stats.GetCount(SimEventType::Impact) - before[int(SimEventType::Impact)];
+    uint64_t burnups = stats.GetCount(SimEventType::BurnedUp) - before[int(SimEventType::BurnedUp)];
+    uint64_t depleted = stats.GetCount(SimEventType::ShieldDepleted) - before[int(SimEventType::ShieldDepleted)];
+    uint64_t dropped = events.GetDroppedCount() - droppedBefore;
+    std::cout << "  " << impacts << " impacts, " << burnups << " burnups, " << depleted << " shield depletions, "
+              << dropped << " dropped\n";
+    std::cout << "  Whole run so far: " << stats.Format() << "\n";
+    std::cout << (impacts + burnups == uint64_t(trajectoryCount) && dropped == 0
+                      ? "✅ One outcome event per trajectory.\n"
+                      : "❌ Outcome events missing.\n");
+
+    // === Short-lived publishers hand their rings back ===
+    constexpr int shortThreads = 64;
+    StatsSink probeStats;
+    EventBus probe;
+    probe.AddSink(&probeStats);
+    probe.Start();
+    for (int t = 0; t < shortThreads; ++t)
+    {
+        std::thread([&]()
+                    { probe.Publish(SimEvent{SimEventType::Apex, uint64_t(t), 0.0, 0.0, 0.0, 0}); })
+            .join();
+        probe.Flush();
+    }
+    probe.Stop();
+    std::cout << (probe.GetQueueCount() == 1 && probeStats.GetTotal() == uint64_t(shortThreads)
+                      ? "✅ " + std::to_string(shortThreads) + " short-lived publishers shared one recycled ring, no events lost.\n"
+                      : "❌ Rings of exited publishers were not recycled.\n");
+}
+
+// Earth as in main, without the Sun and Moon, which workers would have to load
+SweepSpec EarthSweepSpec(uint64_t sampleCount)
 {
+    SweepSpec spec;
+    spec.sampleCount = sampleCount;
+    spec.blockSize = 64;
+    spec.seed = 43;
+    spec.chuteAreaMax = 400.0;
+    spec.j2 = 1.08263e-3;
+    spec.rotationRate = 7.2921159e-5;
+    return spec;
+}
+
+// Worker process: `--sweep-worker [--crash-once marker] directory`. With a
+// marker, the first worker to create it kills itself inside its first
+// block, to exercise the retry path.
+int RunSweepWorker(const std::string &directory, const std::string &crashMarker)
+{
+    ShardedSweep sweep(directory);
+    if (!sweep.Open())
+        return 1;
+
+    int done = sweep.Work(-1, [&](uint64_t)
+                          {
+                              if (crashMarker.empty())
+                                  return;
+                              int fd = ::open(crashMarker.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0644);
+                              if (fd >= 0)
+                                  ::kill(::getpid(), SIGKILL); });
+    return done < 0 ? 1 : 0;
+}
+
+int RunSweep(const std::string &directory, int workerCount, uint64_t sampleCount)
+{
+    ShardedSweep sweep(directory);
+    if (!sweep.Create(EarthSweepSpec(sampleCount)))
+    {
+        std::cerr << "Could not create " << directory << " (or it holds a different sweep)\n";
+        return 1;
+    }
+
+    std::cout << "🧮 Sweeping " << sampleCount << " reentries in " << sweep.GetBlockCount() << " blocks with "
+              << workerCount << " workers; more can join with --sweep-worker " << directory << "\n";
+    bool complete = sweep.RunLocal({"/proc/self/exe", "--sweep-worker"}, workerCount, 3);
+    const SweepProgress &progress = sweep.GetProgress();
+    SweepAggregate total;
+    if (!complete || !sweep.Merge(total))
+    {
+        std::cerr << progress.completed << " of " << progress.blocks << " blocks done, " << progress.failed
+                  << " failed; rerun to retry\n";
+        return 1;
+    }
+    std::cout << "  " << total.Format() << "\n";
+    return 0;
+}
+
+void ShardSweepAcrossProcesses(int sampleCount)
+{
+    using Clock = std::chrono::steady_clock;
+    std::cout << "\n🧮 Sharded sweep of " << sampleCount << " reentries across worker processes...\n";
+
+    std::filesystem::path root = std::filesystem::temp_directory_path() / ("physicssim_sweep_" + std::to_string(::getpid()));
+    std::filesystem::remove_all(root);
+    SweepSpec spec = EarthSweepSpec(sampleCount);
+
+    struct Run
+    {
+        const char *label;
+        SweepAggregate total;
+        bool merged = false;
+        double seconds = 0.0;
+    };
+    std::vector<Run> runs(3);
+
+    // === Reference: every block in this process ===
+    {
+        Clock::time_point start = Clock::now();
+        ShardedSweep sweep((root / "serial").string());
+        runs[0].label = "in-process, 1 shard";
+        runs[0].merged = sweep.Create(spec) && sweep.Work() >= 0 && sweep.Merge(runs[0].total);
+        runs[0].seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // === 4 worker processes, one killed mid-block ===
+    {
+        Clock::time_point start = Clock::now();
+        ShardedSweep sweep((root / "workers").string());
+        std::string marker = (root / "crashed").string();
+        runs[1].label = "4 workers, 1 killed";
+        runs[1].merged = sweep.Create(spec) &&
+                         sweep.RunLocal({"/proc/self/exe", "--sweep-worker", "--crash-once", marker}, 4, 3) &&
+                         sweep.Merge(runs[1].total);
+        runs[1].seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        const SweepProgress &progress = sweep.GetProgress();
+        std::cout << "  4 workers: " << progress.workersStarted << " started, " << progress.workerFailures
+                  << " failed and retried, " << progress.completed << "/" << progress.blocks << " blocks\n";
+    }
+
+    // === Resume: 3 blocks checkpointed here, block 3 given up on, the rest by 2 workers ===
+    {
+        Clock::time_point start = Clock::now();
+        ShardedSweep sweep((root / "resumed").string());
+        runs[2].label = "3 blocks here, 2 workers";
+        runs[2].merged = sweep.Create(spec) && sweep.Work(3) == 3 &&
+                         std::ofstream(root / "resumed" / "block-000003.failed").put('3') &&
+                         ShardedSweep((root / "resumed").string()).Create(spec) &&
+                         sweep.RunLocal({"/proc/self/exe", "--sweep-worker"}, 2, 3) && sweep.Merge(runs[2].total);
+        runs[2].seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+    std::filesystem::remove_all(root);
+
+    bool identical = true;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const Run &run : runs)
+    {
+        bool same = run.merged && std::memcmp(&run.total, &runs[0].total, sizeof(SweepAggregate)) == 0;
+        identical = identical && same;
+        std::cout << "  " << std::left << std::setw(26) << run.label << std::right << run.seconds * 1000.0 << " ms, "
+                  << (run.merged ? (same ? "bit-identical" : "DIFFERENT") : "incomplete") << "\n";
+    }
+    std::cout << std::defaultfloat << "  " << runs[0].total.Format() << "\n";
+    std::cout << (identical ? "✅ Merged aggregates identical across shard layouts.\n"
+                            : "❌ Merged aggregates depend on the shard layout.\n");
+}
+
+// Chute opening of TestReentryOutcomes at coarse steps, against a fine-step
+// reference. The default integrator takes drag and chute in closed form, so
+// its descent must stay monotone at any step; the explicit ones are shown
+// for contrast.
+void TestDragStability(OrbitalBody *body)
+{
+    std::cout << "\n🪂 Drag stability through chute inflation on Earth...\n";
+
+    ReentryScenario scenario;
+    scenario.chuteArea = 500.0;
+    scenario.deltaTime = 0.001;
+    ScenarioResult reference = RunReentryScenario(body, scenario);
+    std::cout << std::fixed << std::setprecision(3) << "  Reference (dt 0.001 s): impact " << reference.impactTime
+              << " s at " << reference.impactSpeed << " m/s\n";
+
+    const IntegrationMethod methods[] = {IntegrationMethod::SemiImplicitEuler,
+                                         IntegrationMethod::ExplicitEuler,
+                                         IntegrationMethod::RungeKutta4};
+    const double steps[] = {1.0, 0.5, 0.2, 0.1, 0.05, 0.01};
+
+    // Impact time also carries where in a step the chute triggered, which is
+    // not monotone in dt; impact speed isolates the descent itself
+    bool stable = true;
+    bool converging = true;
+    std::cout << "    method                  dt    impact err s   speed err m/s   after deploy\n";
+    for (IntegrationMethod method : methods)
+    {
+        double previousError = INFINITY;
+        for (double deltaTime : steps)
+        {
+            scenario.deltaTime = deltaTime;
+            scenario.integrationMethod = method;
+            size_t rows = size_t(scenario.maxTime / deltaTime) + 2;
+            std::vector<double> altitude(rows), velocity(rows);
+            TelemetryColumns columns;
+            columns.altitude = altitude.data();
+            columns.velocity = velocity.data();
+            columns.capacity = rows;
+            ScenarioResult result = RunReentryScenario(body, scenario, &columns);
+
+            // Once below the deploy altitude the capsule only ever slows toward
+            // terminal velocity, which itself shrinks as the air thickens
+            bool flipped = false;
+            bool monotone = true;
+            for (size_t i = 1; i < columns.count; ++i)
+            {
+                if (altitude[i - 1] > scenario.chuteDeployAltitude)
+                    continue;
+                flipped = flipped || velocity[i] > 0.0;
+                monotone = monotone && std::abs(velocity[i]) <= std::abs(velocity[i - 1]) * (1.0 + 1e-12);
+            }
+
+            double timeError = std::abs(result.impactTime - reference.impactTime);
+            double speedError = std::abs(result.impactSpeed - reference.impactSpeed);
+            if (method == IntegrationMethod::SemiImplicitEuler)
+            {
+                stable = stable && monotone && !flipped && result.outcome == ScenarioOutcome::LandedSafely;
+                converging = converging && speedError <= previousError;
+                previousError = speedError;
+            }
+            std::cout << "    " << std::left << std::setw(20) << ToString(method) << std::right
+                      << std::setw(6) << std::setprecision(2) << deltaTime << std::scientific << std::setprecision(2)
+                      << std::setw(16) << timeError << std::setw(16) << speedError << std::fixed << "   "
+                      << (flipped ? "velocity flips" : monotone ? "monotone" : "oscillates") << "\n";
+        }
+    }
+
+    std::cout << std::defaultfloat;
+    std::cout << (stable && converging ? "✅ Closed-form drag is monotone at every step and converges.\n"
+                                       : "❌ Closed-form drag lost stability or convergence.\n");
+}
+
+// Coarse translation steps with the fast subsystems sub-stepped, against
+// single-rate runs at either step and a fine-step reference
+void CompareMultiRateIntegration(const std::string &bodyName, OrbitalBody *body)
+{
+    using Clock = std::chrono::steady_clock;
+    std::cout << "\n⏱  Multi-rate integration on " << bodyName << "...\n";
+
+    struct Variant
+    {
+        const char *label;
+        IntegrationMethod method;
+        double deltaTime;
+        MultiRateSettings multiRate;
+    };
+    MultiRateSettings reentryRates;
+    reentryRates.translationTolerance = 0.5;
+    reentryRates.chuteStep = 0.005;
+    reentryRates.thermalTolerance = 2.0;
+    MultiRateSettings launchRates;
+    launchRates.translationTolerance = 0.5;
+    launchRates.engineStep = 0.005;
+
+    auto report = [](const char *label, double seconds, const std::vector<double> &errors)
+    {
+        std::cout << "    " << std::left << std::setw(42) << label << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(9) << seconds * 1000.0 << " ms" << std::scientific;
+        for (double error : errors)
+            std::cout << std::setw(12) << error;
+        std::cout << std::defaultfloat << "\n";
+    };
+
+    // === Chute reentry: deploy trigger and shield ablation ===
+    ReentryScenario reentry;
+    reentry.chuteArea = 500.0;
+    reentry.deltaTime = 0.001;
+    ScenarioResult reference = RunReentryScenario(body, reentry);
+
+    std::cout << "  Reentry with chute, errors vs dt 0.001 s:               impact s  speed m/s   shield kg\n";
+    std::vector<Variant> reentryVariants = {
+        {"single-rate dt 0.5", IntegrationMethod::SemiImplicitEuler, 0.5, {}},
+        {"single-rate dt 0.005", IntegrationMethod::SemiImplicitEuler, 0.005, {}},
+        {"multi-rate dt 0.5, uniform", IntegrationMethod::MultiRate, 0.5, {}},
+        {"multi-rate dt 0.5, adaptive+chute+thermal", IntegrationMethod::MultiRate, 0.5, reentryRates}};
+    std::vector<std::vector<double>> reentryErrors;
+    for (const Variant &variant : reentryVariants)
+    {
+        reentry.deltaTime = variant.deltaTime;
+        reentry.integrationMethod = variant.method;
+        reentry.multiRate = variant.multiRate;
+        Clock::time_point start = Clock::now();
+        ScenarioResult result = RunReentryScenario(body, reentry);
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        reentryErrors.push_back({std::abs(result.impactTime - reference.impactTime),
+                                 std::abs(result.impactSpeed - reference.impactSpeed),
+                                 std::abs(result.shieldRemainingKg - reference.shieldRemainingKg)});
+        report(variant.label, seconds, reentryErrors.back());
+    }
+
+    // === Launch: mass and back-pressure change through each step ===
+    LaunchScenario launch;
+    launch.deltaTime = 0.001;
+    ScenarioResult launchReference = RunLaunchScenario(body, launch);
+
+    std::cout << "  Launch, errors vs dt 0.001 s:                             apex m\n";
+    std::vector<Variant> launchVariants = {
+        {"single-rate dt 0.5", IntegrationMethod::SemiImplicitEuler, 0.5, {}},
+        {"single-rate dt 0.005", IntegrationMethod::SemiImplicitEuler, 0.005, {}},
+        {"multi-rate dt 0.5, adaptive+engine", IntegrationMethod::MultiRate, 0.5, launchRates}};
+    std::vector<double> apexErrors;
+    for (const Variant &variant : launchVariants)
+    {
+        launch.deltaTime = variant.deltaTime;
+        launch.integrationMethod = variant.method;
+        launch.multiRate = variant.multiRate;
+        Clock::time_point start = Clock::now();
+        ScenarioResult result = RunLaunchScenario(body, launch);
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        apexErrors.push_back(std::abs(result.apexAltitude - launchReference.apexAltitude));
+        report(variant.label, seconds, {apexErrors.back()});
+    }
+
+    // Sub-stepping only the fast subsystems should recover most of what the
+    // uniform fine step gains over the coarse one
+    bool better = reentryErrors[3][0] < reentryErrors[0][0] && reentryErrors[3][2] <= reentryErrors[0][2] &&
+                  apexErrors[2] < apexErrors[0];
+    std::cout << (better ? "✅ Multi-rate sub-stepping beats the coarse single rate.\n"
+                         : "❌ Multi-rate sub-stepping did not improve on the coarse single rate.\n");
+}
+
+int RunService(const std::string &socketPath)
+{
+    ps_atmosphere_params earthAtmo = {101325.0, 288.15, 0.0065, 0.0289644};
+    ps_body *earth = ps_body_create(5.972e24, 6.371e6, &earthAtmo);
+
+    ServiceSettings settings;
+    settings.socketPath = socketPath;
+    SimulationService service(earth, settings);
+    if (!service.Start())
+    {
+        std::cerr << "Could not listen on " << socketPath << "\n";
+        ps_body_destroy(earth);
+        return 1;
+    }
+
+    // Scrapeable alongside the socket, e.g. by a textfile collector
+    MetricsExporter exporter(MetricsRegistry::Global(), socketPath + ".prom", 1.0);
+    exporter.Start();
+
+    std::cout << "🛰  Serving reentry requests on " << socketPath << " (metrics in " << socketPath << ".prom)\n";
+    service.Wait();
+    service.Stop();
+    exporter.Stop();
+
+    ServiceStats stats = service.GetStats();
+    std::cout << "✅ Service stopped after " << stats.requests << " requests in "
+              << stats.batches << " batches (p50 " << stats.p50LatencyMicros
+              << " µs, p99 " << stats.p99LatencyMicros << " µs)\n";
+    ps_body_destroy(earth);
+    return 0;
+}
+
+// Fires what-if reentries from several concurrent clients
+int QueryService(const std::string &socketPath, int requestCount, int clientCount, bool stopAfter)
+{
+    std::atomic<int> next(0), failures(0);
+    std::vector<std::thread> clients;
+
+    for (int c = 0; c < clientCount; ++c)
+        clients.emplace_back([&]()
+                             {
+            SimulationClient client;
+            if (!client.Connect(socketPath))
+            {
+                ++failures;
+                return;
+            }
+            for (int i = next++; i < requestCount; i = next++)
+            {
+                ps_reentry_scenario scenario;
+                ps_reentry_scenario_defaults(&scenario);
+                scenario.velocity = -300.0 - 7200.0 * i / std::max(1, requestCount);
+                scenario.chute_area = 500.0;
+
+                ps_run_summary summary;
+                if (!client.RunReentry(scenario, summary))
+                    ++failures;
+            } });
+    for (std::thread &client : clients)
+        client.join();
+
+    SimulationClient client;
+    ServiceStats stats;
+    if (!client.Connect(socketPath) || !client.GetStats(stats))
+    {
+        std::cerr << "Could not reach service on " << socketPath << "\n";
+        return 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "📨 " << requestCount << " requests from " << clientCount << " clients, "
+              << failures << " failed\n";
+    std::cout << "  Served: " << stats.requests << " in " << stats.batches << " batches (mean "
+              << stats.meanBatchSize << ")\n";
+    std::cout << "  Latency p50: " << stats.p50LatencyMicros << " µs, p99: " << stats.p99LatencyMicros << " µs\n";
+
+    if (stopAfter)
+        client.RequestShutdown();
+    return failures > 0 ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    // === Service modes ===
+    std::string mode = argc > 1 ? argv[1] : "";
+    std::string socketPath = argc > 2 ? argv[2] : ServiceSettings().socketPath;
+    if (mode == "--serve")
+        return RunService(socketPath);
+    if (mode == "--query")
+        return QueryService(socketPath,
+                            argc > 3 ? std::atoi(argv[3]) : 1000,
+                            argc > 4 ? std::atoi(argv[4]) : 4,
+                            false);
+    if (mode == "--stop")
+        return QueryService(socketPath, 0, 0, true);
+
+    // === Paced plant and stand-in controller ===
+    std::string channelName = argc > 2 ? argv[2] : "/physicssim-control";
+    if (mode == "--plant")
+        return RunPlant(channelName,
+                        argc > 3 ? std::atof(argv[3]) : 100.0,
+                        argc > 4 ? std::atof(argv[4]) : 1.0,
+                        argc > 5 ? std::atof(argv[5]) : 120.0);
+    if (mode == "--controller")
+        return RunController(channelName, argc > 3 ? std::atof(argv[3]) : 20000.0);
+
+    // === Sharded sweeps ===
+    if (mode == "--sweep")
+        return RunSweep(argc > 2 ? argv[2] : (std::filesystem::temp_directory_path() / "physicssim_sweep").string(),
+                        argc > 3 ? std::atoi(argv[3]) : std::max(1, static_cast<int>(std::thread::hardware_concurrency())),
+                        argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 4096);
+    if (mode == "--sweep-worker" && argc > 2)
+        return RunSweepWorker(argv[argc - 1], argc > 4 && std::string(argv[2]) == "--crash-once" ? argv[3] : "");
+
+    // === Offline ephemeris fit ===
+    if (mode == "--fit-ephemeris")
+        return FitEphemerides(argc > 2 ? argv[2] : EphemerisCacheDirectory(),
+                              missionEpoch,
+                              argc > 3 ? std::atof(argv[3]) : ephemerisDays)
+                   ? 0
+                   : 1;
+
     // === Define Atmospheres ===
     Atmosphere earthAtmo(101325.0, 288.15, 0.0065, 0.0289644); // P0, T0, L, M
     Atmosphere marsAtmo(610.0, 210.0, 0.0045, 0.04401);        // Thin CO₂-rich
 
     // === Define Orbital Bodies ===
     OrbitalBody earth(5.972e24, 6.371e6, &earthAtmo);
-    OrbitalBody mars(5.972e24, 6.371e6, &marsAtmo);
+    OrbitalBody mars(6.4171e23, 3.3895e6, &marsAtmo);
+
+    earth.SetOblateness(1.08263e-3);
+    earth.SetRotation(7.2921159e-5);
+    earth.SetEphemerisEpoch(missionEpoch);
+    mars.SetOblateness(1.96045e-3);
+    mars.SetRotation(7.088218e-5);
+
+    ChebyshevEphemeris sun, moon;
+    if (LoadEphemerides(sun, moon))
+    {
+        earth.AddThirdBody(1.32712440018e20, &sun);
+        earth.AddThirdBody(4.9048695e12, &moon);
+    }
+    else
+        std::cout << "⚠️  No Sun/Moon ephemerides; Earth gravity without third bodies.\n";
+
+    // === Simulation events ===
+    // Every event goes to the event log and the statistics; the narrated
+    // demos follow their own vessels on the console
+    FileSink eventLog("sim_events.csv");
+    StatsSink eventStats;
+    EventBus &events = EventBus::Global();
+    events.AddSink(&narration);
+    events.AddSink(&eventLog);
+    events.AddSink(&eventStats);
+    events.Start();
 
     // === Run simulations ===
     SimulateLaunch("Earth", &earth);
@@ -302,5 +2103,41 @@ int main()
 
     TestReentryOutcomes(&earth);
 
+    SimulateDebrisField("Earth", &earth);
+
+    OptimizeLaunchProfile("Earth", &earth, LaunchObjective::MaxApexAltitude);
+    OptimizeLaunchProfile("Earth", &earth, LaunchObjective::MinFuelToApex);
+
+    RunScriptedMissions("Earth", &earth, 100);
+
+    ValidateEnsemblePrecision("Earth", &earth, 1000);
+
+    SimulatePerturbedReentries("Earth", &earth);
+
+    SimulateParallelInTime("Earth", &earth);
+
+    StudyTimestepConvergence("Earth", &earth);
+
+    TestFastMathAccuracy(&earth);
+
+    SimulatePacedPlant("Earth", &earth);
+
+    CompareGravityModels("Earth", &earth, &earthAtmo);
+
+    ArchiveTrajectorySweep("Earth", &earth, 100);
+
+    ScreenWhatIfScenarios("Earth", &earth, 4000);
+
+    MonitorSweep("Earth", &earth, 1500);
+
+    PublishSweepEvents("Earth", &earth, eventStats, 1000);
+
+    ShardSweepAcrossProcesses(512);
+
+    TestDragStability(&earth);
+
+    CompareMultiRateIntegration("Earth", &earth);
+
+    events.Stop();
     return 0;
 }